@@ -74,7 +74,13 @@ namespace Jazz2::Actors
 		uint16_t layer = (uint16_t)details.Pos.Z;
 		_renderer.setLayer(layer);
 
-		bool success = async_await OnActivatedAsync(details);
+#if defined(WITH_COROUTINES)
+		// Activation can be suspended while resources are loading, so the details must outlive the caller
+		ActorActivationDetails storedDetails = details;
+		bool success = co_await OnActivatedAsync(storedDetails);
+#else
+		bool success = OnActivatedAsync(details);
+#endif
 
 		_renderer.setPosition(std::round(_pos.X), std::round(_pos.Y));
 
@@ -220,25 +226,26 @@ namespace Jazz2::Actors
 				// Not doing this will cause hiccups with uphill slopes in particular.
 				// Beach tileset also has some spots where two properly set up adjacent
 				// tiles have a 2px jump, so adapt to that.
-				bool success = false;
+				SmallVector<Vector2f, 64> offsets;
 				float maxYDiff = std::max(3.0f, std::abs(effectiveSpeedX) + 2.5f);
 				for (float yDiff = maxYDiff + effectiveSpeedY; yDiff >= -maxYDiff + effectiveSpeedY; yDiff -= CollisionCheckStep) {
-					if (MoveInstantly(Vector2f(effectiveSpeedX, yDiff), MoveType::Relative, params)) {
-						success = true;
-						break;
-					}
+					offsets.emplace_back(effectiveSpeedX, yDiff);
 				}
+				bool success = (MoveToFirstEmpty(arrayView(offsets.data(), offsets.size()), params) >= 0);
 
 				// Also try to move horizontally as far as possible
 				float xDiff = std::abs(effectiveSpeedX);
 				float maxXDiff = -xDiff;
 				if (!success) {
 					int sign = (effectiveSpeedX > 0.0f ? 1 : -1);
+					offsets.clear();
 					for (; xDiff >= maxXDiff; xDiff -= CollisionCheckStep) {
-						if (MoveInstantly(Vector2f(xDiff * sign, 0.0f), MoveType::Relative, params)) {
-							success = true;
-							break;
-						}
+						offsets.emplace_back(xDiff * sign, 0.0f);
+					}
+					std::int32_t index = MoveToFirstEmpty(arrayView(offsets.data(), offsets.size()), params);
+					if (index >= 0) {
+						xDiff = offsets[index].X * sign;
+						success = true;
 					}
 
 					bool moved = false;
@@ -287,27 +294,33 @@ namespace Jazz2::Actors
 				// First, attempt to move directly based on the current speed values
 				if (!MoveInstantly(Vector2f(effectiveSpeedX, effectiveSpeedY), MoveType::Relative, params)) {
 					// First, attempt to move horizontally as much as possible
+					SmallVector<Vector2f, 64> offsets;
 					float maxDiff = std::abs(effectiveSpeedX);
 					int sign = (effectiveSpeedX > 0.0f ? 1 : -1);
 					float xDiff = maxDiff;
 					for (; xDiff > std::numeric_limits<float>::epsilon(); xDiff -= CollisionCheckStep) {
-						if (MoveInstantly(Vector2f(xDiff * sign, 0.0f), MoveType::Relative, params)) {
-							break;
-						}
+						offsets.emplace_back(xDiff * sign, 0.0f);
+					}
+					std::int32_t index = MoveToFirstEmpty(arrayView(offsets.data(), offsets.size()), params);
+					if (index >= 0) {
+						xDiff = offsets[index].X * sign;
 					}
 
 					// Then, try the same vertically
 					maxDiff = std::abs(effectiveSpeedY);
 					sign = (effectiveSpeedY > 0.0f ? 1 : -1);
 					float yDiff = maxDiff;
+					offsets.clear();
 					for (; yDiff > std::numeric_limits<float>::epsilon(); yDiff -= CollisionCheckStep) {
 						float yDiffSigned = (yDiff * sign);
-						if (MoveInstantly(Vector2f(0.0f, yDiffSigned), MoveType::Relative, params) ||
-							// Add horizontal tolerance
-							MoveInstantly(Vector2f(yDiff * 0.2f, yDiffSigned), MoveType::Relative, params) ||
-							MoveInstantly(Vector2f(yDiff * -0.2f, yDiffSigned), MoveType::Relative, params)) {
-							break;
-						}
+						offsets.emplace_back(0.0f, yDiffSigned);
+						// Add horizontal tolerance
+						offsets.emplace_back(yDiff * 0.2f, yDiffSigned);
+						offsets.emplace_back(yDiff * -0.2f, yDiffSigned);
+					}
+					index = MoveToFirstEmpty(arrayView(offsets.data(), offsets.size()), params);
+					if (index >= 0) {
+						yDiff = offsets[index].Y * sign;
 					}
 
 					// Place us to the ground only if no horizontal movement was
@@ -370,6 +383,50 @@ namespace Jazz2::Actors
 		}
 	}
 
+	std::int32_t ActorBase::MoveToFirstEmpty(ArrayView<const Vector2f> offsets, TileCollisionParams& params)
+	{
+		std::int32_t count = (std::int32_t)offsets.size();
+
+		// MoveInstantly() always succeeds with zero offset, so positions after it don't need to be checked
+		for (std::int32_t i = 0; i < count; i++) {
+			if (offsets[i] == Vector2f::Zero) {
+				count = i + 1;
+				break;
+			}
+		}
+
+		auto* tiles = _levelHandler->TileMap();
+		bool sweepTiles = (tiles != nullptr && GetState(ActorState::CollideWithTileset) &&
+			(!GetState(ActorState::CollideWithTilesetReduced) || AABBInner.B - AABBInner.T < 20.0f));
+
+		if (!sweepTiles) {
+			for (std::int32_t i = 0; i < count; i++) {
+				if (MoveInstantly(offsets[i], MoveType::Relative, params)) {
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		// Positions colliding with tiles are skipped all at once, only the remaining ones are checked fully (including solid objects)
+		std::int32_t i = 0;
+		while (i < count) {
+			if (offsets[i] != Vector2f::Zero) {
+				std::int32_t next = tiles->FindFirstEmpty(AABBInner, offsets.slice(i, count), params);
+				if (next < 0) {
+					return -1;
+				}
+				i += next;
+			}
+			if (MoveInstantly(offsets[i], MoveType::Relative, params)) {
+				return i;
+			}
+			i++;
+		}
+
+		return -1;
+	}
+
 	void ActorBase::UpdateHitbox(int w, int h)
 	{
 		if (_currentAnimation == nullptr) {
@@ -423,6 +480,7 @@ namespace Jazz2::Actors
 
 	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(const StringView identifier, float gain, float pitch)
 	{
+#if defined(WITH_AUDIO)
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
@@ -430,6 +488,9 @@ namespace Jazz2::Actors
 		} else {
 			return nullptr;
 		}
+#else
+		return nullptr;
+#endif
 	}
 
 	bool ActorBase::SetAnimation(AnimState state, bool skipAnimation)
@@ -629,15 +690,11 @@ namespace Jazz2::Actors
 				return true;
 			}
 
-			//PixelData p;
-			uint8_t* p;
 			GraphicResource* res;
 			bool isFacingLeftCurrent;
-			int x1, y1, x2, y2, xs, dx, dy, stride;
+			int x1, y1, x2, y2, xs, ys, frame;
 			if (perPixel1) {
 				res = res1;
-				p = res->Base->Mask.get();
-
 				isFacingLeftCurrent = GetState(ActorState::IsFacingLeft);
 
 				x1 = (int)std::max(inter.L, other->AABBInner.L);
@@ -646,15 +703,10 @@ namespace Jazz2::Actors
 				y2 = (int)std::min(inter.B, other->AABBInner.B);
 
 				xs = (int)aabb1.L;
-
-				int frame1 = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
-				dx = (frame1 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-				dy = (frame1 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabb1.T;
-
+				ys = (int)aabb1.T;
+				frame = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
 			} else {
 				res = res2;
-				p = res->Base->Mask.get();
-
 				isFacingLeftCurrent = other->GetState(ActorState::IsFacingLeft);
 
 				x1 = (int)std::max(inter.L, AABBInner.L);
@@ -663,69 +715,27 @@ namespace Jazz2::Actors
 				y2 = (int)std::min(inter.B, AABBInner.B);
 
 				xs = (int)aabb2.L;
-
-				int frame2 = std::min(other->_renderer.CurrentFrame, res->FrameCount - 1);
-				dx = (frame2 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-				dy = (frame2 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabb2.T;
+				ys = (int)aabb2.T;
+				frame = std::min(other->_renderer.CurrentFrame, res->FrameCount - 1);
 			}
 
-			stride = res->Base->FrameConfiguration.X * res->Base->FrameDimensions.X;
-
 			// Per-pixel collision check
-			for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-				for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-					int i1 = i - xs;
-					if (isFacingLeftCurrent) {
-						i1 = res->Base->FrameDimensions.X - i1 - 1;
-					}
-
-					if (p[((j + dy) * stride) + i1 + dx] > AlphaThreshold) {
-						return true;
-					}
-				}
-			}
+			return res->Base->Mask.IsAnyPixelSet(frame, isFacingLeftCurrent, x1 - xs, y1 - ys, x2 - x1, y2 - y1);
 		} else {
 			int x1 = (int)inter.L;
 			int y1 = (int)inter.T;
 			int x2 = (int)inter.R;
 			int y2 = (int)inter.B;
 
-			int x1s = (int)aabb1.L;
-			int x2s = (int)aabb2.L;
-
 			int frame1 = std::min(_renderer.CurrentFrame, res1->FrameCount - 1);
-			int dx1 = (frame1 % res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.X;
-			int dy1 = (frame1 / res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.Y - (int)aabb1.T;
-			int stride1 = res1->Base->FrameConfiguration.X * res1->Base->FrameDimensions.X;
-
 			int frame2 = std::min(other->_renderer.CurrentFrame, res2->FrameCount - 1);
-			int dx2 = (frame2 % res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.X;
-			int dy2 = (frame2 / res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.Y - (int)aabb2.T;
-			int stride2 = res2->Base->FrameConfiguration.X * res2->Base->FrameDimensions.X;
-
-			// Per-pixel collision check
-			auto p1 = res1->Base->Mask.get();
-			auto p2 = res2->Base->Mask.get();
-
-			for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-				for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-					int i1 = i - x1s;
-					if (GetState(ActorState::IsFacingLeft)) {
-						i1 = res1->Base->FrameDimensions.X - i1 - 1;
-					}
-					int i2 = i - x2s;
-					if (other->GetState(ActorState::IsFacingLeft)) {
-						i2 = res2->Base->FrameDimensions.X - i2 - 1;
-					}
 
-					if (p1[((j + dy1) * stride1) + i1 + dx1] > AlphaThreshold && p2[((j + dy2) * stride2) + i2 + dx2] > AlphaThreshold) {
-						return true;
-					}
-				}
-			}
+			// Per-pixel collision check, mirrored frames are already precomputed in the mask
+			return Collisions::CollisionMask::Overlaps(
+				res1->Base->Mask, frame1, GetState(ActorState::IsFacingLeft), x1 - (int)aabb1.L, y1 - (int)aabb1.T,
+				res2->Base->Mask, frame2, other->GetState(ActorState::IsFacingLeft), x1 - (int)aabb2.L, y1 - (int)aabb2.T,
+				x2 - x1, y2 - y1);
 		}
-
-		return false;
 	}
 
 	bool ActorBase::IsCollidingWith(const AABBf& aabb)
@@ -768,29 +778,12 @@ namespace Jazz2::Actors
 		int y2 = (int)std::min(inter.B, aabb.B);
 
 		int xs = (int)aabbSelf.L;
+		int ys = (int)aabbSelf.T;
 
-		int frame1 = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
-		int dx = (frame1 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-		int dy = (frame1 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabbSelf.T;
-		int stride = res->Base->FrameConfiguration.X * res->Base->FrameDimensions.X;
+		int frame = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
 
 		// Per-pixel collision check
-		auto p = res->Base->Mask.get();
-
-		for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-			for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-				int i1 = i - xs;
-				if (GetState(ActorState::IsFacingLeft)) {
-					i1 = res->Base->FrameDimensions.X - i1 - 1;
-				}
-
-				if (p[((j + dy) * stride) + i1 + dx] > AlphaThreshold) {
-					return true;
-				}
-			}
-		}
-
-		return false;
+		return res->Base->Mask.IsAnyPixelSet(frame, GetState(ActorState::IsFacingLeft), x1 - xs, y1 - ys, x2 - x1, y2 - y1);
 	}
 
 	bool ActorBase::IsCollidingWithAngled(ActorBase* other)
@@ -861,17 +854,10 @@ namespace Jazz2::Actors
 		Vector3f yPosIn2 = Vector3f::Zero * transformAToB;
 
 		int frame1 = std::min(_renderer.CurrentFrame, res1->FrameCount - 1);
-		int dx1 = (frame1 % res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.X;
-		int dy1 = (frame1 / res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.Y;
-		int stride1 = res1->Base->FrameConfiguration.X * res1->Base->FrameDimensions.X;
-
 		int frame2 = std::min(other->_renderer.CurrentFrame, res2->FrameCount - 1);
-		int dx2 = (frame2 % res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.X;
-		int dy2 = (frame2 / res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.Y;
-		int stride2 = res2->Base->FrameConfiguration.X * res2->Base->FrameDimensions.X;
 
-		auto p1 = res1->Base->Mask.get();
-		auto p2 = res2->Base->Mask.get();
+		auto& mask1 = res1->Base->Mask;
+		auto& mask2 = res2->Base->Mask;
 
 		for (int y1 = 0; y1 < height1; y1 += PerPixelCollisionStep) {
 			Vector3f posIn2 = yPosIn2;
@@ -881,7 +867,7 @@ namespace Jazz2::Actors
 				int y2 = (int)std::round(posIn2.Y);
 
 				if (x2 >= 0 && x2 < width2 && y2 >= 0 && y2 < height2) {
-					if (p1[((y1 + dy1) * stride1) + x1 + dx1] > AlphaThreshold && p2[((y2 + dy2) * stride2) + x2 + dx2] > AlphaThreshold) {
+					if (mask1.IsPixelSet(frame1, x1, y1) && mask2.IsPixelSet(frame2, x2, y2)) {
 						return true;
 					}
 				}
@@ -936,11 +922,8 @@ namespace Jazz2::Actors
 		Vector3f yPosInAABB = Vector3f::Zero * transform;
 
 		int frame = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
-		int dx = (frame % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-		int dy = (frame / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y;
-		int stride = res->Base->FrameConfiguration.X * res->Base->FrameDimensions.X;
 
-		auto p = res->Base->Mask.get();
+		auto& mask = res->Base->Mask;
 
 		for (int y1 = 0; y1 < height; y1 += PerPixelCollisionStep) {
 			Vector3f posInAABB = yPosInAABB;
@@ -949,7 +932,7 @@ namespace Jazz2::Actors
 				int x2 = (int)std::round(posInAABB.X);
 				int y2 = (int)std::round(posInAABB.Y);
 
-				if (p[((y1 + dy) * stride) + x1 + dx] > AlphaThreshold &&
+				if (mask.IsPixelSet(frame, x1, y1) &&
 					x2 >= aabb.L && x2 < aabb.R && y2 >= aabb.T && y2 < aabb.B) {
 					return true;
 				}
@@ -1060,7 +1043,24 @@ namespace Jazz2::Actors
 		_metadata = ContentResolver::Get().RequestMetadata(path);
 	}
 	
-#if !defined(WITH_COROUTINES)
+#if defined(WITH_COROUTINES)
+	bool ActorBase::RequestMetadataAwaitable::await_ready()
+	{
+		// Only asynchronous actors can wait for metadata loaded by worker threads, the rest loads them immediately
+		return ((actor->_state & ActorState::Async) != ActorState::Async || ContentResolver::Get().PreloadMetadataAsync(path));
+	}
+
+	bool ActorBase::RequestMetadataAwaitable::await_suspend(std::coroutine_handle<> handle)
+	{
+		// The actor owns the suspended coroutine, so it must not be resumed if the actor was destroyed in the meantime
+		return ContentResolver::Get().ResumeWhenMetadataLoaded(path, actor->shared_from_this(), handle);
+	}
+
+	void ActorBase::RequestMetadataAwaitable::await_resume()
+	{
+		actor->_metadata = ContentResolver::Get().RequestMetadata(path);
+	}
+#else
 	void ActorBase::RequestMetadataAsync(const StringView path)
 	{
 		_metadata = ContentResolver::Get().RequestMetadata(path);
@@ -31,6 +31,11 @@ namespace Jazz2
 	class LevelHandler;
 }
 
+namespace Jazz2::Events
+{
+	class EventSpawner;
+}
+
 #if defined(WITH_MULTIPLAYER)
 namespace Jazz2::Multiplayer
 {
@@ -104,6 +109,9 @@ namespace Jazz2::Actors
 		CollideWithSolidObjectsBelow = 0x4000000,
 		/** @brief Ignore solid collisions agains similar objects that have this flag */
 		ExcludeSimilar = 0x8000000,
+
+		/** @brief Lights emitted by @ref ActorBase::OnEmitLights() never change, so they can be cached (cannot be changed during object lifetime) */
+		HasStaticLights = 0x10000000,
 	};
 
 	DEFINE_ENUM_OPERATORS(ActorState);
@@ -142,6 +150,7 @@ namespace Jazz2::Actors
 		DEATH_RUNTIME_OBJECT();
 
 		friend class Jazz2::LevelHandler;
+		friend class Jazz2::Events::EventSpawner;
 #if defined(WITH_MULTIPLAYER)
 		friend class Jazz2::Multiplayer::MultiLevelHandler;
 #endif
@@ -236,7 +245,6 @@ namespace Jazz2::Actors
 			static int NormalizeFrame(int frame, int min, int max);
 		};
 
-		static constexpr uint8_t AlphaThreshold = 40;
 		static constexpr float CollisionCheckStep = 0.5f;
 		static constexpr int PerPixelCollisionStep = 3;
 		static constexpr int AnimationCandidatesCount = 5;
@@ -281,6 +289,7 @@ namespace Jazz2::Actors
 		virtual void OnTriggeredEvent(EventType eventType, uint8_t* eventParams);
 
 		void TryStandardMovement(float timeMult, Tiles::TileCollisionParams& params);
+		std::int32_t MoveToFirstEmpty(ArrayView<const Vector2f> offsets, Tiles::TileCollisionParams& params);
 		void UpdateHitbox(int w, int h);
 		void UpdateFrozenState(float timeMult);
 		void HandleFrozenStateChange(ActorBase* shot);
@@ -302,24 +311,18 @@ namespace Jazz2::Actors
 		void RequestMetadata(const StringView path);
 
 #if defined(WITH_COROUTINES)
-		auto RequestMetadataAsync(const StringView path)
+		struct RequestMetadataAwaitable {
+			ActorBase* actor;
+			StringView path;
+
+			bool await_ready();
+			bool await_suspend(std::coroutine_handle<> handle);
+			void await_resume();
+		};
+
+		RequestMetadataAwaitable RequestMetadataAsync(const StringView path)
 		{
-			struct awaitable {
-				ActorBase* actor;
-				const StringView& path;
-
-				bool await_ready() {
-					return false;
-				}
-				void await_suspend(std::coroutine_handle<> handle) {
-					// TODO: implement async
-					auto metadata = ContentResolver::Get().RequestMetadata(path);
-					actor->_metadata = metadata;
-					handle();
-				}
-				void await_resume() { }
-			};
-			return awaitable{this, path};
+			return RequestMetadataAwaitable{this, path};
 		}
 #else
 		void RequestMetadataAsync(const StringView path);
@@ -345,6 +348,9 @@ namespace Jazz2::Actors
 
 		ActorState _state;
 		std::function<void()> _currentTransitionCallback;
+#if defined(WITH_COROUTINES)
+		std::optional<Task<bool>> _activationTask;
+#endif
 
 		bool IsCollidingWithAngled(ActorBase* other);
 		bool IsCollidingWithAngled(const AABBf& aabb);
@@ -237,9 +237,11 @@ namespace Jazz2::Actors::Bosses
 	{
 		MoveInstantly(Vector2f(_speed.X * timeMult, _speed.Y * timeMult), MoveType::Relative | MoveType::Force);
 
+#if defined(WITH_AUDIO)
 		if (_sound != nullptr) {
 			_sound->setPosition(Vector3f(_pos.X, _pos.Y, 0.8f));
 		}
+#endif
 
 		if (_returning) {
 			Vector2f diff = (_targetSpeed - _speed);
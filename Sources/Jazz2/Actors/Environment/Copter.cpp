@@ -62,8 +62,10 @@ namespace Jazz2::Actors::Environment
 				_noise->stop();
 				_noise = nullptr;
 			} else {
+#if defined(WITH_AUDIO)
 				_noise->setGain(newGain);
 				_noise->setPosition(Vector3f(_pos.X, _pos.Y, 0.8f));
+#endif
 			}
 		}
 	}
@@ -14,7 +14,7 @@ namespace Jazz2::Actors::Lighting
 		_radiusNear = (float)*(uint16_t*)&details.Params[2];
 		_radiusFar = (float)*(uint16_t*)&details.Params[4];
 
-		SetState(ActorState::ForceDisableCollisions, true);
+		SetState(ActorState::ForceDisableCollisions | ActorState::HasStaticLights, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::ApplyGravitation, false);
 
 		async_return true;
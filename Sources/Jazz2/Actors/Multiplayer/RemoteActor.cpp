@@ -2,12 +2,13 @@
 
 #if defined(WITH_MULTIPLAYER)
 
+#include "../../PreferencesCache.h"
 #include "../../../nCine/Base/Clock.h"
 
 namespace Jazz2::Actors::Multiplayer
 {
 	RemoteActor::RemoteActor()
-		: _stateBufferPos(0), _lastAnim(AnimState::Idle)
+		: _stateBufferPos(0), _lastAnim(AnimState::Idle), _isHiddenUntilSynced(false), _hiddenCollisionState(ActorState::None)
 	{
 	}
 
@@ -30,13 +31,14 @@ namespace Jazz2::Actors::Multiplayer
 	{
 		Clock& c = nCine::clock();
 		std::int64_t now = c.now() * 1000 / c.frequency();
-		std::int64_t renderTime = now - ServerDelay;
+		std::int64_t renderTime = now - PreferencesCache::NetworkInterpolationDelay;
 
 		std::int32_t nextIdx = _stateBufferPos - 1;
 		if (nextIdx < 0) {
 			nextIdx += countof(_stateBuffer);
 		}
 
+		Vector2f pos;
 		if (renderTime <= _stateBuffer[nextIdx].Time) {
 			std::int32_t prevIdx;
 			while (true) {
@@ -52,7 +54,6 @@ namespace Jazz2::Actors::Multiplayer
 				nextIdx = prevIdx;
 			}
 
-			Vector2f pos;
 			std::int64_t timeRange = (_stateBuffer[nextIdx].Time - _stateBuffer[prevIdx].Time);
 			if (timeRange > 0) {
 				float lerp = (float)(renderTime - _stateBuffer[prevIdx].Time) / timeRange;
@@ -60,10 +61,24 @@ namespace Jazz2::Actors::Multiplayer
 			} else {
 				pos = _stateBuffer[nextIdx].Pos;
 			}
+		} else {
+			// No newer state arrived in time, so continue in the last known direction for a limited time
+			std::int32_t prevIdx = nextIdx - 1;
+			if (prevIdx < 0) {
+				prevIdx += countof(_stateBuffer);
+			}
 
-			MoveInstantly(pos, MoveType::Absolute | MoveType::Force);
+			std::int64_t timeRange = (_stateBuffer[nextIdx].Time - _stateBuffer[prevIdx].Time);
+			if (timeRange > 0) {
+				float lerp = (float)std::min(renderTime - _stateBuffer[nextIdx].Time, MaxExtrapolationTime) / timeRange;
+				pos = _stateBuffer[nextIdx].Pos + (_stateBuffer[nextIdx].Pos - _stateBuffer[prevIdx].Pos) * lerp;
+			} else {
+				pos = _stateBuffer[nextIdx].Pos;
+			}
 		}
 
+		MoveInstantly(pos, MoveType::Absolute | MoveType::Force);
+
 		ActorBase::OnUpdate(timeMult);
 	}
 
@@ -76,12 +91,19 @@ namespace Jazz2::Actors::Multiplayer
 		RequestMetadata(path);
 		SetAnimation(anim);
 		SetState((GetState() & ~RemotedFlags) | (state & RemotedFlags));
+
+		if (_isHiddenUntilSynced) {
+			_hiddenCollisionState = (state & HiddenCollisionFlags);
+			SetState(HiddenCollisionFlags, false);
+		}
 	}
 
-	void RemoteActor::SyncWithServer(const Vector2f& pos, AnimState anim, float rotation, bool isVisible, bool isFacingLeft, bool animPaused, Actors::ActorRendererType rendererType)
+	void RemoteActor::SyncWithServer(std::int64_t time, const Vector2f& pos, AnimState anim, float rotation, bool isVisible, bool isFacingLeft, bool animPaused, Actors::ActorRendererType rendererType)
 	{
-		Clock& c = nCine::clock();
-		std::int64_t now = c.now() * 1000 / c.frequency();
+		if (_isHiddenUntilSynced) {
+			_isHiddenUntilSynced = false;
+			SetState(_hiddenCollisionState, true);
+		}
 
 		bool wasVisible = _renderer.isDrawEnabled();
 		_renderer.setDrawEnabled(isVisible);
@@ -98,7 +120,7 @@ namespace Jazz2::Actors::Multiplayer
 
 		if (wasVisible) {
 			// Actor is still visible, enable interpolation
-			_stateBuffer[_stateBufferPos].Time = now;
+			_stateBuffer[_stateBufferPos].Time = time;
 			_stateBuffer[_stateBufferPos].Pos = pos;
 		} else {
 			// Actor was hidden before, reset state buffer to disable interpolation
@@ -107,7 +129,7 @@ namespace Jazz2::Actors::Multiplayer
 				stateBufferPrevPos += countof(_stateBuffer);
 			}
 
-			std::int64_t renderTime = now - ServerDelay;
+			std::int64_t renderTime = time - PreferencesCache::NetworkInterpolationDelay;
 
 			_stateBuffer[stateBufferPrevPos].Time = renderTime;
 			_stateBuffer[stateBufferPrevPos].Pos = pos;
@@ -120,6 +142,19 @@ namespace Jazz2::Actors::Multiplayer
 			_stateBufferPos = 0;
 		}
 	}
+
+	void RemoteActor::HideUntilSynced()
+	{
+		if (_isHiddenUntilSynced) {
+			return;
+		}
+
+		// Renderer is disabled, so the next call to SyncWithServer() also resets the state buffer
+		_isHiddenUntilSynced = true;
+		_hiddenCollisionState = (GetState() & HiddenCollisionFlags);
+		SetState(HiddenCollisionFlags, false);
+		_renderer.setDrawEnabled(false);
+	}
 }
 
 #endif
\ No newline at end of file
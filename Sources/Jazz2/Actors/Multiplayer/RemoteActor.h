@@ -14,7 +14,9 @@ namespace Jazz2::Actors::Multiplayer
 		RemoteActor();
 
 		void AssignMetadata(const StringView& path, AnimState anim, ActorState state);
-		void SyncWithServer(const Vector2f& pos, AnimState anim, float rotation, bool isVisible, bool isFacingLeft, bool animPaused, Actors::ActorRendererType rendererType);
+		void SyncWithServer(std::int64_t time, const Vector2f& pos, AnimState anim, float rotation, bool isVisible, bool isFacingLeft, bool animPaused, Actors::ActorRendererType rendererType);
+		/** @brief Hides the actor and disables its collisions until the next state is received from the server */
+		void HideUntilSynced();
 
 	protected:
 		struct StateFrame {
@@ -22,11 +24,14 @@ namespace Jazz2::Actors::Multiplayer
 			Vector2f Pos;
 		};
 
-		static constexpr std::int64_t ServerDelay = 64;
+		static constexpr std::int64_t MaxExtrapolationTime = 100;
+		static constexpr ActorState HiddenCollisionFlags = ActorState::CollideWithOtherActors | ActorState::CollideWithSolidObjects | ActorState::IsSolidObject;
 
-		StateFrame _stateBuffer[8];
+		StateFrame _stateBuffer[16];
 		std::int32_t _stateBufferPos;
 		AnimState _lastAnim;
+		bool _isHiddenUntilSynced;
+		ActorState _hiddenCollisionState;
 
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
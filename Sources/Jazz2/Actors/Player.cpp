@@ -537,7 +537,9 @@ namespace Jazz2::Actors
 
 		if (_copterSound != nullptr) {
 			if ((_currentAnimation->State & AnimState::Copter) == AnimState::Copter) {
+#if defined(WITH_AUDIO)
 				_copterSound->setPosition(Vector3f(_pos.X, _pos.Y, 0.8f));
+#endif
 			} else {
 				_copterSound->stop();
 				_copterSound = nullptr;
@@ -1002,7 +1004,9 @@ namespace Jazz2::Actors
 
 		if (_weaponSound != nullptr) {
 			if (weaponInUse) {
+#if defined(WITH_AUDIO)
 				_weaponSound->setPosition(Vector3f(_pos.X, _pos.Y, 0.8f));
+#endif
 			} else {
 				_weaponSound->stop();
 				_weaponSound = nullptr;
@@ -1087,10 +1091,9 @@ namespace Jazz2::Actors
 					gunspotPosY = std::floor(gunspotPosY);
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(res->Base->FrameDimensions.X, res->Base->FrameDimensions.Y * scaleY);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(1.0f, 1.0f, 1.0f, 1.8f);
+				command->setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->setInstanceSpriteSize(res->Base->FrameDimensions.X, res->Base->FrameDimensions.Y * scaleY);
+				command->setInstanceColor(1.0f, 1.0f, 1.0f, 1.8f);
 
 				Matrix4x4f worldMatrix = Matrix4x4f::Translation(gunspotPosX, gunspotPosY, 0.0f);
 				if (lookUp) {
@@ -1140,10 +1143,9 @@ namespace Jazz2::Actors
 							}
 						}
 
-						auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-						instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(frames * -0.008f, frames * 0.006f - sinf(frames * 0.006f), -sinf(frames * 0.015f), frames * 0.006f);
-						instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(shieldSize, shieldSize);
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
+						command->setInstanceTexRect(frames * -0.008f, frames * 0.006f - sinf(frames * 0.006f), -sinf(frames * 0.015f), frames * 0.006f);
+						command->setInstanceSpriteSize(shieldSize, shieldSize);
+						command->setInstanceColor(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
 
 						command->setTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosX, 0.0f));
 						command->setLayer(_renderer.layer() - 4);
@@ -1169,10 +1171,9 @@ namespace Jazz2::Actors
 							}
 						}
 
-						auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-						instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(frames * 0.006f, sinf(frames * 0.006f), sinf(frames * 0.015f), frames * -0.006f);
-						instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(shieldSize, shieldSize);
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(2.0f, 2.0f, 1.0f, 1.0f * shieldAlpha);
+						command->setInstanceTexRect(frames * 0.006f, sinf(frames * 0.006f), sinf(frames * 0.015f), frames * -0.006f);
+						command->setInstanceSpriteSize(shieldSize, shieldSize);
+						command->setInstanceColor(2.0f, 2.0f, 1.0f, 1.0f * shieldAlpha);
 
 						command->setTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
 						command->setLayer(_renderer.layer() + 4);
@@ -1224,10 +1225,9 @@ namespace Jazz2::Actors
 						shieldPosY = std::floor(shieldPosY);
 					}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(res->Base->FrameDimensions.X * shieldScale, res->Base->FrameDimensions.Y * shieldScale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(1.0f, 1.0f, 1.0f, shieldAlpha);
+					command->setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->setInstanceSpriteSize(res->Base->FrameDimensions.X * shieldScale, res->Base->FrameDimensions.Y * shieldScale);
+					command->setInstanceColor(1.0f, 1.0f, 1.0f, shieldAlpha);
 
 					command->setTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
 					command->setLayer(_renderer.layer() + 4);
@@ -1271,10 +1271,9 @@ namespace Jazz2::Actors
 							}
 						}
 
-						auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-						instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(frames * -0.008f, frames * 0.006f - sinf(frames * 0.006f), -sinf(frames * 0.015f), frames * 0.006f);
-						instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(shieldSize, shieldSize);
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
+						command->setInstanceTexRect(frames * -0.008f, frames * 0.006f - sinf(frames * 0.006f), -sinf(frames * 0.015f), frames * 0.006f);
+						command->setInstanceSpriteSize(shieldSize, shieldSize);
+						command->setInstanceColor(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
 
 						command->setTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
 						command->setLayer(_renderer.layer() - 4);
@@ -1300,10 +1299,9 @@ namespace Jazz2::Actors
 							}
 						}
 
-						auto* instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-						instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(frames * 0.006f, sinf(frames * 0.006f), sinf(frames * 0.015f), frames * -0.006f);
-						instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(shieldSize, shieldSize);
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(2.0f, 2.0f, 1.0f, shieldAlpha);
+						command->setInstanceTexRect(frames * 0.006f, sinf(frames * 0.006f), sinf(frames * 0.015f), frames * -0.006f);
+						command->setInstanceSpriteSize(shieldSize, shieldSize);
+						command->setInstanceColor(2.0f, 2.0f, 1.0f, shieldAlpha);
 
 						command->setTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
 						command->setLayer(_renderer.layer() + 4);
@@ -2407,6 +2405,7 @@ namespace Jazz2::Actors
 
 	std::shared_ptr<AudioBufferPlayer> Player::PlayPlayerSfx(const StringView identifier, float gain, float pitch)
 	{
+#if defined(WITH_AUDIO)
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
@@ -2414,6 +2413,9 @@ namespace Jazz2::Actors
 		} else {
 			return nullptr;
 		}
+#else
+		return nullptr;
+#endif
 	}
 
 	bool Player::SetPlayerTransition(AnimState state, bool cancellable, bool removeControl, SpecialMoveType specialMove, const std::function<void()>& callback)
@@ -2749,8 +2751,10 @@ namespace Jazz2::Actors
 			_weaponSound = PlaySfx("WeaponThunderbolt"_s, 1.0f);
 			if (_weaponSound != nullptr) {
 				_weaponSound->setLooping(true);
+#if defined(WITH_AUDIO)
 				_weaponSound->setPitch(Random().FastFloat(1.05f, 1.2f));
 				_weaponSound->setLowPass(0.9f);
+#endif
 			}
 		}
 
@@ -88,9 +88,11 @@ namespace Jazz2::Actors::Weapons
 			_renderer.setDrawEnabled(true);
 		}
 
+#if defined(WITH_AUDIO)
 		if (_noise != nullptr) {
 			_noise->setPosition(Vector3f(_pos.X, _pos.Y, 0.8f));
 		}
+#endif
 	}
 
 	void ShieldLightningShot::OnUpdateHitbox()
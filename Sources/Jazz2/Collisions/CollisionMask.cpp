@@ -0,0 +1,277 @@
+#include "CollisionMask.h"
+
+#include <Cpu.h>
+
+#if defined(DEATH_ENABLE_SSE2)
+#	include <IntrinsicsSse2.h>
+#endif
+#if defined(DEATH_ENABLE_AVX2)
+#	include <IntrinsicsAvx.h>
+#endif
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+#	include <arm_neon.h>
+#endif
+
+namespace Jazz2::Collisions
+{
+	namespace Implementation
+	{
+		namespace
+		{
+			DEATH_ALWAYS_INLINE std::uint64_t extractBits(const std::uint64_t lo, const std::uint64_t hi, const std::int32_t shift) {
+				return (shift == 0 ? lo : (lo >> shift) | (hi << (64 - shift)));
+			}
+
+			DEATH_ALWAYS_INLINE bool overlapStripsScalar(const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t i, std::size_t count) {
+				for (; i < count; i++) {
+					if ((extractBits(lo1[i], hi1[i], shift1) & extractBits(lo2[i], hi2[i], shift2) & mask) != 0) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+#if defined(DEATH_ENABLE_SSE2)
+			// Two rows at a time, shifting by 64 bits results in zero, so the unshifted case doesn't need to be handled separately
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(overlapStrips)>::type overlapStripsImplementation(Cpu::Sse2T) {
+				return [](const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count) DEATH_ENABLE_SSE2 -> bool {
+					const __m128i shiftLo1 = _mm_cvtsi32_si128(shift1);
+					const __m128i shiftHi1 = _mm_cvtsi32_si128(64 - shift1);
+					const __m128i shiftLo2 = _mm_cvtsi32_si128(shift2);
+					const __m128i shiftHi2 = _mm_cvtsi32_si128(64 - shift2);
+					const __m128i vmask = _mm_set1_epi64x(std::int64_t(mask));
+					const __m128i zero = _mm_setzero_si128();
+
+					std::size_t i = 0;
+					for (; i + 2 <= count; i += 2) {
+						const __m128i a = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo1 + i)), shiftLo1),
+							_mm_sll_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hi1 + i)), shiftHi1));
+						const __m128i b = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo2 + i)), shiftLo2),
+							_mm_sll_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hi2 + i)), shiftHi2));
+						const __m128i r = _mm_and_si128(_mm_and_si128(a, b), vmask);
+						if (_mm_movemask_epi8(_mm_cmpeq_epi32(r, zero)) != 0xffff) {
+							return true;
+						}
+					}
+
+					return overlapStripsScalar(lo1, hi1, shift1, lo2, hi2, shift2, mask, i, count);
+				};
+			}
+#endif
+
+#if defined(DEATH_ENABLE_AVX2)
+			// Trivial extension of the SSE2 code to AVX2, four rows at a time
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX2 typename std::decay<decltype(overlapStrips)>::type overlapStripsImplementation(Cpu::Avx2T) {
+				return [](const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count) DEATH_ENABLE_AVX2 -> bool {
+					// If we have less than 4 rows, fall back to the SSE2 variant
+					if (count < 4) {
+						return overlapStripsImplementation(Cpu::Sse2)(lo1, hi1, shift1, lo2, hi2, shift2, mask, count);
+					}
+
+					const __m128i shiftLo1 = _mm_cvtsi32_si128(shift1);
+					const __m128i shiftHi1 = _mm_cvtsi32_si128(64 - shift1);
+					const __m128i shiftLo2 = _mm_cvtsi32_si128(shift2);
+					const __m128i shiftHi2 = _mm_cvtsi32_si128(64 - shift2);
+					const __m256i vmask = _mm256_set1_epi64x(std::int64_t(mask));
+
+					std::size_t i = 0;
+					for (; i + 4 <= count; i += 4) {
+						const __m256i a = _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo1 + i)), shiftLo1),
+							_mm256_sll_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hi1 + i)), shiftHi1));
+						const __m256i b = _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo2 + i)), shiftLo2),
+							_mm256_sll_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hi2 + i)), shiftHi2));
+						const __m256i r = _mm256_and_si256(a, b);
+						if (!_mm256_testz_si256(r, vmask)) {
+							return true;
+						}
+					}
+
+					return overlapStripsScalar(lo1, hi1, shift1, lo2, hi2, shift2, mask, i, count);
+				};
+			}
+#endif
+
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+			// NEON has only left shift by a register, negative values shift right
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(overlapStrips)>::type overlapStripsImplementation(Cpu::NeonT) {
+				return [](const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count) DEATH_ENABLE_NEON -> bool {
+					const int64x2_t shiftLo1 = vdupq_n_s64(-shift1);
+					const int64x2_t shiftHi1 = vdupq_n_s64(64 - shift1);
+					const int64x2_t shiftLo2 = vdupq_n_s64(-shift2);
+					const int64x2_t shiftHi2 = vdupq_n_s64(64 - shift2);
+					const uint64x2_t vmask = vdupq_n_u64(mask);
+
+					std::size_t i = 0;
+					for (; i + 2 <= count; i += 2) {
+						const uint64x2_t a = vorrq_u64(vshlq_u64(vld1q_u64(lo1 + i), shiftLo1), vshlq_u64(vld1q_u64(hi1 + i), shiftHi1));
+						const uint64x2_t b = vorrq_u64(vshlq_u64(vld1q_u64(lo2 + i), shiftLo2), vshlq_u64(vld1q_u64(hi2 + i), shiftHi2));
+						const uint64x2_t r = vandq_u64(vandq_u64(a, b), vmask);
+						if ((vgetq_lane_u64(r, 0) | vgetq_lane_u64(r, 1)) != 0) {
+							return true;
+						}
+					}
+
+					return overlapStripsScalar(lo1, hi1, shift1, lo2, hi2, shift2, mask, i, count);
+				};
+			}
+#endif
+
+			DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(overlapStrips)>::type overlapStripsImplementation(Cpu::ScalarT) {
+				return [](const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count) -> bool {
+					return overlapStripsScalar(lo1, hi1, shift1, lo2, hi2, shift2, mask, 0, count);
+				};
+			}
+		}
+
+		DEATH_CPU_DISPATCHER_BASE(overlapStripsImplementation)
+		DEATH_CPU_DISPATCHED(overlapStripsImplementation, bool DEATH_CPU_DISPATCHED_DECLARATION(overlapStrips)(const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count))({
+			return overlapStripsImplementation(Cpu::DefaultBase)(lo1, hi1, shift1, lo2, hi2, shift2, mask, count);
+		})
+	}
+
+	CollisionMask::CollisionMask()
+		: _width(0), _height(0), _frameCount(0), _stripCount(0)
+	{
+	}
+
+	void CollisionMask::Initialize(const std::uint32_t* pixels, std::int32_t sheetWidth, std::int32_t sheetHeight, Vector2i frameDimensions, Vector2i frameConfiguration, std::uint8_t alphaThreshold)
+	{
+		_data = nullptr;
+		_width = frameDimensions.X;
+		_height = frameDimensions.Y;
+		_frameCount = frameConfiguration.X * frameConfiguration.Y;
+		if (_width <= 0 || _height <= 0 || _frameCount <= 0) {
+			_frameCount = 0;
+			return;
+		}
+
+		// One extra empty strip per frame, so unaligned extraction can always read the next strip
+		_stripCount = (_width + 63) / 64 + 1;
+
+		std::size_t frameSize = std::size_t(_stripCount) * _height;
+		_data = std::make_unique<std::uint64_t[]>(frameSize * _frameCount * 2);
+
+		for (std::int32_t frame = 0; frame < _frameCount; frame++) {
+			std::int32_t fx = (frame % frameConfiguration.X) * _width;
+			std::int32_t fy = (frame / frameConfiguration.X) * _height;
+			std::uint64_t* normal = &_data[frame * frameSize];
+			std::uint64_t* mirrored = &_data[(_frameCount + frame) * frameSize];
+
+			for (std::int32_t y = 0; y < _height && fy + y < sheetHeight; y++) {
+				const std::uint32_t* row = &pixels[(fy + y) * sheetWidth];
+				for (std::int32_t x = 0; x < _width && fx + x < sheetWidth; x++) {
+					if (((row[fx + x] >> 24) & 0xff) > alphaThreshold) {
+						std::int32_t mx = _width - x - 1;
+						normal[(x >> 6) * _height + y] |= (1ull << (x & 63));
+						mirrored[(mx >> 6) * _height + y] |= (1ull << (mx & 63));
+					}
+				}
+			}
+		}
+	}
+
+	bool CollisionMask::IsPixelSet(std::int32_t frame, std::int32_t x, std::int32_t y, bool mirrored) const
+	{
+		const std::uint64_t* data = GetFrame(frame, mirrored);
+		if (data == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) {
+			return false;
+		}
+
+		return ((data[(x >> 6) * _height + y] >> (x & 63)) & 1) != 0;
+	}
+
+	bool CollisionMask::IsAnyPixelSet(std::int32_t frame, bool mirrored, std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height) const
+	{
+		const std::uint64_t* data = GetFrame(frame, mirrored);
+		if (data == nullptr) {
+			return false;
+		}
+
+		if (x < 0) {
+			width += x;
+			x = 0;
+		}
+		if (y < 0) {
+			height += y;
+			y = 0;
+		}
+		width = std::min(width, _width - x);
+		height = std::min(height, _height - y);
+		if (width <= 0 || height <= 0) {
+			return false;
+		}
+
+		for (std::int32_t offset = 0; offset < width; offset += 64) {
+			std::int32_t bits = std::min(width - offset, 64);
+			std::uint64_t mask = (bits == 64 ? ~0ull : (1ull << bits) - 1);
+			std::int32_t bx = x + offset;
+			const std::uint64_t* lo = data + (bx >> 6) * _height + y;
+			const std::uint64_t* hi = lo + _height;
+			if (Implementation::overlapStrips(lo, hi, bx & 63, lo, hi, bx & 63, mask, height)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool CollisionMask::Overlaps(const CollisionMask& mask1, std::int32_t frame1, bool mirrored1, std::int32_t x1, std::int32_t y1,
+		const CollisionMask& mask2, std::int32_t frame2, bool mirrored2, std::int32_t x2, std::int32_t y2, std::int32_t width, std::int32_t height)
+	{
+		const std::uint64_t* data1 = mask1.GetFrame(frame1, mirrored1);
+		const std::uint64_t* data2 = mask2.GetFrame(frame2, mirrored2);
+		if (data1 == nullptr || data2 == nullptr) {
+			return false;
+		}
+
+		// Clip the rectangle to both frames
+		if (x1 < 0) {
+			width += x1;
+			x2 -= x1;
+			x1 = 0;
+		}
+		if (x2 < 0) {
+			width += x2;
+			x1 -= x2;
+			x2 = 0;
+		}
+		if (y1 < 0) {
+			height += y1;
+			y2 -= y1;
+			y1 = 0;
+		}
+		if (y2 < 0) {
+			height += y2;
+			y1 -= y2;
+			y2 = 0;
+		}
+		width = std::min(width, std::min(mask1._width - x1, mask2._width - x2));
+		height = std::min(height, std::min(mask1._height - y1, mask2._height - y2));
+		if (width <= 0 || height <= 0) {
+			return false;
+		}
+
+		for (std::int32_t offset = 0; offset < width; offset += 64) {
+			std::int32_t bits = std::min(width - offset, 64);
+			std::uint64_t mask = (bits == 64 ? ~0ull : (1ull << bits) - 1);
+			std::int32_t bx1 = x1 + offset;
+			std::int32_t bx2 = x2 + offset;
+			const std::uint64_t* lo1 = data1 + (bx1 >> 6) * mask1._height + y1;
+			const std::uint64_t* lo2 = data2 + (bx2 >> 6) * mask2._height + y2;
+			if (Implementation::overlapStrips(lo1, lo1 + mask1._height, bx1 & 63, lo2, lo2 + mask2._height, bx2 & 63, mask, height)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	const std::uint64_t* CollisionMask::GetFrame(std::int32_t frame, bool mirrored) const
+	{
+		if (_data == nullptr || frame < 0 || frame >= _frameCount) {
+			return nullptr;
+		}
+
+		return &_data[std::size_t(mirrored ? _frameCount + frame : frame) * _stripCount * _height];
+	}
+}
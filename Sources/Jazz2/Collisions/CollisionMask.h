@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <memory>
+
+using namespace Death;
+using namespace nCine;
+
+namespace Jazz2::Collisions
+{
+	namespace Implementation
+	{
+		extern bool DEATH_CPU_DISPATCHED_DECLARATION(overlapStrips)(const std::uint64_t* lo1, const std::uint64_t* hi1, std::int32_t shift1, const std::uint64_t* lo2, const std::uint64_t* hi2, std::int32_t shift2, std::uint64_t mask, std::size_t count);
+		DEATH_CPU_DISPATCHER_DECLARATION(overlapStrips)
+	}
+
+	/**
+		@brief Bit-packed per-pixel collision mask of all frames of a sprite sheet
+
+		Each frame is stored as vertical strips of 64 pixels, one 64-bit word per row, with the least significant bit
+		representing the leftmost pixel, so overlap of two frames can be tested row-wise with AND and shifts.
+		Horizontally mirrored copies of all frames are precomputed too, so facing left doesn't need any remapping.
+	*/
+	class CollisionMask
+	{
+	public:
+		/** @brief Minimum alpha value of a pixel to be considered solid */
+		static constexpr std::uint8_t DefaultAlphaThreshold = 40;
+
+		CollisionMask();
+
+		CollisionMask(const CollisionMask&) = delete;
+		CollisionMask& operator=(const CollisionMask&) = delete;
+		CollisionMask(CollisionMask&&) noexcept = default;
+		CollisionMask& operator=(CollisionMask&&) noexcept = default;
+
+		/** @brief Builds the mask from 32-bit pixels of the whole sheet, pixels with alpha above the threshold are solid */
+		void Initialize(const std::uint32_t* pixels, std::int32_t sheetWidth, std::int32_t sheetHeight, Vector2i frameDimensions, Vector2i frameConfiguration, std::uint8_t alphaThreshold);
+
+		explicit operator bool() const {
+			return (_data != nullptr);
+		}
+
+		/** @brief Returns `true` if a given pixel of a frame is solid */
+		bool IsPixelSet(std::int32_t frame, std::int32_t x, std::int32_t y, bool mirrored = false) const;
+		/** @brief Returns `true` if any pixel in a given rectangle of a frame is solid */
+		bool IsAnyPixelSet(std::int32_t frame, bool mirrored, std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height) const;
+
+		/** @brief Returns `true` if two frames overlap, rectangle positions are in coordinates of the corresponding frames */
+		static bool Overlaps(const CollisionMask& mask1, std::int32_t frame1, bool mirrored1, std::int32_t x1, std::int32_t y1,
+			const CollisionMask& mask2, std::int32_t frame2, bool mirrored2, std::int32_t x2, std::int32_t y2, std::int32_t width, std::int32_t height);
+
+	private:
+		std::unique_ptr<std::uint64_t[]> _data;
+		std::int32_t _width;
+		std::int32_t _height;
+		std::int32_t _frameCount;
+		std::int32_t _stripCount;
+
+		const std::uint64_t* GetFrame(std::int32_t frame, bool mirrored) const;
+	};
+}
@@ -0,0 +1,180 @@
+﻿#include "CacheManifest.h"
+#include "../ContentResolver.h"
+
+#include <IO/FileSystem.h>
+
+using namespace Death::IO;
+
+namespace Jazz2::Compatibility
+{
+	static constexpr std::uint16_t ManifestVersion = 1;
+
+	static bool ReadString(Stream& s, String& target)
+	{
+		std::uint16_t length = s.ReadValue<std::uint16_t>();
+		target = String(NoInit, length);
+		return (s.Read(target.data(), length) == length);
+	}
+
+	static void WriteString(Stream& s, const StringView value)
+	{
+		std::uint16_t length = (std::uint16_t)std::min(value.size(), (std::size_t)UINT16_MAX);
+		s.WriteValue<std::uint16_t>(length);
+		s.Write(value.data(), length);
+	}
+
+	bool CacheManifest::Load(const StringView path)
+	{
+		Entries.clear();
+
+		auto s = fs::Open(path, FileAccessMode::Read);
+		if (s->GetSize() < 16) {
+			return false;
+		}
+
+		std::uint64_t signature = s->ReadValue<std::uint64_t>();
+		std::uint8_t fileType = s->ReadValue<std::uint8_t>();
+		std::uint16_t version = s->ReadValue<std::uint16_t>();
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::CacheManifestFile || version != ManifestVersion) {
+			return false;
+		}
+
+		std::uint32_t entryCount = s->ReadValue<std::uint32_t>();
+		Entries.reserve(entryCount);
+
+		for (std::uint32_t i = 0; i < entryCount; i++) {
+			String sourceName;
+			Entry entry;
+			if (!ReadString(*s, sourceName)) {
+				Entries.clear();
+				return false;
+			}
+
+			entry.Type = (CacheSourceType)s->ReadValue<std::uint8_t>();
+			entry.ConverterVersion = s->ReadValue<std::uint32_t>();
+			entry.Size = s->ReadValue<std::int64_t>();
+			entry.LastModified = s->ReadValue<std::int64_t>();
+			entry.Hash = s->ReadValue<std::uint64_t>();
+
+			std::uint16_t outputCount = s->ReadValue<std::uint16_t>();
+			for (std::uint32_t j = 0; j < outputCount; j++) {
+				ReadString(*s, entry.Outputs.emplace_back());
+			}
+			std::uint16_t dependencyCount = s->ReadValue<std::uint16_t>();
+			for (std::uint32_t j = 0; j < dependencyCount; j++) {
+				ReadString(*s, entry.Dependencies.emplace_back());
+			}
+
+			Entries.emplace(std::move(sourceName), std::move(entry));
+		}
+
+		return true;
+	}
+
+	bool CacheManifest::Save(const StringView path) const
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsValid()) {
+			LOGE("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		so->WriteValue<std::uint64_t>(0x2095A59FF0BFBBEF);	// Signature
+		so->WriteValue<std::uint8_t>(ContentResolver::CacheManifestFile);
+		so->WriteValue<std::uint16_t>(ManifestVersion);
+		so->WriteValue<std::uint32_t>((std::uint32_t)Entries.size());
+
+		for (auto& [sourceName, entry] : Entries) {
+			WriteString(*so, sourceName);
+			so->WriteValue<std::uint8_t>((std::uint8_t)entry.Type);
+			so->WriteValue<std::uint32_t>(entry.ConverterVersion);
+			so->WriteValue<std::int64_t>(entry.Size);
+			so->WriteValue<std::int64_t>(entry.LastModified);
+			so->WriteValue<std::uint64_t>(entry.Hash);
+
+			so->WriteValue<std::uint16_t>((std::uint16_t)entry.Outputs.size());
+			for (auto& output : entry.Outputs) {
+				WriteString(*so, output);
+			}
+			so->WriteValue<std::uint16_t>((std::uint16_t)entry.Dependencies.size());
+			for (auto& dependency : entry.Dependencies) {
+				WriteString(*so, dependency);
+			}
+		}
+
+		return true;
+	}
+
+	const CacheManifest::Entry* CacheManifest::Find(const StringView sourceName) const
+	{
+		auto it = Entries.find(String::nullTerminatedView(sourceName));
+		return (it != Entries.end() ? &it->second : nullptr);
+	}
+
+	HashMap<String, CacheManifest::Entry> CacheManifest::Extract(CacheSourceType type)
+	{
+		HashMap<String, Entry> extracted;
+		for (auto it = Entries.begin(); it != Entries.end(); ) {
+			if (it->second.Type == type) {
+				extracted.emplace(it->first, std::move(it->second));
+				Entries.erase(it++);
+			} else {
+				++it;
+			}
+		}
+		return extracted;
+	}
+
+	bool CacheManifest::UpdateSourceState(const StringView sourcePath, const Entry* previous, Entry& current)
+	{
+		current.Size = fs::GetFileSize(sourcePath);
+		current.LastModified = fs::GetLastModificationTime(sourcePath).GetValue();
+		if (current.Size < 0) {
+			return false;
+		}
+
+		// Content is hashed only if the file was touched, so unchanged files are not read at all
+		if (previous != nullptr && previous->Size == current.Size && previous->LastModified == current.LastModified && current.LastModified != 0) {
+			current.Hash = previous->Hash;
+		} else {
+			current.Hash = HashFile(sourcePath);
+		}
+		return true;
+	}
+
+	bool CacheManifest::IsUpToDate(const Entry* previous, const Entry& current, const StringView cachePath)
+	{
+		if (previous == nullptr || previous->Type != current.Type || previous->ConverterVersion != current.ConverterVersion ||
+			previous->Size != current.Size || previous->Hash != current.Hash || previous->Outputs.empty()) {
+			return false;
+		}
+
+		for (auto& output : previous->Outputs) {
+			if (!fs::IsReadableFile(fs::CombinePath(cachePath, output))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::uint64_t CacheManifest::HashFile(const StringView path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		if (!s->IsValid()) {
+			return 0;
+		}
+
+		std::uint64_t hash = 0xcbf29ce484222325ull;
+		std::uint8_t buffer[16384];
+		while (true) {
+			std::int32_t bytesRead = s->Read(buffer, sizeof(buffer));
+			if (bytesRead <= 0) {
+				break;
+			}
+			for (std::int32_t i = 0; i < bytesRead; i++) {
+				hash = (hash ^ buffer[i]) * 0x00000100000001b3ull;
+			}
+		}
+		return hash;
+	}
+}
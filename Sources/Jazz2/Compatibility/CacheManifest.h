@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include "../../nCine/Base/HashMap.h"
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	/** @brief Type of converted source file */
+	enum class CacheSourceType : std::uint8_t {
+		Unknown,
+		Data,
+		Episode,
+		Level,
+		Tileset
+	};
+
+	/**
+		@brief Manifest of converted source files in `Cache` directory
+
+		Each source file is identified by its name and stores content hash and converter version, so only changed
+		files have to be converted again. Content hash is computed only if size or modification time of the file changed.
+	*/
+	class CacheManifest
+	{
+	public:
+		/** @brief State of one source file and list of files converted from it */
+		struct Entry {
+			CacheSourceType Type;
+			std::uint32_t ConverterVersion;
+			std::int64_t Size;
+			std::int64_t LastModified;
+			std::uint64_t Hash;
+			/** @brief Converted files, relative to `Cache` directory */
+			SmallVector<String, 0> Outputs;
+			/** @brief Additional source files required by converted files, e.g., tilesets used by a level */
+			SmallVector<String, 0> Dependencies;
+
+			Entry() : Type(CacheSourceType::Unknown), ConverterVersion(0), Size(-1), LastModified(0), Hash(0) { }
+		};
+
+		HashMap<String, Entry> Entries;
+
+		/** @brief Loads the manifest from a file, returns `false` if it doesn't exist or it's not valid */
+		bool Load(const StringView path);
+		/** @brief Saves the manifest to a file */
+		bool Save(const StringView path) const;
+
+		/** @brief Returns entry of a source file or `nullptr` */
+		const Entry* Find(const StringView sourceName) const;
+		/** @brief Removes all entries of a specified type, returns them */
+		HashMap<String, Entry> Extract(CacheSourceType type);
+
+		/** @brief Fills current size, modification time and hash of a source file, the hash is reused from the previous entry if possible */
+		static bool UpdateSourceState(const StringView sourcePath, const Entry* previous, Entry& current);
+		/** @brief Returns `true` if the source file wasn't changed and all converted files still exist */
+		static bool IsUpToDate(const Entry* previous, const Entry& current, const StringView cachePath);
+		/** @brief Computes 64-bit FNV-1a hash of the file content */
+		static std::uint64_t HashFile(const StringView path);
+	};
+}
@@ -573,9 +573,11 @@ namespace Jazz2::Compatibility
 		if (_verticalMPSplitscreen) {
 			flags |= 0x80;
 		}
+		flags |= 0x100; // Layer chunks
 		so->WriteValue<uint16_t>(flags);
 
 		MemoryStream ms(1024 * 1024);
+		MemoryStream chunkData(1024 * 1024);
 		{
 			DeflateWriter co(ms);
 
@@ -759,7 +761,66 @@ namespace Jazz2::Compatibility
 				}
 			}
 
+			auto writeLayerTile = [&](Stream& target, const LayerSection& layer, std::int32_t x, std::int32_t y) -> bool {
+				uint16_t tileIdx = layer.Tiles[y * layer.InternalWidth + x];
+
+				bool flipX = false, flipY = false;
+				if ((tileIdx & 0x2000) != 0) {
+					flipY = true;
+					tileIdx -= 0x2000;
+				}
+
+				if ((tileIdx & ~(maxTiles | (maxTiles - 1))) != 0) {
+					// Fix of bug in updated Psych2.j2l
+					tileIdx = (uint16_t)((tileIdx & (maxTiles | (maxTiles - 1))) | maxTiles);
+				}
+
+				// Max. tiles is either 0x0400 or 0x1000 and doubles as a mask to separate flipped tiles.
+				// In J2L, each flipped tile had a separate entry in the tile list, probably to make
+				// the dictionary concept easier to handle.
+
+				if ((tileIdx & maxTiles) > 0) {
+					flipX = true;
+					tileIdx -= maxTiles;
+				}
+
+				bool animated = false;
+				if (tileIdx >= lastTilesetTileIndex) {
+					animated = true;
+					tileIdx -= lastTilesetTileIndex;
+				}
+
+				bool legacyTranslucent = false;
+				bool invisible = false;
+				if (!animated && tileIdx < lastTilesetTileIndex) {
+					legacyTranslucent = (_staticTiles[tileIdx].Type == 1);
+					invisible = (_staticTiles[tileIdx].Type == 3);
+				}
+
+				uint8_t tileFlags = 0;
+				if (flipX) {
+					tileFlags |= 0x01;
+				}
+				if (flipY) {
+					tileFlags |= 0x02;
+				}
+				if (animated) {
+					tileFlags |= 0x04;
+				}
+
+				if (legacyTranslucent) {
+					tileFlags |= 0x10;
+				} else if (invisible) {
+					tileFlags |= 0x20;
+				}
+
+				target.WriteValue<uint8_t>(tileFlags);
+				target.WriteValue<uint16_t>(tileIdx);
+				return (tileFlags != 0 || tileIdx != 0);
+			};
+
 			// Layers
+			MemoryStream rawChunk(Tiles::TileMap::LayerChunkSize * Tiles::TileMap::LayerChunkSize * 3);
 			std::int32_t layerCount = 0;
 			for (std::int32_t i = 0; i < _layers.size(); i++) {
 				auto& layer = _layers[i];
@@ -783,6 +844,9 @@ namespace Jazz2::Compatibility
 					if (layer.Visible) {
 						flags |= 0x08;
 					}
+					if (!isSprite) {
+						flags |= 0x10;	// Chunked
+					}
 					co.WriteValue<uint16_t>(flags);	// Layer flags
 
 					co.WriteValue<int32_t>(layer.Width);
@@ -860,62 +924,38 @@ namespace Jazz2::Compatibility
 						}
 					}
 
-					for (int y = 0; y < layer.Height; y++) {
-						for (int x = 0; x < layer.Width; x++) {
-							uint16_t tileIdx = layer.Tiles[y * layer.InternalWidth + x];
-
-							bool flipX = false, flipY = false;
-							if ((tileIdx & 0x2000) != 0) {
-								flipY = true;
-								tileIdx -= 0x2000;
-							}
-
-							if ((tileIdx & ~(maxTiles | (maxTiles - 1))) != 0) {
-								// Fix of bug in updated Psych2.j2l
-								tileIdx = (uint16_t)((tileIdx & (maxTiles | (maxTiles - 1))) | maxTiles);
-							}
-
-							// Max. tiles is either 0x0400 or 0x1000 and doubles as a mask to separate flipped tiles.
-							// In J2L, each flipped tile had a separate entry in the tile list, probably to make
-							// the dictionary concept easier to handle.
-
-							if ((tileIdx & maxTiles) > 0) {
-								flipX = true;
-								tileIdx -= maxTiles;
-							}
-
-							bool animated = false;
-							if (tileIdx >= lastTilesetTileIndex) {
-								animated = true;
-								tileIdx -= lastTilesetTileIndex;
-							}
-
-							bool legacyTranslucent = false;
-							bool invisible = false;
-							if (!animated && tileIdx < lastTilesetTileIndex) {
-								legacyTranslucent = (_staticTiles[tileIdx].Type == 1);
-								invisible = (_staticTiles[tileIdx].Type == 3);
-							}
-
-							uint8_t tileFlags = 0;
-							if (flipX) {
-								tileFlags |= 0x01;
-							}
-							if (flipY) {
-								tileFlags |= 0x02;
-							}
-							if (animated) {
-								tileFlags |= 0x04;
+					if (isSprite) {
+						// Sprite layer is always needed for collisions, so it's stored inline
+						for (int y = 0; y < layer.Height; y++) {
+							for (int x = 0; x < layer.Width; x++) {
+								writeLayerTile(co, layer, x, y);
 							}
-
-							if (legacyTranslucent) {
-								tileFlags |= 0x10;
-							} else if (invisible) {
-								tileFlags |= 0x20;
+						}
+					} else {
+						// Other layers are split into independently compressed chunks, which are decompressed on demand
+						constexpr std::int32_t ChunkSize = Tiles::TileMap::LayerChunkSize;
+						co.WriteValue<uint16_t>((uint16_t)ChunkSize);
+
+						for (int cy = 0; cy < layer.Height; cy += ChunkSize) {
+							for (int cx = 0; cx < layer.Width; cx += ChunkSize) {
+								rawChunk.Seek(0, SeekOrigin::Begin);
+								bool isEmpty = true;
+								for (int y = cy; y < std::min(cy + ChunkSize, layer.Height); y++) {
+									for (int x = cx; x < std::min(cx + ChunkSize, layer.Width); x++) {
+										if (writeLayerTile(rawChunk, layer, x, y)) {
+											isEmpty = false;
+										}
+									}
+								}
+
+								std::int64_t chunkOffset = chunkData.GetPosition();
+								if (!isEmpty) {
+									DeflateWriter cw(chunkData);
+									cw.Write(rawChunk.GetBuffer(), (std::int32_t)rawChunk.GetPosition());
+								}
+								co.WriteValue<uint32_t>((uint32_t)chunkOffset);
+								co.WriteValue<uint32_t>((uint32_t)(chunkData.GetPosition() - chunkOffset));
 							}
-
-							co.WriteValue<uint8_t>(tileFlags);
-							co.WriteValue<uint16_t>(tileIdx);
 						}
 					}
 				}
@@ -982,6 +1022,9 @@ namespace Jazz2::Compatibility
 		so->WriteValue<std::int32_t>(ms.GetSize());
 		so->Write(ms.GetBuffer(), ms.GetSize());
 
+		so->WriteValue<std::int32_t>(chunkData.GetSize());
+		so->Write(chunkData.GetBuffer(), chunkData.GetSize());
+
 #if defined(DEATH_DEBUG)
 		/*auto episodeName = fs::GetFileName(fs::GetDirectoryName(targetPath));
 		if (episodeName != "unknown"_s) {
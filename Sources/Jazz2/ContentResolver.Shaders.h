@@ -62,6 +62,28 @@ void main() {
 	vTexCoords = i.texRect;
 	vColor = vec4(i.color.x, i.color.y, aPosition.x * 2.0, aPosition.y * 2.0);
 }
+)";
+
+	constexpr char InstancedLightingVs[] = "#line " DEATH_LINE_STRING "\n" R"(
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+in vec4 aInstanceTransform;
+in vec3 aInstancePosition;
+in vec4 aInstanceColor;
+in vec4 aInstanceTexRect;
+
+out vec4 vTexCoords;
+out vec4 vColor;
+
+void main() {
+	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), 0.5 - float(gl_VertexID % 2));
+	vec2 position = aPosition.x * aInstanceTransform.xy + aPosition.y * aInstanceTransform.zw + aInstancePosition.xy;
+
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(position, aInstancePosition.z, 1.0);
+	vTexCoords = aInstanceTexRect;
+	vColor = vec4(aInstanceColor.x, aInstanceColor.y, aPosition.x * 2.0, aPosition.y * 2.0);
+}
 )";
 
 	constexpr char LightingFs[] = "#line " DEATH_LINE_STRING "\n" R"(
@@ -14,6 +14,9 @@
 #include "../nCine/Graphics/ITextureLoader.h"
 #include "../nCine/Graphics/RenderResources.h"
 #include "../nCine/Base/Random.h"
+#if defined(WITH_THREADS)
+#	include "../nCine/Threading/Thread.h"
+#endif
 
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidApplication.h"
@@ -58,17 +61,32 @@ namespace Jazz2
 	}
 
 	ContentResolver::ContentResolver()
-		: _isHeadless(false), _isLoading(false), _cachedMetadata(64), _cachedGraphics(256), _cachedSounds(192), _palettes{}
+		: _isHeadless(false), _isLoading(false), _cachedMetadata(64), _cachedGraphics(256), _cachedSounds(192), _pendingPreloadRequests(0), _palettes{}
 	{
 		InitializePaths();
 	}
 
 	ContentResolver::~ContentResolver()
 	{
+#if defined(WITH_THREADS)
+		// Queued jobs must not start loading once the resolver is destroyed, running ones are waited for
+		for (auto& pending : _pendingMetadata) {
+			pending.second->State.cmpExchange(PendingMetadata::Loaded, PendingMetadata::Queued);
+			while (pending.second->State.load(Atomic32::MemoryModel::ACQUIRE) != PendingMetadata::Loaded) {
+				Thread::YieldExecution();
+			}
+		}
+#endif
 	}
 
 	void ContentResolver::Release()
 	{
+#if defined(WITH_THREADS)
+		FinishPendingLoads();
+#	if defined(WITH_COROUTINES)
+		_metadataWaiters.clear();
+#	endif
+#endif
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
 		_cachedSounds.clear();
@@ -282,6 +300,10 @@ namespace Jazz2
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 	void ContentResolver::RemountPaks()
 	{
+#if defined(WITH_THREADS)
+		FinishPendingLoads();
+#endif
+
 		// Unload all already loaded .paks
 		_mountedPaks.clear();
 
@@ -347,6 +369,11 @@ namespace Jazz2
 
 	void ContentResolver::BeginLoading()
 	{
+#if defined(WITH_THREADS)
+		// Palettes can be changed during loading, so nothing can be decoded in background anymore
+		FinishPendingLoads();
+#endif
+
 		_isLoading = true;
 
 		// Reset Referenced flag
@@ -431,10 +458,40 @@ namespace Jazz2
 		_isLoading = false;
 	}
 
-	void ContentResolver::PreloadMetadataAsync(const StringView path)
+	bool ContentResolver::PreloadMetadataAsync(const StringView path)
 	{
-		// TODO: reimplement async preloading
+#if defined(WITH_THREADS)
+		auto& threadPool = theServiceLocator().threadPool();
+		if (threadPool.GetThreadCount() > 0) {
+			String pathNormalized = fs::ToNativeSeparators(path);
+			auto it = _cachedMetadata.find(pathNormalized);
+			if (it != _cachedMetadata.end()) {
+				MarkAsReferenced(*it->second);
+				return true;
+			}
+
+			auto pendingIt = _pendingMetadata.find(pathNormalized);
+			if (pendingIt != _pendingMetadata.end()) {
+				if (pendingIt->second->State.load(Atomic32::MemoryModel::ACQUIRE) == PendingMetadata::Loaded) {
+					FinishPendingMetadata(pendingIt);
+					return true;
+				}
+				_pendingPreloadRequests++;
+				return false;
+			}
+
+			std::shared_ptr<PendingMetadata> pending = std::make_shared<PendingMetadata>();
+			pending->Path = pathNormalized;
+			pending->UploadedGraphics = 0;
+			threadPool.EnqueueCommand(std::make_unique<LoadMetadataCommand>(pending));
+			_pendingMetadata.emplace(std::move(pathNormalized), std::move(pending));
+			_pendingPreloadRequests++;
+			return false;
+		}
+#endif
+
 		RequestMetadata(path);
+		return true;
 	}
 
 	Metadata* ContentResolver::RequestMetadata(const StringView path)
@@ -443,49 +500,124 @@ namespace Jazz2
 		auto it = _cachedMetadata.find(pathNormalized);
 		if (it != _cachedMetadata.end()) {
 			// Already loaded - Mark as referenced
-			it->second->Flags |= MetadataFlags::Referenced;
+			MarkAsReferenced(*it->second);
+			return it->second.get();
+		}
+
+#if defined(WITH_THREADS)
+		auto pendingIt = _pendingMetadata.find(pathNormalized);
+		if (pendingIt != _pendingMetadata.end()) {
+			// Already requested by PreloadMetadataAsync(), it has to be finished now
+			return FinishPendingMetadata(pendingIt);
+		}
+#endif
+
+		// Try to load it
+		MetadataDescription desc;
+		if (!ParseMetadata(pathNormalized, desc)) {
+			return nullptr;
+		}
+		return BuildMetadata(std::move(pathNormalized), desc);
+	}
 
-			for (const auto& resource : it->second->Animations) {
-				resource.Base->Flags |= GenericGraphicResourceFlags::Referenced;
+	void ContentResolver::ProcessPendingLoads()
+	{
+#if defined(WITH_THREADS)
+		ZoneScopedC(0x4876AF);
+
+		// Textures are uploaded only for limited time per frame, the rest is uploaded in the next frames
+		TimeStamp frameStart = TimeStamp::now();
+		auto it = _pendingMetadata.begin();
+		while (it != _pendingMetadata.end()) {
+			PendingMetadata& pending = *it->second;
+			if (pending.State.load(Atomic32::MemoryModel::ACQUIRE) != PendingMetadata::Loaded) {
+				++it;
+				continue;
 			}
+			if (pending.IsValid && !UploadPendingGraphics(pending, frameStart)) {
+				break;
+			}
+
+			auto current = it++;
+			FinishPendingMetadata(current);
+		}
 
-			for (const auto& [key, resource] : it->second->Sounds) {
-				for (const auto& base : resource.Buffers) {
-					base->Flags |= GenericSoundResourceFlags::Referenced;
+#	if defined(WITH_COROUTINES)
+		// Resumed coroutines can request other metadata, so the list must not be modified while iterating
+		if (!_metadataWaiters.empty()) {
+			SmallVector<MetadataWaiter, 0> waiters;
+			std::swap(waiters, _metadataWaiters);
+			for (auto& waiter : waiters) {
+				if (auto owner = waiter.Owner.lock()) {
+					waiter.Handle.resume();
 				}
 			}
+		}
+#	endif
+#endif
+	}
 
-			return it->second.get();
+#if defined(WITH_COROUTINES)
+	bool ContentResolver::ResumeWhenMetadataLoaded(const StringView path, std::weak_ptr<void> owner, std::coroutine_handle<> handle)
+	{
+#	if defined(WITH_THREADS)
+		auto it = _pendingMetadata.find(fs::ToNativeSeparators(path));
+		if (it != _pendingMetadata.end()) {
+			it->second->Waiters.push_back({ std::move(owner), handle });
+			return true;
 		}
+#	endif
+		return false;
+	}
+#endif
 
-		// Try to load it
-		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Metadata"_s, String(pathNormalized + ".res"_s) }), FileAccessMode::Read);
+	std::uint32_t ContentResolver::GetPendingPreloadRequests() const
+	{
+		return _pendingPreloadRequests;
+	}
+
+	void ContentResolver::MarkAsReferenced(Metadata& metadata)
+	{
+		metadata.Flags |= MetadataFlags::Referenced;
+
+		for (const auto& resource : metadata.Animations) {
+			resource.Base->Flags |= GenericGraphicResourceFlags::Referenced;
+		}
+
+		for (const auto& [key, resource] : metadata.Sounds) {
+			for (const auto& base : resource.Buffers) {
+				base->Flags |= GenericSoundResourceFlags::Referenced;
+			}
+		}
+	}
+
+	bool ContentResolver::ParseMetadata(const StringView path, MetadataDescription& desc)
+	{
+		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Metadata"_s, String(path + ".res"_s) }), FileAccessMode::Read);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit
-			return nullptr;
+			return false;
 		}
 
 		auto buffer = std::make_unique<char[]>(fileSize + simdjson::SIMDJSON_PADDING);
 		s->Read(buffer.get(), fileSize);
 		buffer[fileSize] = '\0';
 
-		bool multipleAnimsNoStatesWarning = false;
-
-		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
-		metadata->Path = std::move(pathNormalized);
-		metadata->Flags |= MetadataFlags::Referenced;
+		desc.BoundingBox = Vector2i();
+		desc.AnimationCount = 0;
 
 		ondemand::parser parser;
 		ondemand::document doc;
 		if (parser.iterate(buffer.get(), fileSize, fileSize + simdjson::SIMDJSON_PADDING).get(doc) == SUCCESS) {
-			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
+			desc.BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
 
 			ondemand::object animations;
 			if (doc["Animations"].get(animations) == SUCCESS) {
 				size_t count;
 				if (animations.count_fields().get(count) == SUCCESS) {
-					metadata->Animations.reserve(count);
+					desc.Animations.reserve(count);
+					desc.AnimationCount = count;
 				}
 
 				for (auto it : animations) {
@@ -496,15 +628,16 @@ namespace Jazz2
 						continue;
 					}
 
-					GraphicResource graphics;
-					graphics.LoopMode = AnimationLoopMode::Loop;
+					AnimationDescription& anim = desc.Animations.emplace_back();
+					anim.Path = assetPath;
+					anim.LoopMode = AnimationLoopMode::Loop;
 
 					//bool keepIndexed = false;
 
 					std::uint64_t flags;
 					if (value["Flags"].get(flags) == SUCCESS) {
 						if ((flags & 0x01) == 0x01) {
-							graphics.LoopMode = AnimationLoopMode::Once;
+							anim.LoopMode = AnimationLoopMode::Once;
 						}
 						//if ((flags & 0x02) == 0x02) {
 						//	keepIndexed = true;
@@ -516,71 +649,35 @@ namespace Jazz2
 					if (value["PaletteOffset"].get(paletteOffset) != SUCCESS) {
 						paletteOffset = 0;
 					}
-
-					graphics.Base = RequestGraphics(assetPath, (uint16_t)paletteOffset);
-					if (graphics.Base == nullptr) {
-						continue;
-					}
+					anim.PaletteOffset = (std::uint16_t)paletteOffset;
 
 					std::int64_t frameOffset;
 					if (value["FrameOffset"].get(frameOffset) != SUCCESS) {
 						frameOffset = 0;
 					}
-					graphics.FrameOffset = (int32_t)frameOffset;
-
-					graphics.AnimDuration = graphics.Base->AnimDuration;
-					graphics.FrameCount = graphics.Base->FrameCount;
+					anim.FrameOffset = (std::int32_t)frameOffset;
 
 					std::int64_t frameCount;
-					if (value["FrameCount"].get(frameCount) == SUCCESS) {
-						graphics.FrameCount = (int32_t)frameCount;
-					} else {
-						graphics.FrameCount -= graphics.FrameOffset;
-					}
+					anim.FrameCount = (value["FrameCount"].get(frameCount) == SUCCESS ? (std::int32_t)frameCount : -1);
 
 					// TODO: Use AnimDuration instead
 					double frameRate;
-					if (value["FrameRate"].get(frameRate) == SUCCESS) {
-						graphics.AnimDuration = (frameRate <= 0 ? -1.0f : (1.0f / (float)frameRate) * 5.0f);
-					}
-
-					// If no bounding box is provided, use the first sprite
-					if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
-						// TODO: Remove this bounding box reduction
-						metadata->BoundingBox = graphics.Base->FrameDimensions - Vector2i(2, 2);
+					anim.HasFrameRate = (value["FrameRate"].get(frameRate) == SUCCESS);
+					if (anim.HasFrameRate) {
+						anim.AnimDuration = (frameRate <= 0 ? -1.0f : (1.0f / (float)frameRate) * 5.0f);
 					}
 
 					ondemand::array states;
-					if (value["States"].get(states) == SUCCESS) {
+					anim.HasStates = (value["States"].get(states) == SUCCESS);
+					if (anim.HasStates) {
 						for (auto stateItem : states) {
 							std::int64_t state;
 							if (stateItem.get(state) == SUCCESS) {
-#if defined(DEATH_DEBUG)
-								// Additional checks only for Debug configuration
-								for (const auto& anim : metadata->Animations) {
-									if (anim.State == (AnimState)state) {
-										LOGW("Animation state %u defined twice in file \"%s\"", (std::uint32_t)state, path.data());
-										break;
-									}
-								}
-#endif
-								graphics.State = (AnimState)state;
-								metadata->Animations.push_back(graphics);
+								anim.States.push_back((AnimState)state);
 							}
 						}
-					} else if (count > 1) {
-						if (!multipleAnimsNoStatesWarning) {
-							multipleAnimsNoStatesWarning = true;
-							LOGW("Multiple animations defined but no states specified in file \"%s\"", path.data());
-						}
-					} else {
-						graphics.State = AnimState::Default;
-						metadata->Animations.push_back(graphics);
 					}
 				}
-
-				// Animation states must be sorted, so binary search can be used
-				sort(metadata->Animations.begin(), metadata->Animations.end());
 			}
 
 			if (!_isHeadless) {
@@ -589,7 +686,7 @@ namespace Jazz2
 				if (doc["Sounds"].get(sounds) == SUCCESS) {
 					size_t count;
 					if (sounds.count_fields().get(count) == SUCCESS) {
-						metadata->Sounds.reserve(count);
+						desc.Sounds.reserve(count);
 					}
 
 					for (auto it : sounds) {
@@ -602,35 +699,213 @@ namespace Jazz2
 							continue;
 						}
 
-						SoundResource sound;
+						SoundDescription& sound = desc.Sounds.emplace_back();
+						sound.Key = key;
 						for (auto assetPathItem : assetPaths) {
 							std::string_view assetPath;
 							if (assetPathItem.get(assetPath) == SUCCESS && !assetPath.empty()) {
-								auto assetPathNormalized = fs::ToNativeSeparators(assetPath);
-								auto it = _cachedSounds.find(assetPathNormalized);
-								if (it != _cachedSounds.end()) {
-									it->second->Flags |= GenericSoundResourceFlags::Referenced;
-									sound.Buffers.emplace_back(it->second.get());
-								} else {
-									auto s = OpenContentFile(fs::CombinePath("Animations"_s, assetPathNormalized));
-									auto res = _cachedSounds.emplace(assetPathNormalized, std::make_unique<GenericSoundResource>(std::move(s), assetPathNormalized));
-									res.first->second->Flags |= GenericSoundResourceFlags::Referenced;
-									sound.Buffers.emplace_back(res.first->second.get());
-								}
+								sound.Paths.push_back(fs::ToNativeSeparators(assetPath));
 							}
 						}
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	Metadata* ContentResolver::BuildMetadata(String&& path, const MetadataDescription& desc)
+	{
+		bool multipleAnimsNoStatesWarning = false;
+
+		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
+		metadata->Path = std::move(path);
+		metadata->Flags |= MetadataFlags::Referenced;
+		metadata->BoundingBox = desc.BoundingBox;
+		metadata->Animations.reserve(desc.Animations.size());
+
+		for (const auto& anim : desc.Animations) {
+			GraphicResource graphics;
+			graphics.LoopMode = anim.LoopMode;
+			graphics.Base = RequestGraphics(anim.Path, anim.PaletteOffset);
+			if (graphics.Base == nullptr) {
+				continue;
+			}
+
+			graphics.FrameOffset = anim.FrameOffset;
+			graphics.AnimDuration = (anim.HasFrameRate ? anim.AnimDuration : graphics.Base->AnimDuration);
+			graphics.FrameCount = (anim.FrameCount >= 0 ? anim.FrameCount : graphics.Base->FrameCount - graphics.FrameOffset);
 
-						if (!sound.Buffers.empty()) {
-							metadata->Sounds.emplace(key, std::move(sound));
+			// If no bounding box is provided, use the first sprite
+			if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
+				// TODO: Remove this bounding box reduction
+				metadata->BoundingBox = graphics.Base->FrameDimensions - Vector2i(2, 2);
+			}
+
+			if (anim.HasStates) {
+				for (AnimState state : anim.States) {
+#if defined(DEATH_DEBUG)
+					// Additional checks only for Debug configuration
+					for (const auto& existing : metadata->Animations) {
+						if (existing.State == state) {
+							LOGW("Animation state %u defined twice in file \"%s\"", (std::uint32_t)state, metadata->Path.data());
+							break;
 						}
 					}
+#endif
+					graphics.State = state;
+					metadata->Animations.push_back(graphics);
 				}
+			} else if (desc.AnimationCount > 1) {
+				if (!multipleAnimsNoStatesWarning) {
+					multipleAnimsNoStatesWarning = true;
+					LOGW("Multiple animations defined but no states specified in file \"%s\"", metadata->Path.data());
+				}
+			} else {
+				graphics.State = AnimState::Default;
+				metadata->Animations.push_back(graphics);
 			}
 		}
 
+		// Animation states must be sorted, so binary search can be used
+		sort(metadata->Animations.begin(), metadata->Animations.end());
+
+#if defined(WITH_AUDIO)
+		if (!desc.Sounds.empty()) {
+			metadata->Sounds.reserve(desc.Sounds.size());
+
+			for (const auto& soundDesc : desc.Sounds) {
+				SoundResource sound;
+				for (const auto& assetPath : soundDesc.Paths) {
+					auto it = _cachedSounds.find(assetPath);
+					if (it != _cachedSounds.end()) {
+						it->second->Flags |= GenericSoundResourceFlags::Referenced;
+						sound.Buffers.emplace_back(it->second.get());
+					} else {
+						auto s = OpenContentFile(fs::CombinePath("Animations"_s, assetPath));
+						auto res = _cachedSounds.emplace(assetPath, std::make_unique<GenericSoundResource>(std::move(s), assetPath));
+						res.first->second->Flags |= GenericSoundResourceFlags::Referenced;
+						sound.Buffers.emplace_back(res.first->second.get());
+					}
+				}
+
+				if (!sound.Buffers.empty()) {
+					metadata->Sounds.emplace(soundDesc.Key, std::move(sound));
+				}
+			}
+		}
+#endif
+
 		return _cachedMetadata.emplace(metadata->Path, std::move(metadata)).first->second.get();
 	}
 
+#if defined(WITH_THREADS)
+	void ContentResolver::LoadMetadataCommand::Execute()
+	{
+		// The main thread can take it over if it's needed before any worker thread picks it up,
+		// the resolver is accessed only if the job is still queued, so never after FinishPendingLoads()
+		if (_pending->State.cmpExchange(PendingMetadata::Loading, PendingMetadata::Queued)) {
+			ContentResolver::Get().LoadPendingMetadata(*_pending);
+		}
+	}
+
+	void ContentResolver::LoadPendingMetadata(PendingMetadata& pending)
+	{
+		ZoneScopedC(0x4876AF);
+
+		// This runs on a worker thread, so it must not touch any cache, graphics are only decoded here
+		pending.IsValid = ParseMetadata(pending.Path, pending.Description);
+		if (pending.IsValid) {
+			for (const auto& anim : pending.Description.Animations) {
+				String pathNormalized = fs::ToNativeSeparators(anim.Path);
+				bool alreadyLoaded = false;
+				for (const auto& graphics : pending.Graphics) {
+					if (graphics->PaletteOffset == anim.PaletteOffset && graphics->Path == pathNormalized) {
+						alreadyLoaded = true;
+						break;
+					}
+				}
+				if (!alreadyLoaded) {
+					std::unique_ptr<PendingGraphics> graphics = LoadGraphics(pathNormalized, anim.PaletteOffset);
+					if (graphics != nullptr) {
+						pending.Graphics.push_back(std::move(graphics));
+					}
+				}
+			}
+		}
+
+		pending.State.store(PendingMetadata::Loaded, Atomic32::MemoryModel::RELEASE);
+	}
+
+	bool ContentResolver::UploadPendingGraphics(PendingMetadata& pending, const TimeStamp& frameStart)
+	{
+		while (pending.UploadedGraphics < (std::int32_t)pending.Graphics.size()) {
+			if (frameStart.millisecondsSince() >= MaxUploadTimePerFrame) {
+				return false;
+			}
+
+			PendingGraphics& graphics = *pending.Graphics[pending.UploadedGraphics];
+			if (_cachedGraphics.find(Pair(String::nullTerminatedView(graphics.Path), graphics.PaletteOffset)) != _cachedGraphics.end() ||
+				UploadGraphics(graphics, UploadRowsPerStep)) {
+				pending.UploadedGraphics++;
+			}
+		}
+		return true;
+	}
+
+	Metadata* ContentResolver::FinishPendingMetadata(HashMap<String, std::shared_ptr<PendingMetadata>>::iterator it)
+	{
+		ZoneScopedC(0x4876AF);
+
+		std::shared_ptr<PendingMetadata> pending = std::move(it->second);
+		_pendingMetadata.erase(it);
+
+#	if defined(WITH_COROUTINES)
+		for (auto& waiter : pending->Waiters) {
+			_metadataWaiters.push_back(std::move(waiter));
+		}
+#	endif
+
+		if (pending->State.cmpExchange(PendingMetadata::Loading, PendingMetadata::Queued)) {
+			LoadPendingMetadata(*pending);
+		} else {
+			while (pending->State.load(Atomic32::MemoryModel::ACQUIRE) != PendingMetadata::Loaded) {
+				Thread::YieldExecution();
+			}
+		}
+
+		if (!pending->IsValid) {
+			return nullptr;
+		}
+
+		// Upload decoded textures on the main thread, unless the same graphics were loaded in the meantime
+		for (auto& graphics : pending->Graphics) {
+			if (_cachedGraphics.find(Pair(String::nullTerminatedView(graphics->Path), graphics->PaletteOffset)) == _cachedGraphics.end()) {
+				FinishGraphics(*graphics);
+			}
+		}
+
+		return BuildMetadata(std::move(pending->Path), pending->Description);
+	}
+
+	void ContentResolver::FinishPendingLoads()
+	{
+		while (!_pendingMetadata.empty()) {
+			FinishPendingMetadata(_pendingMetadata.begin());
+		}
+	}
+#endif
+
+	ContentResolver::PendingGraphics::PendingGraphics()
+		: PaletteOffset(0), Pixels(nullptr), Width(0), Height(0), UploadedRows(0), LinearSampling(false)
+	{
+	}
+
+	ContentResolver::PendingGraphics::~PendingGraphics()
+	{
+	}
+
 	GenericGraphicResource* ContentResolver::RequestGraphics(const StringView path, uint16_t paletteOffset)
 	{
 		// First resources are requested, reset _isLoading flag, because palette should be already applied
@@ -644,11 +919,17 @@ namespace Jazz2
 			return it->second.get();
 		}
 
-		if (fs::GetExtension(pathNormalized) == "aura"_s) {
-			return RequestGraphicsAura(pathNormalized, paletteOffset);
+		std::unique_ptr<PendingGraphics> graphics = LoadGraphics(pathNormalized, paletteOffset);
+		return (graphics != nullptr ? FinishGraphics(*graphics) : nullptr);
+	}
+
+	std::unique_ptr<ContentResolver::PendingGraphics> ContentResolver::LoadGraphics(const StringView path, uint16_t paletteOffset)
+	{
+		if (fs::GetExtension(path) == "aura"_s) {
+			return LoadGraphicsAura(path, paletteOffset);
 		}
 
-		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, String(pathNormalized + ".res"_s) }), FileAccessMode::Read);
+		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, String(path + ".res"_s) }), FileAccessMode::Read);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
@@ -664,20 +945,25 @@ namespace Jazz2
 		ondemand::document doc;
 		if (parser.iterate(buffer.get(), fileSize, fileSize + simdjson::SIMDJSON_PADDING).get(doc) == SUCCESS) {
 			// Try to load it
-			std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
+			std::unique_ptr<PendingGraphics> pending = std::make_unique<PendingGraphics>();
+			pending->Path = path;
+			pending->PaletteOffset = paletteOffset;
+			pending->TextureName = fs::CombinePath({ GetContentPath(), "Animations"_s, path });
+			pending->Resource = std::make_unique<GenericGraphicResource>();
+
+			GenericGraphicResource* graphics = pending->Resource.get();
 			graphics->Flags |= GenericGraphicResourceFlags::Referenced;
 
-			String fullPath = fs::CombinePath({ GetContentPath(), "Animations"_s, pathNormalized });
-			std::unique_ptr<ITextureLoader> texLoader = ITextureLoader::createFromFile(fullPath);
-			if (texLoader->hasLoaded()) {
-				auto texFormat = texLoader->texFormat().internalFormat();
+			pending->TextureLoader = ITextureLoader::createFromFile(pending->TextureName);
+			if (pending->TextureLoader->hasLoaded()) {
+				auto texFormat = pending->TextureLoader->texFormat().internalFormat();
 				if (texFormat != GL_RGBA8 && texFormat != GL_RGB8) {
 					return nullptr;
 				}
 
-				int32_t w = texLoader->width();
-				int32_t h = texLoader->height();
-				uint32_t* pixels = (uint32_t*)texLoader->pixels();
+				int32_t w = pending->TextureLoader->width();
+				int32_t h = pending->TextureLoader->height();
+				uint32_t* pixels = (uint32_t*)pending->TextureLoader->pixels();
 				const uint32_t* palette = _palettes + paletteOffset;
 				bool linearSampling = false;
 				bool needsMask = true;
@@ -697,31 +983,24 @@ namespace Jazz2
 					}
 				}
 
-				if (needsMask) {
-					graphics->Mask = std::make_unique<uint8_t[]>(w * h);
+				graphics->FrameDimensions = GetVector2iFromJson(doc["FrameSize"]);
+				graphics->FrameConfiguration = GetVector2iFromJson(doc["FrameConfiguration"]);
 
-					for (int32_t i = 0; i < w * h; i++) {
-						// Save original alpha value for collision checking
-						graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-						if (palette != nullptr) {
-							uint32_t color = palette[pixels[i] & 0xff];
-							pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-						}
-					}
-				} else if (palette != nullptr) {
+				if (needsMask) {
+					// Save original alpha values for collision checking
+					graphics->Mask.Initialize(pixels, w, h, graphics->FrameDimensions, graphics->FrameConfiguration, Collisions::CollisionMask::DefaultAlphaThreshold);
+				}
+				if (palette != nullptr) {
 					for (int32_t i = 0; i < w * h; i++) {
 						uint32_t color = palette[pixels[i] & 0xff];
 						pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 					}
 				}
 
-				if (!_isHeadless) {
-					// Don't load textures in headless mode, only collision masks
-					graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
-					graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels, 0, 0, w, h);
-					graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-					graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-				}
+				pending->Pixels = pixels;
+				pending->Width = w;
+				pending->Height = h;
+				pending->LinearSampling = linearSampling;
 
 				double animDuration;
 				if (doc["Duration"].get(animDuration) != SUCCESS) {
@@ -735,24 +1014,18 @@ namespace Jazz2
 				}
 				graphics->FrameCount = (int32_t)frameCount;
 
-				graphics->FrameDimensions = GetVector2iFromJson(doc["FrameSize"]);
-				graphics->FrameConfiguration = GetVector2iFromJson(doc["FrameConfiguration"]);
-				
 				graphics->Hotspot = GetVector2iFromJson(doc["Hotspot"]);
 				graphics->Coldspot = GetVector2iFromJson(doc["Coldspot"], Vector2i(InvalidValue, InvalidValue));
 				graphics->Gunspot = GetVector2iFromJson(doc["Gunspot"], Vector2i(InvalidValue, InvalidValue));
 
-#if defined(DEATH_DEBUG)
-				MigrateGraphics(pathNormalized);
-#endif
-				return _cachedGraphics.emplace(Pair(String(pathNormalized), paletteOffset), std::move(graphics)).first->second.get();
+				return pending;
 			}
 		}
 
 		return nullptr;
 	}
 
-	GenericGraphicResource* ContentResolver::RequestGraphicsAura(const StringView path, uint16_t paletteOffset)
+	std::unique_ptr<ContentResolver::PendingGraphics> ContentResolver::LoadGraphicsAura(const StringView path, uint16_t paletteOffset)
 	{
 		auto s = OpenContentFile(fs::CombinePath("Animations"_s, path));
 
@@ -762,41 +1035,51 @@ namespace Jazz2
 			return nullptr;
 		}
 
-		uint64_t signature1 = s->ReadValue<uint64_t>();
-		uint32_t signature2 = s->ReadValue<uint16_t>();
-		uint8_t version = s->ReadValue<uint8_t>();
-		uint8_t flags = s->ReadValue<uint8_t>();
+		BufferedStream bs(*s);
+		uint64_t signature1 = bs.ReadValue<uint64_t>();
+		uint32_t signature2 = bs.ReadValue<uint16_t>();
+		uint8_t version = bs.ReadValue<uint8_t>();
+		uint8_t flags = bs.ReadValue<uint8_t>();
 
 		if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2 || (flags & 0x80) != 0x80) {
 			return nullptr;
 		}
 
-		uint8_t channelCount = s->ReadValue<uint8_t>();
-		uint32_t frameDimensionsX = s->ReadValue<uint32_t>();
-		uint32_t frameDimensionsY = s->ReadValue<uint32_t>();
+		uint8_t channelCount = bs.ReadValue<uint8_t>();
+		uint32_t frameDimensionsX = bs.ReadValue<uint32_t>();
+		uint32_t frameDimensionsY = bs.ReadValue<uint32_t>();
 
-		uint8_t frameConfigurationX = s->ReadValue<uint8_t>();
-		uint8_t frameConfigurationY = s->ReadValue<uint8_t>();
-		uint16_t frameCount = s->ReadValue<uint16_t>();
-		uint16_t animDuration = s->ReadValue<uint16_t>();
+		uint8_t frameConfigurationX = bs.ReadValue<uint8_t>();
+		uint8_t frameConfigurationY = bs.ReadValue<uint8_t>();
+		uint16_t frameCount = bs.ReadValue<uint16_t>();
+		uint16_t animDuration = bs.ReadValue<uint16_t>();
 
-		uint16_t hotspotX = s->ReadValue<uint16_t>();
-		uint16_t hotspotY = s->ReadValue<uint16_t>();
+		uint16_t hotspotX = bs.ReadValue<uint16_t>();
+		uint16_t hotspotY = bs.ReadValue<uint16_t>();
 
-		uint16_t coldspotX = s->ReadValue<uint16_t>();
-		uint16_t coldspotY = s->ReadValue<uint16_t>();
+		uint16_t coldspotX = bs.ReadValue<uint16_t>();
+		uint16_t coldspotY = bs.ReadValue<uint16_t>();
 
-		uint16_t gunspotX = s->ReadValue<uint16_t>();
-		uint16_t gunspotY = s->ReadValue<uint16_t>();
+		uint16_t gunspotX = bs.ReadValue<uint16_t>();
+		uint16_t gunspotY = bs.ReadValue<uint16_t>();
 
 		uint32_t width = frameDimensionsX * frameConfigurationX;
 		uint32_t height = frameDimensionsY * frameConfigurationY;
 
-		std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
+		std::unique_ptr<PendingGraphics> pending = std::make_unique<PendingGraphics>();
+		pending->Path = path;
+		pending->PaletteOffset = paletteOffset;
+		pending->TextureName = path;
+		pending->PixelData = std::make_unique<uint32_t[]>(width * height);
+		pending->Pixels = pending->PixelData.get();
+		pending->Width = width;
+		pending->Height = height;
+		pending->Resource = std::make_unique<GenericGraphicResource>();
 
-		ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount);
+		uint32_t* pixels = pending->Pixels;
+		ReadImageFromFile(bs, (uint8_t*)pixels, width, height, channelCount);
 
-		std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
+		GenericGraphicResource* graphics = pending->Resource.get();
 		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
 
 		const uint32_t* palette = _palettes + paletteOffset;
@@ -811,30 +1094,18 @@ namespace Jazz2
 		}
 
 		if (needsMask) {
-			graphics->Mask = std::make_unique<uint8_t[]>(width * height);
-
-			for (uint32_t i = 0; i < width * height; i++) {
-				// Save original alpha value for collision checking
-				graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-				if (palette != nullptr) {
-					uint32_t color = palette[pixels[i] & 0xff];
-					pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-				}
-			}
-		} else if (palette != nullptr) {
+			// Save original alpha values for collision checking
+			graphics->Mask.Initialize(pixels, width, height, Vector2i(frameDimensionsX, frameDimensionsY),
+				Vector2i(frameConfigurationX, frameConfigurationY), Collisions::CollisionMask::DefaultAlphaThreshold);
+		}
+		if (palette != nullptr) {
 			for (uint32_t i = 0; i < width * height; i++) {
 				uint32_t color = palette[pixels[i] & 0xff];
 				pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 			}
 		}
 
-		if (!_isHeadless) {
-			// Don't load textures in headless mode, only collision masks
-			graphics->TextureDiffuse = std::make_unique<Texture>(path.data(), Texture::Format::RGBA8, width, height);
-			graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels.get(), 0, 0, width, height);
-			graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-			graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-		}
+		pending->LinearSampling = linearSampling;
 
 		// AnimDuration is multiplied by 256 before saving, so divide it here back
 		graphics->AnimDuration = animDuration / 256.0f;
@@ -860,10 +1131,45 @@ namespace Jazz2
 			graphics->Gunspot = Vector2i(InvalidValue, InvalidValue);
 		}
 
-		return _cachedGraphics.emplace(Pair(String(path), paletteOffset), std::move(graphics)).first->second.get();
+		return pending;
+	}
+
+	bool ContentResolver::UploadGraphics(PendingGraphics& pending, std::int32_t maxRows)
+	{
+		if (_isHeadless) {
+			// Don't load textures in headless mode, only collision masks
+			return true;
+		}
+
+		GenericGraphicResource* graphics = pending.Resource.get();
+		if (graphics->TextureDiffuse == nullptr) {
+			graphics->TextureDiffuse = std::make_unique<Texture>(pending.TextureName.data(), Texture::Format::RGBA8, pending.Width, pending.Height);
+			graphics->TextureDiffuse->setMinFiltering(pending.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			graphics->TextureDiffuse->setMagFiltering(pending.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		}
+
+		std::int32_t rows = std::min(maxRows, pending.Height - pending.UploadedRows);
+		if (rows > 0) {
+			graphics->TextureDiffuse->loadFromTexels((unsigned char*)(pending.Pixels + pending.UploadedRows * pending.Width), 0, pending.UploadedRows, pending.Width, rows);
+			pending.UploadedRows += rows;
+		}
+		return (pending.UploadedRows >= pending.Height);
+	}
+
+	GenericGraphicResource* ContentResolver::FinishGraphics(PendingGraphics& pending)
+	{
+		UploadGraphics(pending, INT32_MAX);
+
+#if defined(DEATH_DEBUG)
+		if (pending.TextureLoader != nullptr) {
+			MigrateGraphics(pending.Path);
+		}
+#endif
+
+		return _cachedGraphics.emplace(Pair(std::move(pending.Path), pending.PaletteOffset), std::move(pending.Resource)).first->second.get();
 	}
 
-	void ContentResolver::ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
+	void ContentResolver::ReadImageFromFile(BufferedStream& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
 	{
 		typedef union {
 			struct {
@@ -883,51 +1189,92 @@ namespace Jazz2
 
 		#define QOI_COLOR_HASH(C) (C.rgba.r*3 + C.rgba.g*5 + C.rgba.b*7 + C.rgba.a*11)
 
+		// The longest chunk is QOI_OP_RGBA, so chunks starting before the last 4 bytes of a span don't need bounds checks
+		constexpr int32_t MaxChunkSize = 5;
+
 		rgba_t index[64] { };
 		rgba_t px;
-		int32_t run = 0;
 		int32_t px_len = width * height * channelCount;
+		int32_t px_pos = 0;
 
 		px.rgba.r = 0;
 		px.rgba.g = 0;
 		px.rgba.b = 0;
 		px.rgba.a = 255;
 
-		for (int32_t px_pos = 0; px_pos < px_len; px_pos += channelCount) {
-			if (run > 0) {
-				run--;
+		while (px_pos < px_len) {
+			// The whole rest of the stream is returned if it's in memory, otherwise the buffered window
+			auto span = s.Peek(MaxChunkSize);
+			if (span.empty()) {
+				break;
+			}
+
+			uint8_t tail[MaxChunkSize] { };
+			const uint8_t* src;
+			const uint8_t* srcLast;
+			if (span.size() >= MaxChunkSize) {
+				src = span.data();
+				srcLast = src + span.size() - (MaxChunkSize - 1);
 			} else {
-				int32_t b1 = s->ReadValue<uint8_t>();
-
-				if (b1 == QOI_OP_RGB) {
-					px.rgba.r = s->ReadValue<uint8_t>();
-					px.rgba.g = s->ReadValue<uint8_t>();
-					px.rgba.b = s->ReadValue<uint8_t>();
-				} else if (b1 == QOI_OP_RGBA) {
-					px.rgba.r = s->ReadValue<uint8_t>();
-					px.rgba.g = s->ReadValue<uint8_t>();
-					px.rgba.b = s->ReadValue<uint8_t>();
-					px.rgba.a = s->ReadValue<uint8_t>();
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
-					px = index[b1];
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
-					px.rgba.r += ((b1 >> 4) & 0x03) - 2;
-					px.rgba.g += ((b1 >> 2) & 0x03) - 2;
-					px.rgba.b += (b1 & 0x03) - 2;
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
-					int32_t b2 = s->ReadValue<uint8_t>();
-					int32_t vg = (b1 & 0x3f) - 32;
-					px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
-					px.rgba.g += vg;
-					px.rgba.b += vg - 8 + (b2 & 0x0f);
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_RUN) {
-					run = (b1 & 0x3f);
+				// End of the stream, decode the last chunk from zero-padded copy
+				std::memcpy(tail, span.data(), span.size());
+				src = tail;
+				srcLast = tail + 1;
+			}
+			const uint8_t* srcBegin = src;
+
+			while (src < srcLast && px_pos < px_len) {
+				int32_t b1 = *src++;
+
+				if (b1 >= QOI_OP_RGB) {
+					px.rgba.r = src[0];
+					px.rgba.g = src[1];
+					px.rgba.b = src[2];
+					if (b1 == QOI_OP_RGBA) {
+						px.rgba.a = src[3];
+						src += 4;
+					} else {
+						src += 3;
+					}
+				} else {
+					switch (b1 & QOI_MASK_2) {
+						case QOI_OP_INDEX: {
+							px = index[b1];
+							break;
+						}
+						case QOI_OP_DIFF: {
+							px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+							px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+							px.rgba.b += (b1 & 0x03) - 2;
+							break;
+						}
+						case QOI_OP_LUMA: {
+							int32_t b2 = *src++;
+							int32_t vg = (b1 & 0x3f) - 32;
+							px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
+							px.rgba.g += vg;
+							px.rgba.b += vg - 8 + (b2 & 0x0f);
+							break;
+						}
+						case QOI_OP_RUN: {
+							// Repeat the previous pixel, the run never continues to the next chunk
+							int32_t run_end = std::min(px_pos + (b1 & 0x3f) * channelCount, px_len - channelCount);
+							while (px_pos < run_end) {
+								std::memcpy(data + px_pos, &px, sizeof(px));
+								px_pos += channelCount;
+							}
+							break;
+						}
+					}
 				}
 
 				index[QOI_COLOR_HASH(px) & 63] = px;
+
+				std::memcpy(data + px_pos, &px, sizeof(px));
+				px_pos += channelCount;
 			}
 
-			*(rgba_t*)(data + px_pos) = px;
+			s.Consume(std::min(static_cast<int32_t>(src - srcBegin), static_cast<int32_t>(span.size())));
 		}
 	}
 
@@ -944,22 +1291,23 @@ namespace Jazz2
 			return nullptr;
 		}
 
-		std::uint64_t signature1 = s->ReadValue<std::uint64_t>();
-		std::uint16_t signature2 = s->ReadValue<std::uint16_t>();
-		std::uint8_t version = s->ReadValue<std::uint8_t>();
-		/*std::uint8_t flags =*/ s->ReadValue<std::uint8_t>();
+		BufferedStream bs(*s);
+		std::uint64_t signature1 = bs.ReadValue<std::uint64_t>();
+		std::uint16_t signature2 = bs.ReadValue<std::uint16_t>();
+		std::uint8_t version = bs.ReadValue<std::uint8_t>();
+		/*std::uint8_t flags =*/ bs.ReadValue<std::uint8_t>();
 		ASSERT_MSG(signature1 == 0xB8EF8498E2BFBBEF && signature2 == 0x208F && version == 2, "Invalid file");
 
 		// TODO: Use single channel instead
-		std::uint8_t channelCount = s->ReadValue<std::uint8_t>();
-		std::uint32_t width = s->ReadValue<std::uint32_t>();
-		std::uint32_t height = s->ReadValue<std::uint32_t>();
-		std::uint16_t tileCount = s->ReadValue<std::uint16_t>();
+		std::uint8_t channelCount = bs.ReadValue<std::uint8_t>();
+		std::uint32_t width = bs.ReadValue<std::uint32_t>();
+		std::uint32_t height = bs.ReadValue<std::uint32_t>();
+		std::uint16_t tileCount = bs.ReadValue<std::uint16_t>();
 
 		// Read compressed palette and mask
-		std::int32_t compressedSize = s->ReadValue<std::int32_t>();
+		std::int32_t compressedSize = bs.ReadValue<std::int32_t>();
 
-		DeflateStream uc(*s, compressedSize);
+		DeflateStream uc(bs, compressedSize);
 
 		// Palette
 		if (applyPalette) {
@@ -990,8 +1338,10 @@ namespace Jazz2
 		// Mask
 		std::uint32_t maskSize = uc.ReadValue<std::uint32_t>();
 		std::unique_ptr<uint8_t[]> mask = std::make_unique<std::uint8_t[]>(maskSize * 8);
-		for (std::uint32_t j = 0; j < maskSize; j++) {
-			std::uint8_t idx = uc.ReadValue<std::uint8_t>();
+		// Read all packed bits at once and expand them in place from the end, so unread bytes are never overwritten
+		uc.Read(mask.get(), maskSize);
+		for (std::uint32_t j = maskSize; j-- > 0; ) {
+			std::uint8_t idx = mask[j];
 			for (std::uint32_t k = 0; k < 8; k++) {
 				std::uint32_t pixelIdx = 8 * j + k;
 				mask[pixelIdx] = (((idx >> k) & 0x01) != 0);
@@ -1005,7 +1355,7 @@ namespace Jazz2
 			// Don't load textures in headless mode, only collision masks
 			// Load raw pixels from file
 			std::unique_ptr<std::uint32_t[]> pixels = std::make_unique<std::uint32_t[]>(width * height);
-			ReadImageFromFile(s, (std::uint8_t*)pixels.get(), width, height, channelCount);
+			ReadImageFromFile(bs, (std::uint8_t*)pixels.get(), width, height, channelCount);
 
 			// Then add 1px padding to each tile
 			std::uint32_t tilesPerRow = width / TileSet::DefaultTileSize;
@@ -1150,8 +1500,10 @@ namespace Jazz2
 
 		// Read compressed data
 		std::int32_t compressedSize = s->ReadValue<std::int32_t>();
+		std::int64_t layerChunkDataOffset = s->GetPosition() + compressedSize;
 
-		DeflateStream uc(*s, compressedSize);
+		DeflateStream dc(*s, compressedSize);
+		BufferedStream uc(dc);
 
 		// Read metadata
 		std::uint8_t stringSize = uc.ReadValue<std::uint8_t>();
@@ -1271,6 +1623,13 @@ namespace Jazz2
 		descriptor.EventMap->ReadEvents(uc, descriptor.TileMap, difficulty);
 
 		RETURNF_ASSERT_MSG(uc.IsValid(), "File cannot be decompressed");
+
+		// Layer chunks are stored after compressed data and they are decompressed later only when needed
+		if ((flags & 0x100) == 0x100) {
+			s->Seek(layerChunkDataOffset, SeekOrigin::Begin);
+			descriptor.TileMap->ReadLayerChunkData(*s);
+		}
+
 		return true;
 	}
 
@@ -1310,8 +1669,9 @@ namespace Jazz2
 			return std::nullopt;
 		}
 
-		std::uint64_t signature = s->ReadValue<std::uint64_t>();
-		std::uint8_t fileType = s->ReadValue<std::uint8_t>();
+		BufferedStream bs(*s);
+		std::uint64_t signature = bs.ReadValue<std::uint64_t>();
+		std::uint8_t fileType = bs.ReadValue<std::uint8_t>();
 		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::EpisodeFile) {
 			return std::nullopt;
 		}
@@ -1319,32 +1679,32 @@ namespace Jazz2
 		Episode episode;
 		episode.Name = fs::GetFileNameWithoutExtension(path);
 
-		/*std::uint16_t flags =*/ s->ReadValue<std::uint16_t>();
+		/*std::uint16_t flags =*/ bs.ReadValue<std::uint16_t>();
 
-		std::uint8_t nameLength = s->ReadValue<std::uint8_t>();
+		std::uint8_t nameLength = bs.ReadValue<std::uint8_t>();
 		episode.DisplayName = String(NoInit, nameLength);
-		s->Read(episode.DisplayName.data(), nameLength);
+		bs.Read(episode.DisplayName.data(), nameLength);
 
-		episode.Position = s->ReadValue<std::uint16_t>();
+		episode.Position = bs.ReadValue<std::uint16_t>();
 
-		nameLength = s->ReadValue<std::uint8_t>();
+		nameLength = bs.ReadValue<std::uint8_t>();
 		episode.FirstLevel = String(NoInit, nameLength);
-		s->Read(episode.FirstLevel.data(), nameLength);
+		bs.Read(episode.FirstLevel.data(), nameLength);
 
-		nameLength = s->ReadValue<std::uint8_t>();
+		nameLength = bs.ReadValue<std::uint8_t>();
 		episode.PreviousEpisode = String(NoInit, nameLength);
-		s->Read(episode.PreviousEpisode.data(), nameLength);
+		bs.Read(episode.PreviousEpisode.data(), nameLength);
 
-		nameLength = s->ReadValue<std::uint8_t>();
+		nameLength = bs.ReadValue<std::uint8_t>();
 		episode.NextEpisode = String(NoInit, nameLength);
-		s->Read(episode.NextEpisode.data(), nameLength);
+		bs.Read(episode.NextEpisode.data(), nameLength);
 
 		if (withImages && !_isHeadless) {
-			std::uint16_t titleWidth = s->ReadValue<std::uint16_t>();
-			std::uint16_t titleHeight = s->ReadValue<std::uint16_t>();
+			std::uint16_t titleWidth = bs.ReadValue<std::uint16_t>();
+			std::uint16_t titleHeight = bs.ReadValue<std::uint16_t>();
 			if (titleWidth > 0 && titleHeight > 0) {
 				std::unique_ptr<std::uint32_t[]> pixels = std::make_unique<std::uint32_t[]>(titleWidth * titleHeight);
-				ReadImageFromFile(s, (std::uint8_t*)pixels.get(), titleWidth, titleHeight, 4);
+				ReadImageFromFile(bs, (std::uint8_t*)pixels.get(), titleWidth, titleHeight, 4);
 
 				episode.TitleImage = std::make_unique<Texture>(path.data(), Texture::Format::RGBA8, titleWidth, titleHeight);
 				episode.TitleImage->loadFromTexels((unsigned char*)pixels.get(), 0, 0, titleWidth, titleHeight);
@@ -1352,11 +1712,11 @@ namespace Jazz2
 				episode.TitleImage->setMagFiltering(SamplerFilter::Nearest);
 			}
 
-			std::uint16_t backgroundWidth = s->ReadValue<std::uint16_t>();
-			std::uint16_t backgroundHeight = s->ReadValue<std::uint16_t>();
+			std::uint16_t backgroundWidth = bs.ReadValue<std::uint16_t>();
+			std::uint16_t backgroundHeight = bs.ReadValue<std::uint16_t>();
 			if (backgroundWidth > 0 && backgroundHeight > 0) {
 				std::unique_ptr<std::uint32_t[]> pixels = std::make_unique<std::uint32_t[]>(backgroundWidth * backgroundHeight);
-				ReadImageFromFile(s, (std::uint8_t*)pixels.get(), backgroundWidth, backgroundHeight, 4);
+				ReadImageFromFile(bs, (std::uint8_t*)pixels.get(), backgroundWidth, backgroundHeight, 4);
 
 				episode.BackgroundImage = std::make_unique<Texture>(path.data(), Texture::Format::RGBA8, backgroundWidth, backgroundHeight);
 				episode.BackgroundImage->loadFromTexels((unsigned char*)pixels.get(), 0, 0, backgroundWidth, backgroundHeight);
@@ -1370,6 +1730,7 @@ namespace Jazz2
 
 	std::unique_ptr<AudioStreamPlayer> ContentResolver::GetMusic(const StringView path)
 	{
+#if defined(WITH_AUDIO)
 		// Don't load sounds in headless mode
 		if (_isHeadless) {
 			return nullptr;
@@ -1384,6 +1745,9 @@ namespace Jazz2
 			return nullptr;
 		}
 		return std::make_unique<AudioStreamPlayer>(fullPath);
+#else
+		return nullptr;
+#endif
 	}
 
 	UI::Font* ContentResolver::GetFont(FontType fontType)
@@ -1420,6 +1784,8 @@ namespace Jazz2
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Lighting] = CompileShader("Lighting", Shaders::LightingVs, Shaders::LightingFs);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::BatchedLighting] = CompileShader("BatchedLighting", Shaders::BatchedLightingVs, Shaders::LightingFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Lighting]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedLighting]);
+		_precompiledShaders[(std::int32_t)PrecompiledShader::InstancedLighting] = CompileShader("InstancedLighting", Shaders::InstancedLightingVs, Shaders::LightingFs);
+		_precompiledShaders[(std::int32_t)PrecompiledShader::Lighting]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedLighting]);
 
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Blur] = CompileShader("Blur", Shader::DefaultVertex::SPRITE, Shaders::BlurFs);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Downsample] = CompileShader("Downsample", Shader::DefaultVertex::SPRITE, Shaders::DownsampleFs);
@@ -1437,6 +1803,9 @@ namespace Jazz2
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Tinted] = CompileShader("Tinted", Shader::DefaultVertex::SPRITE, Shaders::TintedFs);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::BatchedTinted] = CompileShader("BatchedTinted", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::TintedFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Tinted]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedTinted]);
+		_precompiledShaders[(std::int32_t)PrecompiledShader::TintedMesh] = CompileShader("TintedMesh", Shader::DefaultVertex::MESHSPRITE, Shaders::TintedFs);
+		_precompiledShaders[(std::int32_t)PrecompiledShader::BatchedTintedMesh] = CompileShader("BatchedTintedMesh", Shader::DefaultVertex::BATCHED_MESHSPRITES, Shaders::TintedFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(std::int32_t)PrecompiledShader::TintedMesh]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedTintedMesh]);
 
 		_precompiledShaders[(std::int32_t)PrecompiledShader::Outline] = CompileShader("Outline", Shader::DefaultVertex::SPRITE, Shaders::OutlineFs);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::BatchedOutline] = CompileShader("BatchedOutline", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::OutlineFs, Shader::Introspection::NoUniformsInBlocks);
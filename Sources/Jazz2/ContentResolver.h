@@ -15,11 +15,19 @@
 #include "../nCine/Graphics/Texture.h"
 #include "../nCine/Graphics/Viewport.h"
 #include "../nCine/Base/HashMap.h"
+#include "../nCine/Base/TimeStamp.h"
+#include "../nCine/Threading/Atomic.h"
+#include "../nCine/Threading/IThreadCommand.h"
+
+#if defined(WITH_COROUTINES)
+#	include <coroutine>
+#endif
 
 #include <Containers/Pair.h>
 #include <Containers/Reference.h>
 #include <Containers/SmallVector.h>
 #include <Containers/StringView.h>
+#include <IO/BufferedStream.h>
 #include <IO/FileSystem.h>
 #include <IO/PakFile.h>
 #include <IO/Stream.h>
@@ -29,6 +37,11 @@ using namespace Death::Containers::Literals;
 using namespace Death::IO;
 using namespace nCine;
 
+namespace nCine
+{
+	class ITextureLoader;
+}
+
 namespace Jazz2
 {
 	namespace Tiles
@@ -45,6 +58,7 @@ namespace Jazz2
 		static constexpr std::uint8_t ConfigFile = 4;
 		static constexpr std::uint8_t StateFile = 5;
 		static constexpr std::uint8_t SfxListFile = 6;
+		static constexpr std::uint8_t CacheManifestFile = 7;
 
 		static constexpr std::int32_t PaletteCount = 256;
 		static constexpr std::int32_t ColorsPerPalette = 256;
@@ -71,8 +85,17 @@ namespace Jazz2
 		void BeginLoading();
 		void EndLoading();
 
-		void PreloadMetadataAsync(const StringView path);
+		/** @brief Starts loading of metadata on a worker thread, returns `true` if it's already loaded and can be requested without waiting */
+		bool PreloadMetadataAsync(const StringView path);
 		Metadata* RequestMetadata(const StringView path);
+		/** @brief Finishes metadata loaded by worker threads, it should be called once per frame on the main thread */
+		void ProcessPendingLoads();
+#if defined(WITH_COROUTINES)
+		/** @brief Resumes @p handle from @ref ProcessPendingLoads() once pending metadata are loaded, unless @p owner expires, returns `false` if they are not pending */
+		bool ResumeWhenMetadataLoaded(const StringView path, std::weak_ptr<void> owner, std::coroutine_handle<> handle);
+#endif
+		/** @brief Returns total number of calls to @ref PreloadMetadataAsync() that returned `false` */
+		std::uint32_t GetPendingPreloadRequests() const;
 		GenericGraphicResource* RequestGraphics(const StringView path, uint16_t paletteOffset);
 
 		std::unique_ptr<Tiles::TileSet> RequestTileSet(const StringView path, uint16_t captionTileId, bool applyPalette, const uint8_t* paletteRemapping = nullptr);
@@ -100,15 +123,123 @@ namespace Jazz2
 			}
 		};
 
+		/** @brief Maximum time in milliseconds spent by uploading textures in @ref ProcessPendingLoads() per frame */
+		static constexpr float MaxUploadTimePerFrame = 2.0f;
+		/** @brief Number of texture rows uploaded at once, so large textures can be split across multiple frames */
+		static constexpr std::int32_t UploadRowsPerStep = 64;
+
 		ContentResolver();
 
 		ContentResolver(const ContentResolver&) = delete;
 		ContentResolver& operator=(const ContentResolver&) = delete;
 
+		struct AnimationDescription
+		{
+			String Path;
+			std::uint16_t PaletteOffset;
+			AnimationLoopMode LoopMode;
+			std::int32_t FrameOffset;
+			std::int32_t FrameCount;
+			float AnimDuration;
+			bool HasFrameRate;
+			bool HasStates;
+			SmallVector<AnimState, 1> States;
+		};
+
+		struct SoundDescription
+		{
+			String Key;
+			SmallVector<String, 1> Paths;
+		};
+
+		/** @brief Parsed metadata file that doesn't reference any other resources yet */
+		struct MetadataDescription
+		{
+			Vector2i BoundingBox;
+			std::size_t AnimationCount;
+			SmallVector<AnimationDescription, 0> Animations;
+			SmallVector<SoundDescription, 0> Sounds;
+		};
+
+		/** @brief Decoded graphics that are not uploaded to GPU and added to the cache yet */
+		struct PendingGraphics
+		{
+			String Path;
+			std::uint16_t PaletteOffset;
+			String TextureName;
+			std::unique_ptr<GenericGraphicResource> Resource;
+			std::unique_ptr<ITextureLoader> TextureLoader;
+			std::unique_ptr<std::uint32_t[]> PixelData;
+			std::uint32_t* Pixels;
+			std::int32_t Width;
+			std::int32_t Height;
+			/** @brief Number of rows already uploaded to the texture */
+			std::int32_t UploadedRows;
+			bool LinearSampling;
+
+			PendingGraphics();
+			~PendingGraphics();
+		};
+
+#if defined(WITH_THREADS)
+#	if defined(WITH_COROUTINES)
+		struct MetadataWaiter
+		{
+			std::weak_ptr<void> Owner;
+			std::coroutine_handle<> Handle;
+		};
+#	endif
+
+		struct PendingMetadata
+		{
+			enum {
+				Queued,
+				Loading,
+				Loaded
+			};
+
+			String Path;
+			Atomic32 State;
+			bool IsValid;
+			MetadataDescription Description;
+			SmallVector<std::unique_ptr<PendingGraphics>, 0> Graphics;
+			/** @brief Number of graphics already uploaded by @ref ProcessPendingLoads() */
+			std::int32_t UploadedGraphics;
+#	if defined(WITH_COROUTINES)
+			SmallVector<MetadataWaiter, 0> Waiters;
+#	endif
+		};
+
+		class LoadMetadataCommand : public IThreadCommand
+		{
+		public:
+			LoadMetadataCommand(std::shared_ptr<PendingMetadata> pending)
+				: _pending(std::move(pending)) {}
+
+			void Execute() override;
+
+		private:
+			std::shared_ptr<PendingMetadata> _pending;
+		};
+#endif
+
 		void InitializePaths();
 
-		GenericGraphicResource* RequestGraphicsAura(const StringView path, uint16_t paletteOffset);
-		static void ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
+		static void MarkAsReferenced(Metadata& metadata);
+		bool ParseMetadata(const StringView path, MetadataDescription& desc);
+		Metadata* BuildMetadata(String&& path, const MetadataDescription& desc);
+		std::unique_ptr<PendingGraphics> LoadGraphics(const StringView path, uint16_t paletteOffset);
+		std::unique_ptr<PendingGraphics> LoadGraphicsAura(const StringView path, uint16_t paletteOffset);
+		/** @brief Uploads next @p maxRows rows of decoded texture, returns `true` if the whole texture is uploaded */
+		bool UploadGraphics(PendingGraphics& pending, std::int32_t maxRows);
+		GenericGraphicResource* FinishGraphics(PendingGraphics& pending);
+#if defined(WITH_THREADS)
+		void LoadPendingMetadata(PendingMetadata& pending);
+		bool UploadPendingGraphics(PendingMetadata& pending, const TimeStamp& frameStart);
+		Metadata* FinishPendingMetadata(HashMap<String, std::shared_ptr<PendingMetadata>>::iterator it);
+		void FinishPendingLoads();
+#endif
+		static void ReadImageFromFile(BufferedStream& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
 		
 		std::unique_ptr<Shader> CompileShader(const char* shaderName, Shader::DefaultVertex vertex, const char* fragment, Shader::Introspection introspection = Shader::Introspection::Enabled);
 		std::unique_ptr<Shader> CompileShader(const char* shaderName, const char* vertex, const char* fragment, Shader::Introspection introspection = Shader::Introspection::Enabled);
@@ -124,6 +255,13 @@ namespace Jazz2
 		HashMap<Reference<String>, std::unique_ptr<Metadata>, FNV1aHashFunc<String>, StringRefEqualTo> _cachedMetadata;
 		HashMap<Pair<String, uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
 		HashMap<String, std::unique_ptr<GenericSoundResource>> _cachedSounds;
+#if defined(WITH_THREADS)
+		HashMap<String, std::shared_ptr<PendingMetadata>> _pendingMetadata;
+#	if defined(WITH_COROUTINES)
+		SmallVector<MetadataWaiter, 0> _metadataWaiters;
+#	endif
+#endif
+		std::uint32_t _pendingPreloadRequests;
 		std::unique_ptr<UI::Font> _fonts[(int32_t)FontType::Count];
 		std::unique_ptr<Shader> _precompiledShaders[(int32_t)PrecompiledShader::Count];
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
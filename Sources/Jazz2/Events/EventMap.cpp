@@ -65,6 +65,11 @@ namespace Jazz2::Events
 
 	void EventMap::RollbackToCheckpoint()
 	{
+#if defined(WITH_COROUTINES)
+		// Tiles of actors that are still activating are rolled back too, so they will be spawned again
+		_pendingActors.clear();
+#endif
+
 		for (std::int32_t y = 0; y < _layoutSize.Y; y++) {
 			for (std::int32_t x = 0; x < _layoutSize.X; x++) {
 				std::int32_t tileID = y * _layoutSize.X + x;
@@ -176,6 +181,18 @@ namespace Jazz2::Events
 	{
 		ZoneScopedC(0x9D5BA3);
 
+#if defined(WITH_COROUTINES)
+		// Actors waiting for their resources are added once their activation finishes
+		for (std::size_t i = 0; i < _pendingActors.size(); ) {
+			if (_pendingActors[i]->GetState(Actors::ActorState::Initialized)) {
+				_levelHandler->AddActor(_pendingActors[i]);
+				_pendingActors.erase(_pendingActors.begin() + i);
+			} else {
+				i++;
+			}
+		}
+#endif
+
 		std::int32_t x1 = std::max(0, tx1);
 		std::int32_t x2 = std::min(_layoutSize.X - 1, tx2);
 		std::int32_t y1 = std::max(0, ty1);
@@ -185,6 +202,12 @@ namespace Jazz2::Events
 			for (std::int32_t y = y1; y <= y2; y++) {
 				auto& tile = _eventLayout[x + y * _layoutSize.X];
 				if (!tile.IsEventActive && tile.Event != EventType::Empty) {
+					if (allowAsync && tile.Event != EventType::AreaWeather && tile.Event != EventType::Generator &&
+						!_levelHandler->EventSpawner()->PreloadEvent(tile.Event, tile.EventParams)) {
+						// Resources are still loading in background, try it again later
+						continue;
+					}
+
 					tile.IsEventActive = true;
 
 					if (tile.Event == EventType::AreaWeather) {
@@ -197,6 +220,12 @@ namespace Jazz2::Events
 
 						std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
 						if (actor != nullptr) {
+#if defined(WITH_COROUTINES)
+							if (!actor->GetState(Actors::ActorState::Initialized)) {
+								_pendingActors.push_back(std::move(actor));
+								continue;
+							}
+#endif
 							_levelHandler->AddActor(actor);
 						}
 					}
@@ -289,7 +318,7 @@ namespace Jazz2::Events
 		return Vector2f(-1.0f, -1.0f);
 	}
 
-	void EventMap::ReadEvents(Stream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty)
+	void EventMap::ReadEvents(BufferedStream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty)
 	{
 		_eventLayout.resize(_layoutSize.X * _layoutSize.Y);
 		_eventLayoutForRollback.resize(_layoutSize.X * _layoutSize.Y);
@@ -4,6 +4,7 @@
 #include "../GameDifficulty.h"
 #include "../PitType.h"
 
+#include <IO/BufferedStream.h>
 #include <IO/Stream.h>
 
 using namespace Death::IO;
@@ -51,7 +52,7 @@ namespace Jazz2::Events
 		std::int32_t GetWarpByPosition(float x, float y);
 		Vector2f GetWarpTarget(std::uint32_t id);
 
-		void ReadEvents(Stream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty);
+		void ReadEvents(BufferedStream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty);
 		void AddWarpTarget(std::uint16_t id, std::int32_t x, std::int32_t y);
 		void AddSpawnPosition(std::uint8_t typeMask, std::int32_t x, std::int32_t y);
 
@@ -88,5 +89,8 @@ namespace Jazz2::Events
 		SmallVector<GeneratorInfo, 0> _generators;
 		SmallVector<SpawnPoint, 0> _spawnPoints;
 		SmallVector<WarpTarget, 0> _warpTargets;
+#if defined(WITH_COROUTINES)
+		SmallVector<std::shared_ptr<Actors::ActorBase>, 0> _pendingActors;
+#endif
 	};
 }
\ No newline at end of file
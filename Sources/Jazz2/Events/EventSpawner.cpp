@@ -1,4 +1,5 @@
 ﻿#include "EventSpawner.h"
+#include "../ContentResolver.h"
 
 #include "../Actors/Collectibles/AmmoCollectible.h"
 #include "../Actors/Collectibles/CarrotCollectible.h"
@@ -220,19 +221,28 @@ namespace Jazz2::Events
 	{
 		_spawnableEvents[type] = { [](const ActorActivationDetails& details) -> std::shared_ptr<ActorBase> {
 			std::shared_ptr<ActorBase> actor = std::make_shared<T>();
+#if defined(WITH_COROUTINES)
+			// Asynchronous activation can be suspended while resources are loading, so the task must be kept alive
+			actor->_activationTask.emplace(actor->OnActivated(details));
+#else
 			actor->OnActivated(details);
+#endif
 			return actor;
 		}, T::Preload };
 	}
 
-	void EventSpawner::PreloadEvent(EventType type, std::uint8_t* spawnParams)
+	bool EventSpawner::PreloadEvent(EventType type, std::uint8_t* spawnParams)
 	{
 		auto it = _spawnableEvents.find(type);
 		if (it == _spawnableEvents.end() || it->second.PreloadFunction == nullptr) {
-			return;
+			return true;
 		}
 
+		// Preload functions don't return anything, so check whether any of the requests had to be deferred
+		auto& resolver = ContentResolver::Get();
+		std::uint32_t prevPendingRequests = resolver.GetPendingPreloadRequests();
 		it->second.PreloadFunction(ActorActivationDetails(_levelHandler, {}, spawnParams));
+		return (resolver.GetPendingPreloadRequests() == prevPendingRequests);
 	}
 
 	std::shared_ptr<ActorBase> EventSpawner::SpawnEvent(EventType type, std::uint8_t* spawnParams, ActorState flags, std::int32_t x, std::int32_t y, std::int32_t z)
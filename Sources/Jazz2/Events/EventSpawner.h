@@ -17,7 +17,8 @@ namespace Jazz2::Events
 
 		EventSpawner(ILevelHandler* levelHandler);
 
-		void PreloadEvent(EventType type, std::uint8_t* spawnParams);
+		/** @brief Preloads resources of a given event, returns `true` if all of them are already loaded */
+		bool PreloadEvent(EventType type, std::uint8_t* spawnParams);
 		std::shared_ptr<Actors::ActorBase> SpawnEvent(EventType type, std::uint8_t* spawnParams, Actors::ActorState flags, std::int32_t x, std::int32_t y, std::int32_t z);
 		std::shared_ptr<Actors::ActorBase> SpawnEvent(EventType type, std::uint8_t* spawnParams, Actors::ActorState flags, const Vector3i& pos);
 
@@ -7,6 +7,7 @@
 
 #include "../nCine/Audio/AudioBufferPlayer.h"
 
+#include <Base/FunctionRef.h>
 #include <Base/TypeInfo.h>
 
 namespace Death::IO
@@ -15,6 +16,7 @@ namespace Death::IO
 }
 
 using namespace Death::IO;
+using Death::FunctionRef;
 
 namespace Jazz2
 {
@@ -79,9 +81,33 @@ namespace Jazz2
 			return IsPositionEmpty(self, aabb, params, &collider);
 		}
 
-		virtual void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) = 0;
-		virtual void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) = 0;
-		virtual void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
+
+		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result)
+		{
+			FindCollisionActorsByAABB(self, aabb, [&result](Actors::ActorBase* actor) {
+				result.push_back(actor);
+				return true;
+			});
+		}
+
+		void FindCollisionActorsByRadius(float x, float y, float radius, SmallVectorImpl<Actors::ActorBase*>& result)
+		{
+			FindCollisionActorsByRadius(x, y, radius, [&result](Actors::ActorBase* actor) {
+				result.push_back(actor);
+				return true;
+			});
+		}
+
+		void GetCollidingPlayers(const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result)
+		{
+			GetCollidingPlayers(aabb, [&result](Actors::ActorBase* actor) {
+				result.push_back(actor);
+				return true;
+			});
+		}
 
 		virtual void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, std::uint8_t* eventParams) = 0;
 		virtual void BeginLevelChange(ExitType exitType, const StringView nextLevel) = 0;
@@ -60,9 +60,11 @@ namespace Jazz2
 
 	LevelHandler::~LevelHandler()
 	{
+#if !defined(DEDICATED_SERVER)
 		// Remove nodes from UpscaleRenderPass
 		_combineRenderer->setParent(nullptr);
 		_hud->setParent(nullptr);
+#endif
 
 		TracyPlot("Actors", 0LL);
 	}
@@ -80,9 +82,14 @@ namespace Jazz2
 		auto& resolver = ContentResolver::Get();
 		resolver.BeginLoading();
 
+#if defined(DEDICATED_SERVER)
+		// There are no viewports on dedicated server, so the scene is updated directly by the application
+		_rootNode = std::make_unique<SceneNode>(&theApplication().rootNode());
+#else
 		_noiseTexture = resolver.GetNoiseTexture();
 
 		_rootNode = std::make_unique<SceneNode>();
+#endif
 		_rootNode->setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 
 		LevelDescriptor descriptor;
@@ -97,9 +104,11 @@ namespace Jazz2
 		OnInitialized();
 		resolver.EndLoading();
 
+#if !defined(DEDICATED_SERVER)
 		if ((levelInit.LastExitType & ExitType::FastTransition) != ExitType::FastTransition) {
 			_hud->BeginFadeIn();
 		}
+#endif
 
 		return true;
 	}
@@ -126,9 +135,14 @@ namespace Jazz2
 		auto& resolver = ContentResolver::Get();
 		resolver.BeginLoading();
 
+#if defined(DEDICATED_SERVER)
+		// There are no viewports on dedicated server, so the scene is updated directly by the application
+		_rootNode = std::make_unique<SceneNode>(&theApplication().rootNode());
+#else
 		_noiseTexture = resolver.GetNoiseTexture();
 
 		_rootNode = std::make_unique<SceneNode>();
+#endif
 		_rootNode->setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 
 		LevelDescriptor descriptor;
@@ -144,7 +158,7 @@ namespace Jazz2
 		_weatherType = (WeatherType)src.ReadValue<std::uint8_t>();
 		_weatherIntensity = src.ReadValue<std::uint8_t>();
 
-		_tileMap->InitializeFromStream(src);
+		_tileMap->InitializeFromStream(src, (flags & 0x04) == 0);
 		_eventMap->InitializeFromStream(src);
 
 		std::uint32_t playerCount = src.ReadValue<std::uint8_t>();
@@ -162,7 +176,9 @@ namespace Jazz2
 		OnInitialized();
 		resolver.EndLoading();
 
+#if !defined(DEDICATED_SERVER)
 		_hud->BeginFadeIn();
+#endif
 
 		// Set it at the end, so ambient light transition is skipped
 		_elapsedFrames = _checkpointFrames;
@@ -181,7 +197,9 @@ namespace Jazz2
 		_commonResources = resolver.RequestMetadata("Common/Scenery"_s);
 		resolver.PreloadMetadataAsync("Common/Explosions"_s);
 
+#if !defined(DEDICATED_SERVER)
 		_hud = std::make_unique<UI::HUD>(this);
+#endif
 
 		_eventMap->PreloadEventsAsync();
 
@@ -233,11 +251,13 @@ namespace Jazz2
 	{
 		ZoneScopedC(0x4876AF);
 
+#if !defined(DEDICATED_SERVER)
 		if (!descriptor.DisplayName.empty()) {
 			theApplication().gfxDevice().setWindowTitle(String(NCINE_APP_NAME " - " + descriptor.DisplayName));
 		} else {
 			theApplication().gfxDevice().setWindowTitle(NCINE_APP_NAME);
 		}
+#endif
 
 		_defaultNextLevel = std::move(descriptor.NextLevel);
 		_defaultSecretLevel = std::move(descriptor.SecretLevel);
@@ -330,19 +350,21 @@ namespace Jazz2
 
 		float timeMult = theApplication().timeMult();
 
+#if !defined(DEDICATED_SERVER)
 		if (_pauseMenu == nullptr) {
 			UpdatePressedActions();
 
 			if (PlayerActionHit(0, PlayerActions::Menu) && _nextLevelType == ExitType::None) {
 				PauseGame();
 			}
-#if defined(DEATH_DEBUG)
+#	if defined(DEATH_DEBUG)
 			if (PreferencesCache::AllowCheats && PlayerActionPressed(0, PlayerActions::ChangeWeapon) && PlayerActionHit(0, PlayerActions::Jump)) {
 				_cheatsUsed = true;
 				BeginLevelChange(ExitType::Warp | ExitType::FastTransition, nullptr);
 			}
-#endif
+#	endif
 		}
+#endif
 
 #if defined(WITH_AUDIO)
 		// Destroy stopped players and resume music after Sugar Rush
@@ -362,6 +384,8 @@ namespace Jazz2
 		}
 #endif
 
+		ContentResolver::Get().ProcessPendingLoads();
+
 		if (!IsPausable() || _pauseMenu == nullptr) {
 			if (_nextLevelType != ExitType::None) {
 				_nextLevelTime -= timeMult;
@@ -370,6 +394,7 @@ namespace Jazz2
 
 			ProcessEvents(timeMult);
 
+#if !defined(DEDICATED_SERVER)
 			// Weather
 			if (_weatherType != WeatherType::None) {
 				int32_t weatherIntensity = std::max((int32_t)(_weatherIntensity * timeMult), 1);
@@ -468,6 +493,7 @@ namespace Jazz2
 					}
 				}
 			}
+#endif
 
 			// Active Boss
 			if (_activeBoss != nullptr && _activeBoss->GetHealth() <= 0) {
@@ -502,12 +528,16 @@ namespace Jazz2
 				}
 			}
 
+#if !defined(DEDICATED_SERVER)
 			UpdateCamera(timeMult);
+#endif
 
 			_elapsedFrames += timeMult;
 		}
 
+#if !defined(DEDICATED_SERVER)
 		_lightingView->setClearColor(_ambientColor.W, 0.0f, 0.0f, 1.0f);
+#endif
 
 #if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
 		if (PreferencesCache::ShowPerformanceMetrics) {
@@ -590,18 +620,22 @@ namespace Jazz2
 			? PrecompiledShader::CombineWithWaterLow
 			: PrecompiledShader::CombineWithWater);
 
+		// Lights are smooth gradients, so the lighting buffer can be rendered at half resolution and upscaled with linear filtering
+		int32_t lightingWidth = (PreferencesCache::LowLightingQuality ? w / 2 : w);
+		int32_t lightingHeight = (PreferencesCache::LowLightingQuality ? h / 2 : h);
+
 		if (notInitialized) {
-			_lightingBuffer = std::make_unique<Texture>(nullptr, Texture::Format::RG8, w, h);
+			_lightingBuffer = std::make_unique<Texture>(nullptr, Texture::Format::RG8, lightingWidth, lightingHeight);
 			_lightingView = std::make_unique<Viewport>(_lightingBuffer.get(), Viewport::DepthStencilFormat::None);
 			_lightingView->setRootNode(_lightingRenderer.get());
 			_lightingView->setCamera(_camera.get());
 		} else {
 			_lightingView->removeAllTextures();
-			_lightingBuffer->init(nullptr, Texture::Format::RG8, w, h);
+			_lightingBuffer->init(nullptr, Texture::Format::RG8, lightingWidth, lightingHeight);
 			_lightingView->setTexture(_lightingBuffer.get());
 		}
 
-		_lightingBuffer->setMagFiltering(SamplerFilter::Nearest);
+		_lightingBuffer->setMagFiltering(PreferencesCache::LowLightingQuality ? SamplerFilter::Linear : SamplerFilter::Nearest);
 		_lightingBuffer->setWrap(SamplerWrapping::ClampToEdge);
 
 		_downsamplePass.Initialize(_viewTexture.get(), w / 2, h / 2, Vector2f::Zero);
@@ -750,11 +784,16 @@ namespace Jazz2
 			actor->CollisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
 		}
 
+		if (actor->GetState(Actors::ActorState::HasStaticLights) && _lightingRenderer != nullptr) {
+			_lightingRenderer->InvalidateStaticLights();
+		}
+
 		_actors.emplace_back(actor);
 	}
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(Actors::ActorBase* self, const StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
 	{
+#if defined(WITH_AUDIO)
 		auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(buffer));
 		player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
 		player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
@@ -769,10 +808,14 @@ namespace Jazz2
 
 		player->play();
 		return player;
+#else
+		return nullptr;
+#endif
 	}
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlayCommonSfx(const StringView identifier, const Vector3f& pos, float gain, float pitch)
 	{
+#if defined(WITH_AUDIO)
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _commonResources->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
@@ -792,6 +835,9 @@ namespace Jazz2
 		} else {
 			return nullptr;
 		}
+#else
+		return nullptr;
+#endif
 	}
 
 	void LevelHandler::WarpCameraToTarget(Actors::ActorBase* actor, bool fast)
@@ -845,18 +891,20 @@ namespace Jazz2
 
 		// Check for solid objects
 		if (self->GetState(Actors::ActorState::CollideWithSolidObjects)) {
-			Actors::ActorBase* colliderActor = nullptr;
-			FindCollisionActorsByAABB(self, aabb, [self, &colliderActor, &params](Actors::ActorBase* actor) -> bool {
+			SmallVector<Actors::ActorBase*, 16> candidates;
+			FindCollisionActorsByAABB(self, aabb, candidates);
+
+			for (Actors::ActorBase* actor : candidates) {
 				if ((actor->GetState() & (Actors::ActorState::IsSolidObject | Actors::ActorState::IsDestroyed)) != Actors::ActorState::IsSolidObject) {
-					return true;
+					continue;
 				}
 				if (self->GetState(Actors::ActorState::ExcludeSimilar) && actor->GetState(Actors::ActorState::ExcludeSimilar)) {
 					// If both objects have ExcludeSimilar, ignore it
-					return true;
+					continue;
 				}
 				if (self->GetState(Actors::ActorState::CollideWithSolidObjectsBelow) &&
 					self->AABBInner.B > (actor->AABBInner.T + actor->AABBInner.B) * 0.5f) {
-					return true;
+					continue;
 				}
 
 				auto* solidObject = runtime_cast<Actors::SolidObjectBase*>(actor);
@@ -864,27 +912,23 @@ namespace Jazz2
 					std::shared_ptr selfShared = self->shared_from_this();
 					std::shared_ptr actorShared = actor->shared_from_this();
 					if (!selfShared->OnHandleCollision(actorShared) && !actorShared->OnHandleCollision(selfShared)) {
-						colliderActor = actor;
-						return false;
+						*collider = actor;
+						break;
 					}
 				}
-
-				return true;
-			});
-
-			*collider = colliderActor;
+			}
 		}
 
 		return (*collider == nullptr);
 	}
 
-	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		struct QueryHelper {
 			const LevelHandler* Handler;
 			const Actors::ActorBase* Self;
 			const AABBf& AABB;
-			const std::function<bool(Actors::ActorBase*)>& Callback;
+			FunctionRef<bool(Actors::ActorBase*)> Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
@@ -902,7 +946,7 @@ namespace Jazz2
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		AABBf aabb = AABBf(x - radius, y - radius, x + radius, y + radius);
 		float radiusSquared = (radius * radius);
@@ -911,7 +955,7 @@ namespace Jazz2
 			const LevelHandler* Handler;
 			const float x, y;
 			const float RadiusSquared;
-			const std::function<bool(Actors::ActorBase*)>& Callback;
+			FunctionRef<bool(Actors::ActorBase*)> Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
@@ -941,7 +985,7 @@ namespace Jazz2
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback)
+	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		for (auto& player : _players) {
 			if (aabb.Overlaps(player->AABB)) {
@@ -1146,17 +1190,23 @@ namespace Jazz2
 
 	void LevelHandler::ShowLevelText(const StringView text)
 	{
-		_hud->ShowLevelText(text);
+		if (_hud != nullptr) {
+			_hud->ShowLevelText(text);
+		}
 	}
 
 	void LevelHandler::ShowCoins(Actors::Player* player, std::int32_t count)
 	{
-		_hud->ShowCoins(count);
+		if (_hud != nullptr) {
+			_hud->ShowCoins(count);
+		}
 	}
 
 	void LevelHandler::ShowGems(Actors::Player* player, std::int32_t count)
 	{
-		_hud->ShowGems(count);
+		if (_hud != nullptr) {
+			_hud->ShowGems(count);
+		}
 	}
 
 	StringView LevelHandler::GetLevelText(uint32_t textId, int32_t index, uint32_t delimiter)
@@ -1277,6 +1327,7 @@ namespace Jazz2
 		std::uint8_t flags = 0;
 		if (_isReforged) flags |= 0x01;
 		if (_cheatsUsed) flags |= 0x02;
+		flags |= 0x04;	// Tile map contains only modified tiles
 		dest.WriteValue<std::uint8_t>(flags);
 
 		dest.WriteValue<std::uint8_t>((std::uint8_t)_episodeName.size());
@@ -1376,7 +1427,8 @@ namespace Jazz2
 
 			for (std::size_t i = 0; i < playerZones.size(); i += 2) {
 				const auto& activationZone = playerZones[i];
-				_eventMap->ActivateEvents(activationZone.L, activationZone.T, activationZone.R, activationZone.B, true);
+				// Events near player spawn are activated synchronously, before the checkpoint is created
+				_eventMap->ActivateEvents(activationZone.L, activationZone.T, activationZone.R, activationZone.B, _checkpointCreated);
 			}
 
 			if (!_checkpointCreated) {
@@ -1453,6 +1505,9 @@ namespace Jazz2
 					_collisions.DestroyProxy(actor->CollisionProxyID);
 					actor->CollisionProxyID = Collisions::NullNode;
 				}
+				if (actor->GetState(Actors::ActorState::HasStaticLights) && _lightingRenderer != nullptr) {
+					_lightingRenderer->InvalidateStaticLights();
+				}
 				it = _actors.erase(it);
 				continue;
 			}
@@ -1625,6 +1680,26 @@ namespace Jazz2
 		device.updateListener(Vector3f(_cameraPos, 0.0f), Vector3f(focusSpeed, 0.0f));
 	}
 
+#if defined(RENDER_BENCHMARK)
+	void LevelHandler::MoveCameraForBenchmark(const Vector2f& pos)
+	{
+		// Players are moved too, so actors are activated and deactivated along the path
+		for (auto* player : _players) {
+			player->SetState(Actors::ActorState::ApplyGravitation | Actors::ActorState::CollideWithTileset | Actors::ActorState::CollideWithSolidObjects, false);
+			player->SetState(Actors::ActorState::IsInvulnerable, true);
+			player->_speed = Vector2f::Zero;
+			player->MoveInstantly(pos, Actors::MoveType::Absolute | Actors::MoveType::Force);
+		}
+
+		_cameraPos = Vector2f(std::floor(pos.X), std::floor(pos.Y));
+		_cameraLastPos = _cameraPos;
+		_cameraDistanceFactor = Vector2f::Zero;
+
+		Vector2i halfView = _view->size() / 2;
+		_camera->setView(_cameraPos - halfView.As<float>(), 0.0f, 1.0f);
+	}
+#endif
+
 	void LevelHandler::LimitCameraView(int left, int width)
 	{
 		_levelBounds.X = left;
@@ -1639,7 +1714,11 @@ namespace Jazz2
 			_viewBoundsTarget = _viewBounds;
 		} else {
 			Rectf bounds = _levelBounds.As<float>();
+#if defined(DEDICATED_SERVER)
+			float viewWidth = (float)DefaultWidth;
+#else
 			float viewWidth = (float)_view->size().X;
+#endif
 			if (bounds.W < viewWidth) {
 				bounds.X -= (viewWidth - bounds.W);
 				bounds.W = viewWidth;
@@ -1915,26 +1994,59 @@ namespace Jazz2
 		_renderCommandsCount = 0;
 		_emittedLightsCache.clear();
 
-		// Collect all active light emitters
 		std::size_t actorsCount = _owner->_actors.size();
+
+		// Static lights are collected again only if an actor with static lights was added or removed
+		if (_staticLightsDirty) {
+			_staticLightsDirty = false;
+			_staticLightsCache.clear();
+			for (std::size_t i = 0; i < actorsCount; i++) {
+				Actors::ActorBase* actor = _owner->_actors[i].get();
+				if (actor->GetState(Actors::ActorState::HasStaticLights)) {
+					actor->OnEmitLights(_staticLightsCache);
+				}
+			}
+		}
+
+		// Collect all other active light emitters
 		for (std::size_t i = 0; i < actorsCount; i++) {
-			_owner->_actors[i]->OnEmitLights(_emittedLightsCache);
+			Actors::ActorBase* actor = _owner->_actors[i].get();
+			if (!actor->GetState(Actors::ActorState::HasStaticLights)) {
+				actor->OnEmitLights(_emittedLightsCache);
+			}
 		}
 
-		for (auto& light : _emittedLightsCache) {
-			auto command = RentRenderCommand();
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(light.RadiusFar * 2.0f, light.RadiusFar * 2.0f);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(light.Intensity, light.Brightness, 0.0f, 0.0f);
-			command->setTransformation(Matrix4x4f::Translation(light.Pos.X, light.Pos.Y, 0));
+		Vector2f viewPos = _owner->_camera->viewValues().position;
+		Vector2i viewSize = _owner->_viewTexture->size();
+		AABBf viewBounds(viewPos.X, viewPos.Y, viewPos.X + viewSize.X, viewPos.Y + viewSize.Y);
 
-			renderQueue.addCommand(command);
+		for (auto& light : _staticLightsCache) {
+			EmitLight(renderQueue, light, viewBounds);
+		}
+		for (auto& light : _emittedLightsCache) {
+			EmitLight(renderQueue, light, viewBounds);
 		}
 
 		return true;
 	}
 
+	void LevelHandler::LightingRenderer::EmitLight(RenderQueue& renderQueue, const LightEmitter& light, const AABBf& viewBounds)
+	{
+		// Lights outside of the view are skipped, so they don't add any vertices or instances to the batch
+		AABBf lightBounds(light.Pos.X - light.RadiusFar, light.Pos.Y - light.RadiusFar, light.Pos.X + light.RadiusFar, light.Pos.Y + light.RadiusFar);
+		if (!lightBounds.Overlaps(viewBounds)) {
+			return;
+		}
+
+		auto command = RentRenderCommand();
+		command->setInstanceTexRect(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
+		command->setInstanceSpriteSize(light.RadiusFar * 2.0f, light.RadiusFar * 2.0f);
+		command->setInstanceColor(light.Intensity, light.Brightness, 0.0f, 0.0f);
+		command->setTransformation(Matrix4x4f::Translation(light.Pos.X, light.Pos.Y, 0));
+
+		renderQueue.addCommand(command);
+	}
+
 	RenderCommand* LevelHandler::LightingRenderer::RentRenderCommand()
 	{
 		if (_renderCommandsCount < _renderCommands.size()) {
@@ -2007,10 +2119,9 @@ namespace Jazz2
 	{
 		Vector2i size = _target->size();
 
-		auto* instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(static_cast<float>(size.X), static_cast<float>(size.Y));
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		_renderCommand.setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		_renderCommand.setInstanceSpriteSize(static_cast<float>(size.X), static_cast<float>(size.Y));
+		_renderCommand.setInstanceColor(Colorf::White.Data());
 
 		_renderCommand.material().uniform("uPixelOffset")->setFloatValue(1.0f / size.X, 1.0f / size.Y);
 		if (!_downsampleOnly) {
@@ -2094,10 +2205,9 @@ namespace Jazz2
 			command.material().setTexture(4, *_owner->_noiseTexture);
 		}
 
-		auto* instanceBlock = command.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_size.X, _size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		command.setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command.setInstanceSpriteSize(_size.X, _size.Y);
+		command.setInstanceColor(Colorf::White.Data());
 
 		command.material().uniform("uAmbientColor")->setFloatVector(_owner->_ambientColor.Data());
 		command.material().uniform("uTime")->setFloatValue(_owner->_elapsedFrames * 0.0018f);
@@ -123,9 +123,12 @@ namespace Jazz2
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(Actors::ActorBase* actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, Tiles::TileCollisionParams& params, Actors::ActorBase** collider) override;
-		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		using ILevelHandler::FindCollisionActorsByAABB;
+		using ILevelHandler::FindCollisionActorsByRadius;
+		using ILevelHandler::GetCollidingPlayers;
 
 		void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, uint8_t* eventParams) override;
 		void BeginLevelChange(ExitType exitType, const StringView nextLevel) override;
@@ -161,6 +164,11 @@ namespace Jazz2
 
 		Vector2i GetViewSize() const override { return _view->size(); }
 
+#if defined(RENDER_BENCHMARK)
+		/** @brief Moves the camera and all players to a given position, players no longer interact with tiles and can't be hurt */
+		void MoveCameraForBenchmark(const Vector2f& pos);
+#endif
+
 		virtual void AttachComponents(LevelDescriptor&& descriptor);
 		virtual void SpawnPlayers(const LevelInitialization& levelInit);
 
@@ -171,7 +179,7 @@ namespace Jazz2
 		{
 		public:
 			LightingRenderer(LevelHandler* owner)
-				: _owner(owner), _renderCommandsCount(0)
+				: _owner(owner), _renderCommandsCount(0), _staticLightsDirty(true)
 			{
 				_emittedLightsCache.reserve(32);
 				setVisitOrderState(SceneNode::VisitOrderState::Disabled);
@@ -179,12 +187,19 @@ namespace Jazz2
 
 			bool OnDraw(RenderQueue& renderQueue) override;
 
+			void InvalidateStaticLights() {
+				_staticLightsDirty = true;
+			}
+
 		private:
 			LevelHandler* _owner;
 			SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 			int32_t _renderCommandsCount;
 			SmallVector<LightEmitter, 0> _emittedLightsCache;
+			SmallVector<LightEmitter, 0> _staticLightsCache;
+			bool _staticLightsDirty;
 
+			void EmitLight(RenderQueue& renderQueue, const LightEmitter& light, const AABBf& viewBounds);
 			RenderCommand* RentRenderCommand();
 		};
 
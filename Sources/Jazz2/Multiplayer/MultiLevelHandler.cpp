@@ -53,7 +53,8 @@ namespace Jazz2::Multiplayer
 {
 	MultiLevelHandler::MultiLevelHandler(IRootController* root, NetworkManager* networkManager)
 		: LevelHandler(root), _gameMode(MultiplayerGameMode::Unknown), _networkManager(networkManager), _updateTimeLeft(1.0f),
-			_initialUpdateSent(false), _lastSpawnedActorId(-1), _seqNum(0), _seqNumWarped(0), _suppressRemoting(false),
+			_initialUpdateSent(false), _lastSpawnedActorId(-1), _seqNum(0), _seqNumWarped(0), _snapshotSeqNum(0), _serverTimeOffset(INT64_MAX),
+			_keyPressSeqNum(0), _keyPressAckedSeqNum(0), _suppressRemoting(false),
 			_ignorePackets(false)
 	{
 		_isServer = (networkManager->GetState() == NetworkState::Listening);
@@ -122,11 +123,8 @@ namespace Jazz2::Multiplayer
 		LevelHandler::OnBeginFrame();
 
 		if ((_pressedActions & 0xffffffffu) != ((_pressedActions >> 32) & 0xffffffffu)) {
-			MemoryStream packet(9);
-			packet.WriteValue<std::uint8_t>((std::uint8_t)ClientPacketType::PlayerKeyPress);
-			packet.WriteVariableUint32(_lastSpawnedActorId);
-			packet.WriteVariableUint32((std::uint32_t)(_pressedActions & 0xffffffffu));
-			_networkManager->SendToPeer(nullptr, NetworkChannel::UnreliableUpdates, packet.GetBuffer(), packet.GetSize());
+			_keyPressSeqNum++;
+			SendPlayerKeyPress();
 		}
 	}
 
@@ -155,94 +153,32 @@ namespace Jazz2::Multiplayer
 			}
 
 			if (_isServer) {
-				std::uint32_t actorCount = (std::uint32_t)(_players.size() + _remotingActors.size());
-
-				MemoryStream packet(5 + actorCount * 19);
-				packet.WriteValue<std::uint8_t>((std::uint8_t)ServerPacketType::UpdateAllActors);
-				packet.WriteVariableUint32(actorCount);
+				// Quantize all actors only once, each peer then receives only the subset near its player
+				SmallVector<std::pair<std::uint32_t, ActorSnapshot>, 0> actors;
+				actors.reserve(_players.size() + _remotingActors.size());
 
 				for (Actors::Player* player : _players) {
-					/*Vector2f pos;
-					auto it = _playerStates.find(player->_playerIndex);
-					if (it != _playerStates.end()) {
-						// Remote players
-						pos = player->_pos;
-
-						// TODO: This should be WarpUpdatesLeft
-						if (it->second.WarpTimeLeft > 0.0f) {
-							it->second.WarpTimeLeft -= timeMult;
-							if (it->second.WarpTimeLeft <= 0.0f) {
-								it->second.WarpTimeLeft = 0.0f;
-								LOGW("Player warped without permission (possible cheating attempt)");
-							}
-						} else if (it->second.WarpTimeLeft < 0.0f) {
-							it->second.WarpTimeLeft += timeMult;
-							if (it->second.WarpTimeLeft >= 0.0f) {
-								it->second.WarpTimeLeft = 0.0f;
-								LOGW("Player failed to warp in time (possible cheating attempt)");
-							}
-						}
-					} else {
-						// Local players
-						pos = player->_pos;
-					}*/
-					Vector2f pos = player->_pos;
-
-					packet.WriteVariableUint32(player->_playerIndex);
-					packet.WriteValue<std::int32_t>((std::int32_t)(pos.X * 512.0f));
-					packet.WriteValue<std::int32_t>((std::int32_t)(pos.Y * 512.0f));
-					packet.WriteVariableUint32((std::uint32_t)(player->_currentTransition != nullptr ? player->_currentTransition->State : player->_currentAnimation->State));
-
-					float rotation = player->_renderer.rotation();
-					if (rotation < 0.0f) rotation += fRadAngle360;
-					packet.WriteValue<std::uint8_t>((std::uint8_t)(rotation * 255.0f / fRadAngle360));
-
-					std::uint8_t flags = 0;
-					if (player->IsFacingLeft()) {
-						flags |= 0x01;
-					}
-					if (player->_renderer.isDrawEnabled()) {
-						flags |= 0x02;
-					}
-					if (player->_renderer.AnimPaused) {
-						flags |= 0x04;
-					}
-					packet.WriteValue<std::uint8_t>(flags);
-
-					Actors::ActorRendererType rendererType = player->_renderer.GetRendererType();
-					packet.WriteValue<std::uint8_t>((std::uint8_t)rendererType);
+					actors.emplace_back((std::uint32_t)player->_playerIndex, CreateActorSnapshot(player));
 				}
-
 				for (const auto& [remotingActor, remotingActorId] : _remotingActors) {
-					packet.WriteVariableUint32(remotingActorId);
-					packet.WriteValue<std::int32_t>((std::int32_t)(remotingActor->_pos.X * 512.0f));
-					packet.WriteValue<std::int32_t>((std::int32_t)(remotingActor->_pos.Y * 512.0f));
-					packet.WriteVariableUint32((std::uint32_t)(remotingActor->_currentTransition != nullptr ? remotingActor->_currentTransition->State : (remotingActor->_currentAnimation != nullptr ? remotingActor->_currentAnimation->State : AnimState::Idle)));
-					
-					float rotation = remotingActor->_renderer.rotation();
-					if (rotation < 0.0f) rotation += fRadAngle360;
-					packet.WriteValue<std::uint8_t>((std::uint8_t)(rotation * 255.0f / fRadAngle360));
+					actors.emplace_back(remotingActorId, CreateActorSnapshot(remotingActor));
+				}
 
-					std::uint8_t flags = 0;
-					if (remotingActor->IsFacingLeft()) {
-						flags |= 0x01;
-					}
-					if (remotingActor->_renderer.isDrawEnabled()) {
-						flags |= 0x02;
-					}
-					if (remotingActor->_renderer.AnimPaused) {
-						flags |= 0x04;
-					}
-					packet.WriteValue<std::uint8_t>(flags);
+				_snapshotSeqNum++;
 
-					Actors::ActorRendererType rendererType = remotingActor->_renderer.GetRendererType();
-					packet.WriteValue<std::uint8_t>((std::uint8_t)rendererType);
+				for (auto& [peer, peerDesc] : _peerDesc) {
+					if (peerDesc.State == PeerState::LevelSynchronized) {
+						SendActorSnapshot(peer, peerDesc, arrayView(actors.data(), actors.size()));
+					}
 				}
 
-				_networkManager->SendToAll(NetworkChannel::UnreliableUpdates, packet.GetBuffer(), packet.GetSize());
-
 				SynchronizePeers();
 			} else {
+				if (_keyPressAckedSeqNum != _keyPressSeqNum) {
+					// Key presses are sent unreliably, so the last state is repeated until the server processes it
+					SendPlayerKeyPress();
+				}
+
 				if (!_players.empty()) {
 					_seqNum++;
 
@@ -498,17 +434,17 @@ namespace Jazz2::Multiplayer
 		return LevelHandler::IsPositionEmpty(self, aabb, params, collider);
 	}
 
-	void MultiLevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback)
+	void MultiLevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		LevelHandler::FindCollisionActorsByAABB(self, aabb, callback);
 	}
 
-	void MultiLevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback)
+	void MultiLevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		LevelHandler::FindCollisionActorsByRadius(x, y, radius, callback);
 	}
 
-	void MultiLevelHandler::GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback)
+	void MultiLevelHandler::GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		LevelHandler::GetCollidingPlayers(aabb, callback);
 	}
@@ -1138,12 +1074,29 @@ namespace Jazz2::Multiplayer
 						return true;
 					}
 					
+					std::uint32_t seqNum = packet.ReadVariableUint32();
+					if (seqNum <= it->second.LastKeyPressSeqNum) {
+						// Duplicate or out-of-order state
+						return true;
+					}
+					it->second.LastKeyPressSeqNum = seqNum;
+
 					std::uint64_t prevState = (it->second.PressedKeys & 0xffffffffu);
 					it->second.PressedKeys = packet.ReadVariableUint32() | (prevState << 32);
 
 					//LOGD("Player %i pressed 0x%08x, last state was 0x%08x", playerIndex, it->second.PressedKeys & 0xffffffffu, prevState);
 					return true;
 				}
+				case ClientPacketType::SnapshotAck: {
+					MemoryStream packet(data + 1, dataLength - 1);
+					std::uint32_t seqNum = packet.ReadVariableUint32();
+
+					auto it = _peerDesc.find(peer);
+					if (it != _peerDesc.end() && it->second.LastAckedSnapshot < seqNum && seqNum <= _snapshotSeqNum) {
+						it->second.LastAckedSnapshot = seqNum;
+					}
+					return true;
+				}
 			}
 		} else {
 			auto packetType = (ServerPacketType)data[0];
@@ -1295,30 +1248,116 @@ namespace Jazz2::Multiplayer
 				}
 				case ServerPacketType::UpdateAllActors: {
 					MemoryStream packet(data + 1, dataLength - 1);
-					std::uint32_t actorCount = packet.ReadVariableUint32();
-					for (std::uint32_t i = 0; i < actorCount; i++) {
+					std::uint32_t seqNum = packet.ReadVariableUint32();
+					std::uint32_t baselineSeqNum = packet.ReadVariableUint32();
+					std::int64_t serverTime = (std::int64_t)packet.ReadVariableUint64();
+					std::uint32_t keyPressAckedSeqNum = packet.ReadVariableUint32();
+					if (seqNum <= _snapshotSeqNum) {
+						// Duplicate or out-of-order snapshot
+						return true;
+					}
+
+					if (_keyPressAckedSeqNum < keyPressAckedSeqNum) {
+						_keyPressAckedSeqNum = keyPressAckedSeqNum;
+					}
+
+					if (_receivedSnapshots.empty()) {
+						_receivedSnapshots.resize(SnapshotHistorySize);
+					}
+
+					Snapshot& snapshot = _receivedSnapshots[seqNum % SnapshotHistorySize];
+					if (baselineSeqNum != 0) {
+						const Snapshot& baseline = _receivedSnapshots[baselineSeqNum % SnapshotHistorySize];
+						if (seqNum - baselineSeqNum >= SnapshotHistorySize || baseline.SeqNum != baselineSeqNum) {
+							LOGW("Snapshot #%u received with unknown baseline #%u", seqNum, baselineSeqNum);
+							return true;
+						}
+						snapshot.Actors = baseline.Actors;
+					} else {
+						snapshot.Actors.clear();
+					}
+					snapshot.SeqNum = seqNum;
+
+					std::uint32_t removedCount = packet.ReadVariableUint32();
+					for (std::uint32_t i = 0; i < removedCount; i++) {
+						std::uint32_t index = packet.ReadVariableUint32();
+						snapshot.Actors.erase(index);
+
+						// Actor left the interest zone of this peer, it's shown again when it reappears in a snapshot
+						auto it = _remoteActors.find(index);
+						if (it != _remoteActors.end()) {
+							if (auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor*>(it->second)) {
+								remoteActor->HideUntilSynced();
+							}
+						}
+					}
+
+					std::uint32_t changedCount = packet.ReadVariableUint32();
+					for (std::uint32_t i = 0; i < changedCount; i++) {
 						std::uint32_t index = packet.ReadVariableUint32();
-						float posX = packet.ReadValue<std::int32_t>() / 512.0f;
-						float posY = packet.ReadValue<std::int32_t>() / 512.0f;
-						std::uint32_t anim = packet.ReadVariableUint32();
-						float rotation = packet.ReadValue<std::uint8_t>() * fRadAngle360 / 255.0f;
-						std::uint8_t flags = packet.ReadValue<std::uint8_t>();
-						Actors::ActorRendererType rendererType = (Actors::ActorRendererType)packet.ReadValue<std::uint8_t>();
+						ActorSnapshotFields fields = (ActorSnapshotFields)packet.ReadValue<std::uint8_t>();
 
+						auto it = snapshot.Actors.find(index);
+						ActorSnapshot& actor = (it != snapshot.Actors.end() ? it->second : snapshot.Actors.emplace(index, ActorSnapshot{}).first->second);
+						if ((fields & ActorSnapshotFields::PosX) != ActorSnapshotFields::None) {
+							actor.PosX += packet.ReadVariableInt32();
+						}
+						if ((fields & ActorSnapshotFields::PosY) != ActorSnapshotFields::None) {
+							actor.PosY += packet.ReadVariableInt32();
+						}
+						if ((fields & ActorSnapshotFields::Anim) != ActorSnapshotFields::None) {
+							actor.Anim = packet.ReadVariableUint32();
+						}
+						if ((fields & ActorSnapshotFields::Rotation) != ActorSnapshotFields::None) {
+							actor.Rotation = packet.ReadValue<std::uint8_t>();
+						}
+						if ((fields & ActorSnapshotFields::Flags) != ActorSnapshotFields::None) {
+							actor.Flags = packet.ReadValue<std::uint8_t>();
+						}
+						if ((fields & ActorSnapshotFields::RendererType) != ActorSnapshotFields::None) {
+							actor.RendererType = packet.ReadValue<std::uint8_t>();
+						}
+					}
+
+					_snapshotSeqNum = seqNum;
+
+					// States are timestamped by server clock, so network jitter doesn't affect interpolation,
+					// the lowest observed offset is used immediately and higher latency is adapted slowly
+					Clock& c = nCine::clock();
+					std::int64_t now = c.now() * 1000 / c.frequency();
+					std::int64_t timeOffset = now - serverTime;
+					if (_serverTimeOffset == INT64_MAX || timeOffset < _serverTimeOffset) {
+						_serverTimeOffset = timeOffset;
+					} else if (timeOffset > _serverTimeOffset) {
+						_serverTimeOffset += (timeOffset - _serverTimeOffset + 15) / 16;
+					}
+					std::int64_t stateTime = serverTime + _serverTimeOffset;
+
+					MemoryStream ackPacket(6);
+					ackPacket.WriteValue<std::uint8_t>((std::uint8_t)ClientPacketType::SnapshotAck);
+					ackPacket.WriteVariableUint32(seqNum);
+					_networkManager->SendToPeer(nullptr, NetworkChannel::UnreliableUpdates, ackPacket.GetBuffer(), ackPacket.GetSize());
+
+					// Unchanged actors are synchronized too, so interpolation on the client side receives all samples
+					for (const auto& [index, actor] : snapshot.Actors) {
 						auto it = _remoteActors.find(index);
 						if (it != _remoteActors.end()) {
 							if (auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor*>(it->second)) {
-								remoteActor->SyncWithServer(Vector2f(posX, posY), (AnimState)anim, rotation,
-									(flags & 0x02) != 0, (flags & 0x01) != 0, (flags & 0x04) != 0, rendererType);
+								remoteActor->SyncWithServer(stateTime, Vector2f(actor.PosX / 512.0f, actor.PosY / 512.0f), (AnimState)actor.Anim,
+									actor.Rotation * fRadAngle360 / 255.0f, (actor.Flags & 0x02) != 0, (actor.Flags & 0x01) != 0,
+									(actor.Flags & 0x04) != 0, (Actors::ActorRendererType)actor.RendererType);
 							}
 						}
 					}
 					return true;
 				}
 				case ServerPacketType::SyncTileMap: {
-					MemoryStream packet(data + 1, dataLength - 1);
-					// TODO: No lock here ???
-					TileMap()->InitializeFromStream(packet);
+					// Packet contains only modified tiles, so it's small enough to be copied and applied on the main thread
+					SmallVector<std::uint8_t, 0> tileMapData(data + 1, data + dataLength);
+					_root->InvokeAsync([this, tileMapData = std::move(tileMapData)]() {
+						MemoryStream packet(tileMapData.data(), (std::int64_t)tileMapData.size());
+						TileMap()->InitializeFromStream(packet);
+					});
 					return true;
 				}
 				case ServerPacketType::SetTrigger: {
@@ -1574,8 +1613,7 @@ namespace Jazz2::Multiplayer
 
 			// Synchronize tilemap
 			{
-				// TODO: Use deflate compression here?
-				MemoryStream packet(20 * 1024);
+				MemoryStream packet(256);
 				packet.WriteValue<std::uint8_t>((std::uint8_t)ServerPacketType::SyncTileMap);
 				_tileMap->SerializeResumableToStream(packet);
 				_networkManager->SendToPeer(peer, NetworkChannel::Main, packet.GetBuffer(), packet.GetSize());
@@ -1686,6 +1724,157 @@ namespace Jazz2::Multiplayer
 		}
 	}
 
+	MultiLevelHandler::ActorSnapshot MultiLevelHandler::CreateActorSnapshot(Actors::ActorBase* actor)
+	{
+		ActorSnapshot snapshot;
+		snapshot.PosX = (std::int32_t)(actor->_pos.X * 512.0f);
+		snapshot.PosY = (std::int32_t)(actor->_pos.Y * 512.0f);
+		snapshot.Anim = (std::uint32_t)(actor->_currentTransition != nullptr ? actor->_currentTransition->State : (actor->_currentAnimation != nullptr ? actor->_currentAnimation->State : AnimState::Idle));
+
+		float rotation = actor->_renderer.rotation();
+		if (rotation < 0.0f) rotation += fRadAngle360;
+		snapshot.Rotation = (std::uint8_t)(rotation * 255.0f / fRadAngle360);
+
+		snapshot.Flags = 0;
+		if (actor->IsFacingLeft()) {
+			snapshot.Flags |= 0x01;
+		}
+		if (actor->_renderer.isDrawEnabled()) {
+			snapshot.Flags |= 0x02;
+		}
+		if (actor->_renderer.AnimPaused) {
+			snapshot.Flags |= 0x04;
+		}
+
+		snapshot.RendererType = (std::uint8_t)actor->_renderer.GetRendererType();
+		return snapshot;
+	}
+
+	void MultiLevelHandler::SendActorSnapshot(const Peer& peer, PeerDesc& peerDesc, const ArrayView<const std::pair<std::uint32_t, ActorSnapshot>> actors)
+	{
+		if (peerDesc.Snapshots.empty()) {
+			peerDesc.Snapshots.resize(SnapshotHistorySize);
+		}
+
+		// Delta encoding is possible only against a snapshot that the peer already received
+		const Snapshot* baseline = nullptr;
+		std::uint32_t lastAcked = peerDesc.LastAckedSnapshot;
+		if (lastAcked != 0 && _snapshotSeqNum - lastAcked < SnapshotHistorySize) {
+			const Snapshot& ackedSnapshot = peerDesc.Snapshots[lastAcked % SnapshotHistorySize];
+			if (ackedSnapshot.SeqNum == lastAcked) {
+				baseline = &ackedSnapshot;
+			}
+		}
+
+		Snapshot& snapshot = peerDesc.Snapshots[_snapshotSeqNum % SnapshotHistorySize];
+		snapshot.SeqNum = _snapshotSeqNum;
+		snapshot.Actors.clear();
+
+		// Only actors that are close enough to the player are included, the same range is used for event activation
+		std::int32_t playerIndex = peerDesc.Player->_playerIndex;
+		std::int32_t tx = (std::int32_t)peerDesc.Player->_pos.X / TileSet::DefaultTileSize;
+		std::int32_t ty = (std::int32_t)peerDesc.Player->_pos.Y / TileSet::DefaultTileSize;
+		constexpr std::int32_t TileSizeFixed = TileSet::DefaultTileSize * 512;
+		AABBi zone((tx - SnapshotTileRange) * TileSizeFixed, (ty - SnapshotTileRange) * TileSizeFixed,
+			(tx + SnapshotTileRange + 1) * TileSizeFixed, (ty + SnapshotTileRange + 1) * TileSizeFixed);
+
+		for (const auto& [index, actor] : actors) {
+			// Peer's own player is simulated on the client side
+			if (index != (std::uint32_t)playerIndex && zone.Contains(Vector2i(actor.PosX, actor.PosY))) {
+				snapshot.Actors.emplace(index, actor);
+			}
+		}
+
+		SmallVector<std::uint32_t, 16> removed;
+		if (baseline != nullptr) {
+			for (const auto& [index, actor] : baseline->Actors) {
+				if (!snapshot.Actors.contains(index)) {
+					removed.push_back(index);
+				}
+			}
+		}
+
+		std::uint32_t changedCount = 0;
+		MemoryStream changed(snapshot.Actors.size() * 12);
+		for (const auto& [index, actor] : snapshot.Actors) {
+			ActorSnapshot prevActor = { };
+			if (baseline != nullptr) {
+				auto it = baseline->Actors.find(index);
+				if (it != baseline->Actors.end()) {
+					prevActor = it->second;
+				}
+			}
+
+			ActorSnapshotFields fields = ActorSnapshotFields::None;
+			if (actor.PosX != prevActor.PosX) fields |= ActorSnapshotFields::PosX;
+			if (actor.PosY != prevActor.PosY) fields |= ActorSnapshotFields::PosY;
+			if (actor.Anim != prevActor.Anim) fields |= ActorSnapshotFields::Anim;
+			if (actor.Rotation != prevActor.Rotation) fields |= ActorSnapshotFields::Rotation;
+			if (actor.Flags != prevActor.Flags) fields |= ActorSnapshotFields::Flags;
+			if (actor.RendererType != prevActor.RendererType) fields |= ActorSnapshotFields::RendererType;
+
+			if (fields == ActorSnapshotFields::None && baseline != nullptr && baseline->Actors.contains(index)) {
+				continue;
+			}
+
+			changed.WriteVariableUint32(index);
+			changed.WriteValue<std::uint8_t>((std::uint8_t)fields);
+			if ((fields & ActorSnapshotFields::PosX) != ActorSnapshotFields::None) {
+				changed.WriteVariableInt32(actor.PosX - prevActor.PosX);
+			}
+			if ((fields & ActorSnapshotFields::PosY) != ActorSnapshotFields::None) {
+				changed.WriteVariableInt32(actor.PosY - prevActor.PosY);
+			}
+			if ((fields & ActorSnapshotFields::Anim) != ActorSnapshotFields::None) {
+				changed.WriteVariableUint32(actor.Anim);
+			}
+			if ((fields & ActorSnapshotFields::Rotation) != ActorSnapshotFields::None) {
+				changed.WriteValue<std::uint8_t>(actor.Rotation);
+			}
+			if ((fields & ActorSnapshotFields::Flags) != ActorSnapshotFields::None) {
+				changed.WriteValue<std::uint8_t>(actor.Flags);
+			}
+			if ((fields & ActorSnapshotFields::RendererType) != ActorSnapshotFields::None) {
+				changed.WriteValue<std::uint8_t>(actor.RendererType);
+			}
+			changedCount++;
+		}
+
+		std::uint32_t keyPressAckedSeqNum = 0;
+		auto it = _playerStates.find(playerIndex);
+		if (it != _playerStates.end()) {
+			keyPressAckedSeqNum = it->second.LastKeyPressSeqNum;
+		}
+
+		Clock& c = nCine::clock();
+		std::uint64_t now = c.now() * 1000 / c.frequency();
+
+		MemoryStream packet(32 + removed.size() * 5 + changed.GetSize());
+		packet.WriteValue<std::uint8_t>((std::uint8_t)ServerPacketType::UpdateAllActors);
+		packet.WriteVariableUint32(_snapshotSeqNum);
+		packet.WriteVariableUint32(baseline != nullptr ? baseline->SeqNum : 0);
+		packet.WriteVariableUint64(now);
+		packet.WriteVariableUint32(keyPressAckedSeqNum);
+		packet.WriteVariableUint32((std::uint32_t)removed.size());
+		for (std::uint32_t index : removed) {
+			packet.WriteVariableUint32(index);
+		}
+		packet.WriteVariableUint32(changedCount);
+		packet.Write(changed.GetBuffer(), changed.GetSize());
+
+		_networkManager->SendToPeer(peer, NetworkChannel::UnreliableUpdates, packet.GetBuffer(), packet.GetSize());
+	}
+
+	void MultiLevelHandler::SendPlayerKeyPress()
+	{
+		MemoryStream packet(14);
+		packet.WriteValue<std::uint8_t>((std::uint8_t)ClientPacketType::PlayerKeyPress);
+		packet.WriteVariableUint32(_lastSpawnedActorId);
+		packet.WriteVariableUint32(_keyPressSeqNum);
+		packet.WriteVariableUint32((std::uint32_t)(_pressedActions & 0xffffffffu));
+		_networkManager->SendToPeer(nullptr, NetworkChannel::UnreliableUpdates, packet.GetBuffer(), packet.GetSize());
+	}
+
 	std::uint32_t MultiLevelHandler::FindFreeActorId()
 	{
 		//return ++_lastSpawnedActorId;
@@ -1849,7 +2038,7 @@ namespace Jazz2::Multiplayer
 	}
 
 	MultiLevelHandler::PlayerState::PlayerState(const Vector2f& pos, const Vector2f& speed)
-		: Flags(PlayerFlags::None), PressedKeys(0)/*, WarpSeqNum(0), WarpTimeLeft(0.0f)*/
+		: Flags(PlayerFlags::None), PressedKeys(0), LastKeyPressSeqNum(0)/*, WarpSeqNum(0), WarpTimeLeft(0.0f)*/
 	{
 	}
 }
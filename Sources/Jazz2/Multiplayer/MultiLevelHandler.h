@@ -52,9 +52,12 @@ namespace Jazz2::Multiplayer
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(Actors::ActorBase* actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider) override;
-		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		using ILevelHandler::FindCollisionActorsByAABB;
+		using ILevelHandler::FindCollisionActorsByRadius;
+		using ILevelHandler::GetCollidingPlayers;
 
 		void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, uint8_t* eventParams) override;
 		void BeginLevelChange(ExitType exitType, const StringView nextLevel) override;
@@ -114,13 +117,44 @@ namespace Jazz2::Multiplayer
 			LevelSynchronized
 		};
 
+		struct ActorSnapshot {
+			std::int32_t PosX;
+			std::int32_t PosY;
+			std::uint32_t Anim;
+			std::uint8_t Rotation;
+			std::uint8_t Flags;
+			std::uint8_t RendererType;
+		};
+
+		enum class ActorSnapshotFields : std::uint8_t {
+			None = 0,
+
+			PosX = 0x01,
+			PosY = 0x02,
+			Anim = 0x04,
+			Rotation = 0x08,
+			Flags = 0x10,
+			RendererType = 0x20
+		};
+
+		DEFINE_PRIVATE_ENUM_OPERATORS(ActorSnapshotFields);
+
+		struct Snapshot {
+			std::uint32_t SeqNum;
+			HashMap<std::uint32_t, ActorSnapshot> Actors;
+
+			Snapshot() : SeqNum(0) {}
+		};
+
 		struct PeerDesc {
 			Actors::Multiplayer::RemotePlayerOnServer* Player;
 			PeerState State;
 			std::uint32_t LastUpdated;
+			std::uint32_t LastAckedSnapshot;
+			SmallVector<Snapshot, 0> Snapshots;
 
 			PeerDesc() {}
-			PeerDesc(Actors::Multiplayer::RemotePlayerOnServer* player, PeerState state) : Player(player), State(state), LastUpdated(0) {}
+			PeerDesc(Actors::Multiplayer::RemotePlayerOnServer* player, PeerState state) : Player(player), State(state), LastUpdated(0), LastAckedSnapshot(0) {}
 		};
 
 		enum class PlayerFlags {
@@ -140,6 +174,7 @@ namespace Jazz2::Multiplayer
 		struct PlayerState {
 			PlayerFlags Flags;
 			std::uint64_t PressedKeys;
+			std::uint32_t LastKeyPressSeqNum;
 			//std::uint64_t WarpSeqNum;
 			//float WarpTimeLeft;
 
@@ -149,6 +184,8 @@ namespace Jazz2::Multiplayer
 
 		static constexpr float UpdatesPerSecond = 16.0f; // ~62 ms interval
 		static constexpr std::int64_t ServerDelay = 64;
+		static constexpr std::uint32_t SnapshotHistorySize = 32;
+		static constexpr std::int32_t SnapshotTileRange = ActivateTileRange + 4;
 
 		NetworkManager* _networkManager;
 		MultiplayerGameMode _gameMode;
@@ -162,10 +199,18 @@ namespace Jazz2::Multiplayer
 		std::uint32_t _lastSpawnedActorId;	// Server: last assigned actor/player ID, Client: ID assigned by server
 		std::uint64_t _seqNum; // Client: sequence number of the last update
 		std::uint64_t _seqNumWarped; // Client: set to _seqNum from HandlePlayerWarped() when warped
+		std::uint32_t _snapshotSeqNum; // Server: sequence number of the last sent snapshot, Client: the last received snapshot
+		SmallVector<Snapshot, 0> _receivedSnapshots; // Client: Recently received snapshots used as baselines for delta decoding
+		std::int64_t _serverTimeOffset; // Client: estimated difference between local and server clock (in milliseconds)
+		std::uint32_t _keyPressSeqNum; // Client: sequence number of the last pressed keys state
+		std::uint32_t _keyPressAckedSeqNum; // Client: sequence number of the last pressed keys state processed by server
 		bool _suppressRemoting; // Server: if true, actor will not be automatically remoted to other players
 		bool _ignorePackets;
 
 		void SynchronizePeers();
+		void SendPlayerKeyPress();
+		ActorSnapshot CreateActorSnapshot(Actors::ActorBase* actor);
+		void SendActorSnapshot(const Peer& peer, PeerDesc& peerDesc, const ArrayView<const std::pair<std::uint32_t, ActorSnapshot>> actors);
 		std::uint32_t FindFreeActorId();
 		std::uint8_t FindFreePlayerId();
 
@@ -16,7 +16,8 @@ namespace Jazz2::Multiplayer
 		LevelReady,
 
 		PlayerUpdate,
-		PlayerKeyPress
+		PlayerKeyPress,
+		SnapshotAck
 	};
 
 	enum class ServerPacketType
@@ -15,8 +15,11 @@ using namespace Death::IO;
 namespace Jazz2
 {
 	bool PreferencesCache::FirstRun = false;
-#if defined(WITH_MULTIPLAYER)
+#if defined(WITH_MULTIPLAYER) || defined(RENDER_BENCHMARK)
 	String PreferencesCache::InitialState;
+#endif
+#if defined(WITH_MULTIPLAYER)
+	std::int32_t PreferencesCache::NetworkInterpolationDelay = 64;
 #endif
 	UnlockableEpisodes PreferencesCache::UnlockedEpisodes = UnlockableEpisodes::None;
 	RescaleMode PreferencesCache::ActiveRescaleMode = RescaleMode::None;
@@ -26,6 +29,7 @@ namespace Jazz2
 	bool PreferencesCache::KeepAspectRatioInCinematics = false;
 	bool PreferencesCache::ShowPlayerTrails = true;
 	bool PreferencesCache::LowWaterQuality = false;
+	bool PreferencesCache::LowLightingQuality = false;
 	bool PreferencesCache::UnalignedViewport = false;
 	bool PreferencesCache::EnableReforgedGameplay = true;
 	bool PreferencesCache::EnableReforgedHUD = true;
@@ -161,6 +165,7 @@ namespace Jazz2
 					KeepAspectRatioInCinematics = ((boolOptions & BoolOptions::KeepAspectRatioInCinematics) == BoolOptions::KeepAspectRatioInCinematics);
 					ShowPlayerTrails = ((boolOptions & BoolOptions::ShowPlayerTrails) == BoolOptions::ShowPlayerTrails);
 					LowWaterQuality = ((boolOptions & BoolOptions::LowWaterQuality) == BoolOptions::LowWaterQuality);
+					LowLightingQuality = ((boolOptions & BoolOptions::LowLightingQuality) == BoolOptions::LowLightingQuality);
 					UnalignedViewport = ((boolOptions & BoolOptions::UnalignedViewport) == BoolOptions::UnalignedViewport);
 					EnableReforgedGameplay = ((boolOptions & BoolOptions::EnableReforgedGameplay) == BoolOptions::EnableReforgedGameplay);
 					EnableLedgeClimb = ((boolOptions & BoolOptions::EnableLedgeClimb) == BoolOptions::EnableLedgeClimb);
@@ -343,9 +348,22 @@ namespace Jazz2
 			} else if (arg == "/reset-controls"_s) {
 				UI::ControlScheme::Reset();
 			}
+#	if defined(RENDER_BENCHMARK)
+			else if (InitialState.empty() && arg.hasPrefix("/benchmark:"_s)) {
+				InitialState = arg;
+			}
+#	endif
 #	if defined(WITH_MULTIPLAYER)
-			else if (InitialState.empty() && (arg == "/server"_s || arg.hasPrefix("/connect:"_s))) {
+			else if (InitialState.empty() && (arg == "/server"_s || arg.hasPrefix("/server:"_s) || arg.hasPrefix("/connect:"_s))) {
 				InitialState = arg;
+			} else if (arg.hasPrefix("/interp-delay:"_s)) {
+				// Delay of remote actors (in milliseconds) can be set only with command-line parameter
+				StringView param = arg.exceptPrefix("/interp-delay:"_s);
+				char* end;
+				unsigned long paramValue = strtoul(param.data(), &end, 10);
+				if (!param.empty() && end == param.end()) {
+					NetworkInterpolationDelay = (std::int32_t)std::min(paramValue, 1000ul);
+				}
 			}
 #	endif
 		}
@@ -376,6 +394,7 @@ namespace Jazz2
 		if (KeepAspectRatioInCinematics) boolOptions |= BoolOptions::KeepAspectRatioInCinematics;
 		if (ShowPlayerTrails) boolOptions |= BoolOptions::ShowPlayerTrails;
 		if (LowWaterQuality) boolOptions |= BoolOptions::LowWaterQuality;
+		if (LowLightingQuality) boolOptions |= BoolOptions::LowLightingQuality;
 		if (UnalignedViewport) boolOptions |= BoolOptions::UnalignedViewport;
 		if (EnableReforgedGameplay) boolOptions |= BoolOptions::EnableReforgedGameplay;
 		if (EnableLedgeClimb) boolOptions |= BoolOptions::EnableLedgeClimb;
@@ -86,8 +86,11 @@ namespace Jazz2
 		static constexpr std::int32_t UseVsync = -1;
 
 		static bool FirstRun;
-#if defined(WITH_MULTIPLAYER)
+#if defined(WITH_MULTIPLAYER) || defined(RENDER_BENCHMARK)
 		static String InitialState;
+#endif
+#if defined(WITH_MULTIPLAYER)
+		static std::int32_t NetworkInterpolationDelay;
 #endif
 		static UnlockableEpisodes UnlockedEpisodes;
 
@@ -99,6 +102,7 @@ namespace Jazz2
 		static bool KeepAspectRatioInCinematics;
 		static bool ShowPlayerTrails;
 		static bool LowWaterQuality;
+		static bool LowLightingQuality;
 		static bool UnalignedViewport;
 
 		// Gameplay
@@ -150,6 +154,7 @@ namespace Jazz2
 			ShowPlayerTrails = 0x08,
 			LowWaterQuality = 0x10,
 			UnalignedViewport = 0x20,
+			LowLightingQuality = 0x40,
 
 			EnableReforgedGameplay = 0x100,
 			EnableLedgeClimb = 0x200,
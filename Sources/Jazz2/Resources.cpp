@@ -17,7 +17,11 @@ namespace Jazz2
 	}
 
 	GenericSoundResource::GenericSoundResource(std::unique_ptr<Stream> stream, const StringView filename) noexcept
+#if defined(WITH_AUDIO)
 		: Buffer(std::move(stream), filename), Flags(GenericSoundResourceFlags::None)
+#else
+		: Flags(GenericSoundResourceFlags::None)
+#endif
 	{
 	}
 
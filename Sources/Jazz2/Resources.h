@@ -3,6 +3,7 @@
 #include "../Common.h"
 #include "AnimationLoopMode.h"
 #include "AnimState.h"
+#include "Collisions/CollisionMask.h"
 #include "../nCine/Audio/AudioBuffer.h"
 #include "../nCine/Base/HashMap.h"
 #include "../nCine/Graphics/Texture.h"
@@ -34,7 +35,7 @@ namespace Jazz2
 		GenericGraphicResourceFlags Flags;
 		std::unique_ptr<Texture> TextureDiffuse;
 		//std::unique_ptr<Texture> TextureNormal;
-		std::unique_ptr<uint8_t[]> Mask;
+		Collisions::CollisionMask Mask;
 		Vector2i FrameDimensions;
 		Vector2i FrameConfiguration;
 		float AnimDuration;
@@ -71,7 +72,9 @@ namespace Jazz2
 
 	struct GenericSoundResource
 	{
+#if defined(WITH_AUDIO)
 		AudioBuffer Buffer;
+#endif
 		GenericSoundResourceFlags Flags;
 
 		GenericSoundResource(std::unique_ptr<Stream> stream, const StringView filename) noexcept;
@@ -132,6 +135,7 @@ namespace Jazz2
 	{
 		Lighting,
 		BatchedLighting,
+		InstancedLighting,
 
 		Blur,
 		Downsample,
@@ -146,6 +150,8 @@ namespace Jazz2
 		BatchedColorized,
 		Tinted,
 		BatchedTinted,
+		TintedMesh,
+		BatchedTintedMesh,
 		Outline,
 		BatchedOutline,
 		WhiteMask,
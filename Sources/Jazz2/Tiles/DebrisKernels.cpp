@@ -0,0 +1,176 @@
+#include "DebrisKernels.h"
+
+#include <algorithm>
+
+#include <Cpu.h>
+
+#if defined(DEATH_ENABLE_SSE2)
+#	include <IntrinsicsSse2.h>
+#endif
+#if defined(DEATH_ENABLE_AVX)
+#	include <IntrinsicsAvx.h>
+#endif
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+#	include <arm_neon.h>
+#endif
+
+namespace Jazz2::Tiles
+{
+	namespace Implementation
+	{
+		namespace
+		{
+			DEATH_ALWAYS_INLINE void integrateLinearScalar(float* values, const float* speeds, float timeMult, std::size_t i, std::size_t count) {
+				for (; i < count; i++) {
+					values[i] += speeds[i] * timeMult;
+				}
+			}
+
+			DEATH_ALWAYS_INLINE void integrateAcceleratedScalar(float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t i, std::size_t count) {
+				const float halfTimeMultSq = 0.5f * timeMult * timeMult;
+				for (; i < count; i++) {
+					positions[i] += speeds[i] * timeMult + accelerations[i] * halfTimeMultSq;
+					if (accelerations[i] != 0.0f) {
+						speeds[i] = std::min(speeds[i] + accelerations[i] * timeMult, maxSpeed);
+					}
+				}
+			}
+
+#if defined(DEATH_ENABLE_SSE2)
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(integrateLinear)>::type integrateLinearImplementation(Cpu::Sse2T) {
+				return [](float* values, const float* speeds, float timeMult, std::size_t count) DEATH_ENABLE_SSE2 {
+					const __m128 vtime = _mm_set1_ps(timeMult);
+
+					std::size_t i = 0;
+					for (; i + 4 <= count; i += 4) {
+						const __m128 v = _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(speeds + i), vtime));
+						_mm_storeu_ps(values + i, v);
+					}
+
+					integrateLinearScalar(values, speeds, timeMult, i, count);
+				};
+			}
+
+			// Speeds with zero acceleration are selected with a mask, so the result is the same as in the scalar variant
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(integrateAccelerated)>::type integrateAcceleratedImplementation(Cpu::Sse2T) {
+				return [](float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count) DEATH_ENABLE_SSE2 {
+					const __m128 vtime = _mm_set1_ps(timeMult);
+					const __m128 vhalfTimeSq = _mm_set1_ps(0.5f * timeMult * timeMult);
+					const __m128 vmaxSpeed = _mm_set1_ps(maxSpeed);
+					const __m128 zero = _mm_setzero_ps();
+
+					std::size_t i = 0;
+					for (; i + 4 <= count; i += 4) {
+						const __m128 s = _mm_loadu_ps(speeds + i);
+						const __m128 a = _mm_loadu_ps(accelerations + i);
+						const __m128 p = _mm_add_ps(_mm_loadu_ps(positions + i), _mm_add_ps(_mm_mul_ps(s, vtime), _mm_mul_ps(a, vhalfTimeSq)));
+						const __m128 accelerated = _mm_min_ps(_mm_add_ps(s, _mm_mul_ps(a, vtime)), vmaxSpeed);
+						const __m128 mask = _mm_cmpneq_ps(a, zero);
+						_mm_storeu_ps(positions + i, p);
+						_mm_storeu_ps(speeds + i, _mm_or_ps(_mm_and_ps(mask, accelerated), _mm_andnot_ps(mask, s)));
+					}
+
+					integrateAcceleratedScalar(positions, speeds, accelerations, timeMult, maxSpeed, i, count);
+				};
+			}
+#endif
+
+#if defined(DEATH_ENABLE_AVX)
+			// Trivial extension of the SSE2 code to AVX, eight values at a time
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX typename std::decay<decltype(integrateLinear)>::type integrateLinearImplementation(Cpu::AvxT) {
+				return [](float* values, const float* speeds, float timeMult, std::size_t count) DEATH_ENABLE_AVX {
+					const __m256 vtime = _mm256_set1_ps(timeMult);
+
+					std::size_t i = 0;
+					for (; i + 8 <= count; i += 8) {
+						const __m256 v = _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(_mm256_loadu_ps(speeds + i), vtime));
+						_mm256_storeu_ps(values + i, v);
+					}
+
+					integrateLinearScalar(values, speeds, timeMult, i, count);
+				};
+			}
+
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX typename std::decay<decltype(integrateAccelerated)>::type integrateAcceleratedImplementation(Cpu::AvxT) {
+				return [](float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count) DEATH_ENABLE_AVX {
+					const __m256 vtime = _mm256_set1_ps(timeMult);
+					const __m256 vhalfTimeSq = _mm256_set1_ps(0.5f * timeMult * timeMult);
+					const __m256 vmaxSpeed = _mm256_set1_ps(maxSpeed);
+					const __m256 zero = _mm256_setzero_ps();
+
+					std::size_t i = 0;
+					for (; i + 8 <= count; i += 8) {
+						const __m256 s = _mm256_loadu_ps(speeds + i);
+						const __m256 a = _mm256_loadu_ps(accelerations + i);
+						const __m256 p = _mm256_add_ps(_mm256_loadu_ps(positions + i), _mm256_add_ps(_mm256_mul_ps(s, vtime), _mm256_mul_ps(a, vhalfTimeSq)));
+						const __m256 accelerated = _mm256_min_ps(_mm256_add_ps(s, _mm256_mul_ps(a, vtime)), vmaxSpeed);
+						const __m256 mask = _mm256_cmp_ps(a, zero, _CMP_NEQ_UQ);
+						_mm256_storeu_ps(positions + i, p);
+						_mm256_storeu_ps(speeds + i, _mm256_blendv_ps(s, accelerated, mask));
+					}
+
+					integrateAcceleratedScalar(positions, speeds, accelerations, timeMult, maxSpeed, i, count);
+				};
+			}
+#endif
+
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(integrateLinear)>::type integrateLinearImplementation(Cpu::NeonT) {
+				return [](float* values, const float* speeds, float timeMult, std::size_t count) DEATH_ENABLE_NEON {
+					const float32x4_t vtime = vdupq_n_f32(timeMult);
+
+					std::size_t i = 0;
+					for (; i + 4 <= count; i += 4) {
+						vst1q_f32(values + i, vmlaq_f32(vld1q_f32(values + i), vld1q_f32(speeds + i), vtime));
+					}
+
+					integrateLinearScalar(values, speeds, timeMult, i, count);
+				};
+			}
+
+			DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(integrateAccelerated)>::type integrateAcceleratedImplementation(Cpu::NeonT) {
+				return [](float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count) DEATH_ENABLE_NEON {
+					const float32x4_t vtime = vdupq_n_f32(timeMult);
+					const float32x4_t vhalfTimeSq = vdupq_n_f32(0.5f * timeMult * timeMult);
+					const float32x4_t vmaxSpeed = vdupq_n_f32(maxSpeed);
+					const float32x4_t zero = vdupq_n_f32(0.0f);
+
+					std::size_t i = 0;
+					for (; i + 4 <= count; i += 4) {
+						const float32x4_t s = vld1q_f32(speeds + i);
+						const float32x4_t a = vld1q_f32(accelerations + i);
+						const float32x4_t p = vmlaq_f32(vmlaq_f32(vld1q_f32(positions + i), s, vtime), a, vhalfTimeSq);
+						const float32x4_t accelerated = vminq_f32(vmlaq_f32(s, a, vtime), vmaxSpeed);
+						const uint32x4_t isZero = vceqq_f32(a, zero);
+						vst1q_f32(positions + i, p);
+						vst1q_f32(speeds + i, vbslq_f32(isZero, s, accelerated));
+					}
+
+					integrateAcceleratedScalar(positions, speeds, accelerations, timeMult, maxSpeed, i, count);
+				};
+			}
+#endif
+
+			DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(integrateLinear)>::type integrateLinearImplementation(Cpu::ScalarT) {
+				return [](float* values, const float* speeds, float timeMult, std::size_t count) {
+					integrateLinearScalar(values, speeds, timeMult, 0, count);
+				};
+			}
+
+			DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(integrateAccelerated)>::type integrateAcceleratedImplementation(Cpu::ScalarT) {
+				return [](float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count) {
+					integrateAcceleratedScalar(positions, speeds, accelerations, timeMult, maxSpeed, 0, count);
+				};
+			}
+		}
+
+		DEATH_CPU_DISPATCHER_BASE(integrateLinearImplementation)
+		DEATH_CPU_DISPATCHED(integrateLinearImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(integrateLinear)(float* values, const float* speeds, float timeMult, std::size_t count))({
+			return integrateLinearImplementation(Cpu::DefaultBase)(values, speeds, timeMult, count);
+		})
+		DEATH_CPU_DISPATCHER_BASE(integrateAcceleratedImplementation)
+		DEATH_CPU_DISPATCHED(integrateAcceleratedImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(integrateAccelerated)(float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count))({
+			return integrateAcceleratedImplementation(Cpu::DefaultBase)(positions, speeds, accelerations, timeMult, maxSpeed, count);
+		})
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../../Common.h"
+
+#include <cstddef>
+
+using namespace Death;
+
+namespace Jazz2::Tiles
+{
+	namespace Implementation
+	{
+		extern void DEATH_CPU_DISPATCHED_DECLARATION(integrateLinear)(float* values, const float* speeds, float timeMult, std::size_t count);
+		DEATH_CPU_DISPATCHER_DECLARATION(integrateLinear)
+		extern void DEATH_CPU_DISPATCHED_DECLARATION(integrateAccelerated)(float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count);
+		DEATH_CPU_DISPATCHER_DECLARATION(integrateAccelerated)
+	}
+
+	/** @brief Adds `speeds[i] * timeMult` to all values */
+	inline void IntegrateLinear(float* values, const float* speeds, float timeMult, std::size_t count) {
+		Implementation::integrateLinear(values, speeds, timeMult, count);
+	}
+
+	/**
+		@brief Moves positions by speeds and accelerations and then accelerates speeds up to @p maxSpeed
+
+		Speeds with zero acceleration are kept unchanged, even if they exceed @p maxSpeed.
+	*/
+	inline void IntegrateAccelerated(float* positions, float* speeds, const float* accelerations, float timeMult, float maxSpeed, std::size_t count) {
+		Implementation::integrateAccelerated(positions, speeds, accelerations, timeMult, maxSpeed, count);
+	}
+}
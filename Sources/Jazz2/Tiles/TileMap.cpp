@@ -1,4 +1,5 @@
 ﻿#include "TileMap.h"
+#include "DebrisKernels.h"
 
 #include "../LevelHandler.h"
 #include "../PreferencesCache.h"
@@ -8,10 +9,56 @@
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/Graphics/RenderResources.h"
 
+#include <IO/DeflateStream.h>
+#include <IO/MemoryStream.h>
+
 namespace Jazz2::Tiles
 {
+	static void ReadLayerTile(BufferedStream& s, LayerTile& tile)
+	{
+		std::uint8_t tileFlags = s.ReadValue<std::uint8_t>();
+		std::uint16_t tileIdx = s.ReadValue<std::uint16_t>();
+
+		std::uint8_t tileModifier = (std::uint8_t)(tileFlags >> 4);
+
+		tile.TileID = tileIdx;
+		tile.Flags = (LayerTileFlags)(tileFlags & 0x07);
+
+		if (tileModifier == 1 /*Translucent*/) {
+			tile.Alpha = 192;
+		} else if (tileModifier == 2 /*Invisible*/) {
+			tile.Alpha = 0;
+		} else {
+			tile.Alpha = 255;
+		}
+	}
+
+	static std::int32_t FloorDivide(std::int32_t value, std::int32_t divisor)
+	{
+		return (value >= 0 ? value / divisor : (value - divisor + 1) / divisor);
+	}
+
+	// Collects render chunks intersecting tiles [first, first + count) along one axis as pairs of chunk index and its first tile
+	static void GetVisibleRenderChunks(std::int32_t first, std::int32_t count, std::int32_t layoutSize, bool repeat, SmallVectorImpl<Vector2i>& result)
+	{
+		std::int32_t last = first + count;
+		if (!repeat) {
+			first = std::max(first, 0);
+			last = std::min(last, layoutSize);
+		}
+
+		std::int32_t tile = first;
+		while (tile < last) {
+			std::int32_t layoutTile = tile - FloorDivide(tile, layoutSize) * layoutSize;
+			std::int32_t chunk = layoutTile / TileMap::RenderChunkSize;
+			std::int32_t chunkStart = tile - (layoutTile - chunk * TileMap::RenderChunkSize);
+			result.emplace_back(chunk, chunkStart);
+			tile = chunkStart + std::min(TileMap::RenderChunkSize, layoutSize - chunk * TileMap::RenderChunkSize);
+		}
+	}
+
 	TileMap::TileMap(const StringView tileSetPath, std::uint16_t captionTileId, bool applyPalette)
-		: _owner(nullptr), _sprLayerIndex(-1), _pitType(PitType::FallForever), _renderCommandsCount(0), _collapsingTimer(0.0f),
+		: _owner(nullptr), _sprLayerIndex(-1), _pitType(PitType::FallForever), _renderCommandsCount(0), _drawIndex(0), _collapsingTimer(0.0f),
 			_triggerState(TriggerCount), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
@@ -170,6 +217,7 @@ namespace Jazz2::Tiles
 		SceneNode::OnDraw(renderQueue);
 
 		_renderCommandsCount = 0;
+		_drawIndex++;
 
 		for (auto& layer : _layers) {
 			DrawLayer(renderQueue, layer);
@@ -213,32 +261,17 @@ namespace Jazz2::Tiles
 
 		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
 
-		std::int32_t limitRightPx = layoutSize.X * TileSet::DefaultTileSize;
-		std::int32_t limitBottomPx = layoutSize.Y * TileSet::DefaultTileSize;
-
-		// Consider out-of-level coordinates as solid walls
-		if (aabb.L < 0 || aabb.R >= limitRightPx) {
-			return false;
-		}
-		if (aabb.B >= limitBottomPx) {
-			return (_pitType != PitType::StandOnPlatform);
+		bool isEmpty;
+		if (IsOutOfLevel(aabb, layoutSize, isEmpty)) {
+			return isEmpty;
 		}
 
 		// Check all covered tiles for collisions; if all are empty, no need to do pixel collision checking
-		std::int32_t hx1 = std::max((std::int32_t)aabb.L, 0);
-		std::int32_t hx2 = std::min((std::int32_t)std::ceil(aabb.R), limitRightPx - 1);
-		std::int32_t hy1 = std::max((std::int32_t)aabb.T, 0);
-		std::int32_t hy2 = std::min((std::int32_t)std::ceil(aabb.B), limitBottomPx - 1);
-
-		if (hy2 <= 0) {
-			hy1 = 0;
-			hy2 = 1;
-		}
-
-		std::int32_t hx1t = hx1 / TileSet::DefaultTileSize;
-		std::int32_t hx2t = hx2 / TileSet::DefaultTileSize;
-		std::int32_t hy1t = hy1 / TileSet::DefaultTileSize;
-		std::int32_t hy2t = hy2 / TileSet::DefaultTileSize;
+		PixelRange range = GetCoveredPixels(aabb, layoutSize);
+		std::int32_t hx1t = range.X1 / TileSet::DefaultTileSize;
+		std::int32_t hx2t = range.X2 / TileSet::DefaultTileSize;
+		std::int32_t hy1t = range.Y1 / TileSet::DefaultTileSize;
+		std::int32_t hy2t = range.Y2 / TileSet::DefaultTileSize;
 
 		auto* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
 
@@ -247,128 +280,269 @@ namespace Jazz2::Tiles
 			RecheckTile:
 				LayerTile& tile = sprLayerLayout[y * layoutSize.X + x];
 
-				if (tile.DestructType == TileDestructType::Weapon && (params.DestructType & TileDestructType::Weapon) == TileDestructType::Weapon) {
-					if ((tile.TileParams & (1 << (std::uint16_t)params.UsedWeaponType)) != 0) {
-						if (AdvanceDestructibleTileAnimation(tile, x, y, params.WeaponStrength, "SceneryDestruct"_s)) {
-							params.TilesDestroyed++;
-							if (params.WeaponStrength <= 0) {
-								return false;
-							} else {
-								goto RecheckTile;
+				DestructibleTile* destructible = GetDestructibleTile(tile, y * layoutSize.X + x);
+				if (destructible != nullptr) {
+					if (destructible->Type == TileDestructType::Weapon && (params.DestructType & TileDestructType::Weapon) == TileDestructType::Weapon) {
+						if ((destructible->Params & (1 << (std::uint16_t)params.UsedWeaponType)) != 0) {
+							if (AdvanceDestructibleTileAnimation(tile, *destructible, x, y, params.WeaponStrength, "SceneryDestruct"_s)) {
+								params.TilesDestroyed++;
+								if (params.WeaponStrength <= 0) {
+									return false;
+								} else {
+									goto RecheckTile;
+								}
 							}
+						} else if (params.UsedWeaponType == WeaponType::Freezer && destructible->FrameIndex < (_animatedTiles[destructible->Animation].Tiles.size() - 2)) {
+							std::int32_t tx = x * TileSet::DefaultTileSize + TileSet::DefaultTileSize / 2;
+							std::int32_t ty = y * TileSet::DefaultTileSize + TileSet::DefaultTileSize / 2;
+							_owner->OnTileFrozen(tx, ty);
+							return false;
 						}
-					} else if (params.UsedWeaponType == WeaponType::Freezer && tile.DestructFrameIndex < (_animatedTiles[tile.DestructAnimation].Tiles.size() - 2)) {
-						std::int32_t tx = x * TileSet::DefaultTileSize + TileSet::DefaultTileSize / 2;
-						std::int32_t ty = y * TileSet::DefaultTileSize + TileSet::DefaultTileSize / 2;
-						_owner->OnTileFrozen(tx, ty);
-						return false;
-					}
-				} else if (tile.DestructType == TileDestructType::Special && (params.DestructType & TileDestructType::Special) == TileDestructType::Special) {
-					std::int32_t amount = 1;
-					if (AdvanceDestructibleTileAnimation(tile, x, y, amount, "SceneryDestruct"_s)) {
-						params.TilesDestroyed++;
-						goto RecheckTile;
-					}
-				} else if (tile.DestructType == TileDestructType::Speed && (params.DestructType & TileDestructType::Speed) == TileDestructType::Speed) {
-					std::int32_t amount = 1;
-					if (tile.TileParams <= params.Speed && AdvanceDestructibleTileAnimation(tile, x, y, amount, "SceneryDestruct"_s)) {
-						params.TilesDestroyed++;
-						goto RecheckTile;
-					}
-				} else if (tile.DestructType == TileDestructType::Collapse && (params.DestructType & TileDestructType::Collapse) == TileDestructType::Collapse) {
-					bool found = false;
-					for (auto& current : _activeCollapsingTiles) {
-						if (current == Vector2i(x, y)) {
-							found = true;
-							break;
+					} else if (destructible->Type == TileDestructType::Special && (params.DestructType & TileDestructType::Special) == TileDestructType::Special) {
+						std::int32_t amount = 1;
+						if (AdvanceDestructibleTileAnimation(tile, *destructible, x, y, amount, "SceneryDestruct"_s)) {
+							params.TilesDestroyed++;
+							goto RecheckTile;
+						}
+					} else if (destructible->Type == TileDestructType::Speed && (params.DestructType & TileDestructType::Speed) == TileDestructType::Speed) {
+						std::int32_t amount = 1;
+						if (destructible->Params <= params.Speed && AdvanceDestructibleTileAnimation(tile, *destructible, x, y, amount, "SceneryDestruct"_s)) {
+							params.TilesDestroyed++;
+							goto RecheckTile;
+						}
+					} else if (destructible->Type == TileDestructType::Collapse && (params.DestructType & TileDestructType::Collapse) == TileDestructType::Collapse) {
+						bool found = false;
+						for (auto& current : _activeCollapsingTiles) {
+							if (current == Vector2i(x, y)) {
+								found = true;
+								break;
+							}
 						}
-					}
 
-					if (!found) {
-						_activeCollapsingTiles.emplace_back(x, y);
-						params.TilesDestroyed++;
+						if (!found) {
+							_activeCollapsingTiles.emplace_back(x, y);
+							params.TilesDestroyed++;
+						}
 					}
 				}
 
+				SolidTile solidTile;
 				if ((params.DestructType & TileDestructType::IgnoreSolidTiles) != TileDestructType::IgnoreSolidTiles &&
-					tile.HasSuspendType == SuspendType::None && ((tile.Flags & LayerTileFlags::OneWay) != LayerTileFlags::OneWay || params.Downwards)) {
-					std::int32_t tileId = ResolveTileID(tile);
-					TileSet* tileSet = ResolveTileSet(tileId);
-					if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
+					ResolveSolidTile(tile, params.Downwards, solidTile) && IsTileMaskSetInRange(solidTile, x, y, range)) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	std::int32_t TileMap::FindFirstEmpty(const AABBf& aabb, ArrayView<const Vector2f> offsets, TileCollisionParams& params)
+	{
+		std::int32_t count = (std::int32_t)offsets.size();
+		if (count == 0) {
+			return -1;
+		}
+		if (_sprLayerIndex == -1) {
+			return 0;
+		}
+
+		if (ChangesDestructibleTiles(params)) {
+			for (std::int32_t i = 0; i < count; i++) {
+				if (IsTileEmpty(aabb + offsets[i], params)) {
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
+
+		// Collect solid pixels of the whole swept area only once
+		std::int32_t ux1 = INT32_MAX, uy1 = INT32_MAX, ux2 = -1, uy2 = -1;
+		for (std::int32_t i = 0; i < count; i++) {
+			AABBf current = aabb + offsets[i];
+			bool isEmpty;
+			if (IsOutOfLevel(current, layoutSize, isEmpty)) {
+				continue;
+			}
+
+			PixelRange range = GetCoveredPixels(current, layoutSize);
+			ux1 = std::min(ux1, range.X1);
+			uy1 = std::min(uy1, range.Y1);
+			ux2 = std::max(ux2, range.X2);
+			uy2 = std::max(uy2, range.Y2);
+		}
+
+		bool checkSolidTiles = ((params.DestructType & TileDestructType::IgnoreSolidTiles) != TileDestructType::IgnoreSolidTiles && ux2 >= 0);
+		std::int32_t stride = 0;
+		SmallVector<std::uint64_t, 256> solidPixels;
+
+		if (checkSolidTiles) {
+			stride = (ux2 - ux1 + 64) / 64;
+			solidPixels.assign(std::size_t(stride) * (uy2 - uy1 + 1), 0);
+
+			auto* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
+
+			for (std::int32_t y = uy1 / TileSet::DefaultTileSize; y <= uy2 / TileSet::DefaultTileSize; y++) {
+				for (std::int32_t x = ux1 / TileSet::DefaultTileSize; x <= ux2 / TileSet::DefaultTileSize; x++) {
+					SolidTile solidTile;
+					if (!ResolveSolidTile(sprLayerLayout[y * layoutSize.X + x], params.Downwards, solidTile)) {
 						continue;
 					}
 
-					std::int32_t tx = x * TileSet::DefaultTileSize;
+					const std::uint32_t* rows = solidTile.Set->GetTileRowMask(solidTile.TileId, solidTile.FlipX, solidTile.FlipY);
+
 					std::int32_t ty = y * TileSet::DefaultTileSize;
+					std::int32_t px = x * TileSet::DefaultTileSize - ux1;
+					std::int32_t top = std::max(uy1 - ty, 0);
+					std::int32_t bottom = std::min(uy2 - ty, TileSet::DefaultTileSize - 1);
 
-					std::int32_t left = std::max(hx1 - tx, 0);
-					std::int32_t right = std::min(hx2 - tx, TileSet::DefaultTileSize - 1);
-					std::int32_t top = std::max(hy1 - ty, 0);
-					std::int32_t bottom = std::min(hy2 - ty, TileSet::DefaultTileSize - 1);
+					for (std::int32_t ry = top; ry <= bottom; ry++) {
+						std::uint64_t row = rows[ry];
+						if (row == 0) {
+							continue;
+						}
 
-					if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-						std::int32_t left2 = left;
-						left = (TileSet::DefaultTileSize - 1 - right);
-						right = (TileSet::DefaultTileSize - 1 - left2);
-					}
-					if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-						std::int32_t top2 = top;
-						top = (TileSet::DefaultTileSize - 1 - bottom);
-						bottom = (TileSet::DefaultTileSize - 1 - top2);
+						std::uint64_t* dst = &solidPixels[(ty + ry - uy1) * stride];
+						if (px < 0) {
+							dst[0] |= (row >> -px);
+						} else {
+							std::int32_t word = (px >> 6);
+							std::int32_t shift = (px & 63);
+							dst[word] |= (row << shift);
+							if (shift > 64 - TileSet::DefaultTileSize && word + 1 < stride) {
+								dst[word + 1] |= (row >> (64 - shift));
+							}
+						}
 					}
+				}
+			}
+		}
+
+		for (std::int32_t i = 0; i < count; i++) {
+			AABBf current = aabb + offsets[i];
 
-					top *= TileSet::DefaultTileSize;
-					bottom *= TileSet::DefaultTileSize;
+			bool isEmpty;
+			if (IsOutOfLevel(current, layoutSize, isEmpty)) {
+				if (isEmpty) {
+					return i;
+				}
+				continue;
+			}
+			if (!checkSolidTiles) {
+				return i;
+			}
 
-					std::uint8_t* mask = tileSet->GetTileMask(tileId);
-					for (std::int32_t ry = top; ry <= bottom; ry += TileSet::DefaultTileSize) {
-						for (std::int32_t rx = left; rx <= right; rx++) {
-							if (mask[ry | rx]) {
-								return false;
-							}
-						}
+			PixelRange range = GetCoveredPixels(current, layoutSize);
+			std::int32_t hx1 = range.X1 - ux1;
+			std::int32_t hx2 = range.X2 - ux1;
+
+			isEmpty = true;
+			for (std::int32_t y = range.Y1 - uy1; y <= range.Y2 - uy1 && isEmpty; y++) {
+				const std::uint64_t* row = &solidPixels[y * stride];
+				for (std::int32_t word = (hx1 >> 6); word <= (hx2 >> 6); word++) {
+					std::uint64_t mask = ~0ull;
+					if (word == (hx1 >> 6)) {
+						mask &= (~0ull << (hx1 & 63));
+					}
+					if (word == (hx2 >> 6)) {
+						mask &= (~0ull >> (63 - (hx2 & 63)));
+					}
+					if ((row[word] & mask) != 0) {
+						isEmpty = false;
+						break;
 					}
 				}
 			}
+
+			if (isEmpty) {
+				return i;
+			}
 		}
 
-		return true;
+		return -1;
 	}
 
-	bool TileMap::CanBeDestroyed(const AABBf& aabb, TileCollisionParams& params)
+	void TileMap::AreTilesEmpty(ArrayView<const AABBf> aabbs, ArrayView<bool> results, TileCollisionParams& params)
 	{
+		std::size_t count = std::min(aabbs.size(), results.size());
 		if (_sprLayerIndex == -1) {
-			return true;
+			for (std::size_t i = 0; i < count; i++) {
+				results[i] = true;
+			}
+			return;
+		}
+
+		if (ChangesDestructibleTiles(params)) {
+			for (std::size_t i = 0; i < count; i++) {
+				results[i] = IsTileEmpty(aabbs[i], params);
+			}
+			return;
 		}
 
 		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
+		bool checkSolidTiles = ((params.DestructType & TileDestructType::IgnoreSolidTiles) != TileDestructType::IgnoreSolidTiles);
 
-		std::int32_t limitRightPx = layoutSize.X * TileSet::DefaultTileSize;
-		std::int32_t limitBottomPx = layoutSize.Y * TileSet::DefaultTileSize;
+		auto* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
 
-		// Consider out-of-level coordinates as solid walls
-		if (aabb.L < 0 || aabb.R >= limitRightPx) {
-			return false;
+		// Tiles cannot be changed by this query, so the last resolved tile is reused, it's usually the same for nearby AABBs
+		std::int32_t lastTileIndex = -1;
+		bool lastTileSolid = false;
+		SolidTile lastTile;
+
+		for (std::size_t i = 0; i < count; i++) {
+			bool isEmpty;
+			if (IsOutOfLevel(aabbs[i], layoutSize, isEmpty)) {
+				results[i] = isEmpty;
+				continue;
+			}
+			if (!checkSolidTiles) {
+				results[i] = true;
+				continue;
+			}
+
+			PixelRange range = GetCoveredPixels(aabbs[i], layoutSize);
+
+			isEmpty = true;
+			for (std::int32_t y = range.Y1 / TileSet::DefaultTileSize; y <= range.Y2 / TileSet::DefaultTileSize && isEmpty; y++) {
+				for (std::int32_t x = range.X1 / TileSet::DefaultTileSize; x <= range.X2 / TileSet::DefaultTileSize; x++) {
+					std::int32_t tileIndex = y * layoutSize.X + x;
+					if (tileIndex != lastTileIndex) {
+						lastTileIndex = tileIndex;
+						lastTileSolid = ResolveSolidTile(sprLayerLayout[tileIndex], params.Downwards, lastTile);
+					}
+
+					if (lastTileSolid && IsTileMaskSetInRange(lastTile, x, y, range)) {
+						isEmpty = false;
+						break;
+					}
+				}
+			}
+
+			results[i] = isEmpty;
 		}
-		if (aabb.B >= limitBottomPx) {
-			return (_pitType != PitType::StandOnPlatform);
+	}
+
+	bool TileMap::CanBeDestroyed(const AABBf& aabb, TileCollisionParams& params)
+	{
+		if (_sprLayerIndex == -1) {
+			return true;
 		}
 
-		// Check all covered tiles for collisions; if all are empty, no need to do pixel collision checking
-		std::int32_t hx1 = std::max((std::int32_t)aabb.L, 0);
-		std::int32_t hx2 = std::min((std::int32_t)std::ceil(aabb.R), limitRightPx - 1);
-		std::int32_t hy1 = std::max((std::int32_t)aabb.T, 0);
-		std::int32_t hy2 = std::min((std::int32_t)std::ceil(aabb.B), limitBottomPx - 1);
+		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
 
-		if (hy2 <= 0) {
-			hy1 = 0;
-			hy2 = 1;
+		bool isEmpty;
+		if (IsOutOfLevel(aabb, layoutSize, isEmpty)) {
+			return isEmpty;
 		}
 
-		std::int32_t hx1t = hx1 / TileSet::DefaultTileSize;
-		std::int32_t hx2t = hx2 / TileSet::DefaultTileSize;
-		std::int32_t hy1t = hy1 / TileSet::DefaultTileSize;
-		std::int32_t hy2t = hy2 / TileSet::DefaultTileSize;
+		// Check all covered tiles for collisions; if all are empty, no need to do pixel collision checking
+		PixelRange range = GetCoveredPixels(aabb, layoutSize);
+		std::int32_t hx1t = range.X1 / TileSet::DefaultTileSize;
+		std::int32_t hx2t = range.X2 / TileSet::DefaultTileSize;
+		std::int32_t hy1t = range.Y1 / TileSet::DefaultTileSize;
+		std::int32_t hy2t = range.Y2 / TileSet::DefaultTileSize;
 
 		auto* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
 
@@ -376,71 +550,40 @@ namespace Jazz2::Tiles
 			for (std::int32_t x = hx1t; x <= hx2t; x++) {
 				LayerTile& tile = sprLayerLayout[y * layoutSize.X + x];
 
-				if ((tile.DestructType & TileDestructType::Weapon) == TileDestructType::Weapon && (params.DestructType & TileDestructType::Weapon) == TileDestructType::Weapon) {
-					if (tile.DestructFrameIndex < (_animatedTiles[tile.DestructAnimation].Tiles.size() - 2) &&
-						((tile.TileParams & (1 << (std::uint16_t)params.UsedWeaponType)) != 0 || params.UsedWeaponType == WeaponType::Freezer)) {
-						return true;
-					}
-				} else if ((tile.DestructType & TileDestructType::Special) == TileDestructType::Special && (params.DestructType & TileDestructType::Special) == TileDestructType::Special) {
-					if (tile.DestructFrameIndex < (_animatedTiles[tile.DestructAnimation].Tiles.size() - 2)) {
-						return true;
-					}
-				} else if ((tile.DestructType & TileDestructType::Speed) == TileDestructType::Speed && (params.DestructType & TileDestructType::Speed) == TileDestructType::Speed) {
-					if (tile.DestructFrameIndex < (_animatedTiles[tile.DestructAnimation].Tiles.size() - 2) && tile.TileParams <= params.Speed) {
-						return true;
-					}
-				} else if ((tile.DestructType & TileDestructType::Collapse) == TileDestructType::Collapse && (params.DestructType & TileDestructType::Collapse) == TileDestructType::Collapse) {
-					bool found = false;
-					for (auto& current : _activeCollapsingTiles) {
-						if (current == Vector2i(x, y)) {
-							found = true;
-							break;
+				DestructibleTile* destructible = GetDestructibleTile(tile, y * layoutSize.X + x);
+				if (destructible != nullptr) {
+					if ((destructible->Type & TileDestructType::Weapon) == TileDestructType::Weapon && (params.DestructType & TileDestructType::Weapon) == TileDestructType::Weapon) {
+						if (destructible->FrameIndex < (_animatedTiles[destructible->Animation].Tiles.size() - 2) &&
+							((destructible->Params & (1 << (std::uint16_t)params.UsedWeaponType)) != 0 || params.UsedWeaponType == WeaponType::Freezer)) {
+							return true;
+						}
+					} else if ((destructible->Type & TileDestructType::Special) == TileDestructType::Special && (params.DestructType & TileDestructType::Special) == TileDestructType::Special) {
+						if (destructible->FrameIndex < (_animatedTiles[destructible->Animation].Tiles.size() - 2)) {
+							return true;
+						}
+					} else if ((destructible->Type & TileDestructType::Speed) == TileDestructType::Speed && (params.DestructType & TileDestructType::Speed) == TileDestructType::Speed) {
+						if (destructible->FrameIndex < (_animatedTiles[destructible->Animation].Tiles.size() - 2) && destructible->Params <= params.Speed) {
+							return true;
+						}
+					} else if ((destructible->Type & TileDestructType::Collapse) == TileDestructType::Collapse && (params.DestructType & TileDestructType::Collapse) == TileDestructType::Collapse) {
+						bool found = false;
+						for (auto& current : _activeCollapsingTiles) {
+							if (current == Vector2i(x, y)) {
+								found = true;
+								break;
+							}
 						}
-					}
 
-					if (!found) {
-						return true;
+						if (!found) {
+							return true;
+						}
 					}
 				}
 
+				SolidTile solidTile;
 				if ((params.DestructType & TileDestructType::IgnoreSolidTiles) != TileDestructType::IgnoreSolidTiles &&
-					tile.HasSuspendType == SuspendType::None && ((tile.Flags & LayerTileFlags::OneWay) != LayerTileFlags::OneWay || params.Downwards)) {
-					std::int32_t tileId = ResolveTileID(tile);
-					TileSet* tileSet = ResolveTileSet(tileId);
-					if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
-						continue;
-					}
-
-					std::int32_t tx = x * TileSet::DefaultTileSize;
-					std::int32_t ty = y * TileSet::DefaultTileSize;
-
-					std::int32_t left = std::max(hx1 - tx, 0);
-					std::int32_t right = std::min(hx2 - tx, TileSet::DefaultTileSize - 1);
-					std::int32_t top = std::max(hy1 - ty, 0);
-					std::int32_t bottom = std::min(hy2 - ty, TileSet::DefaultTileSize - 1);
-
-					if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-						std::int32_t left2 = left;
-						left = (TileSet::DefaultTileSize - 1 - right);
-						right = (TileSet::DefaultTileSize - 1 - left2);
-					}
-					if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-						std::int32_t top2 = top;
-						top = (TileSet::DefaultTileSize - 1 - bottom);
-						bottom = (TileSet::DefaultTileSize - 1 - top2);
-					}
-
-					top *= TileSet::DefaultTileSize;
-					bottom *= TileSet::DefaultTileSize;
-
-					std::uint8_t* mask = tileSet->GetTileMask(tileId);
-					for (std::int32_t ry = top; ry <= bottom; ry += TileSet::DefaultTileSize) {
-						for (std::int32_t rx = left; rx <= right; rx++) {
-							if (mask[ry | rx]) {
-								return false;
-							}
-						}
-					}
+					ResolveSolidTile(tile, params.Downwards, solidTile) && IsTileMaskSetInRange(solidTile, x, y, range)) {
+					return false;
 				}
 			}
 		}
@@ -492,7 +635,8 @@ namespace Jazz2::Tiles
 
 		TileMapLayer& layer = _layers[_sprLayerIndex];
 		LayerTile& tile = layer.Layout[tx + ty * layer.LayoutSize.X];
-		if (tile.HasSuspendType == SuspendType::None) {
+		SuspendType suspendType = tile.GetSuspendType();
+		if (suspendType == SuspendType::None) {
 			return SuspendType::None;
 		}
 
@@ -502,25 +646,16 @@ namespace Jazz2::Tiles
 			return SuspendType::None;
 		}
 
-		std::uint8_t* mask = tileSet->GetTileMask(tileId);
-
 		std::int32_t rx = (std::int32_t)x & 31;
 		std::int32_t ry = (std::int32_t)y & 31;
 
-		if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-			rx = (TileSet::DefaultTileSize - 1 - rx);
-		}
-		if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-			ry = (TileSet::DefaultTileSize - 1 - ry);
-		}
-
-		std::int32_t top = std::max(ry - Tolerance, 0) << 5;
-		std::int32_t bottom = std::min(ry + Tolerance, TileSet::DefaultTileSize - 1) << 5;
+		bool flipX = ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX);
+		bool flipY = ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY);
+		std::int32_t top = std::max(ry - Tolerance, 0);
+		std::int32_t bottom = std::min(ry + Tolerance, TileSet::DefaultTileSize - 1);
 
-		for (std::int32_t ti = bottom | rx; ti >= top; ti -= TileSet::DefaultTileSize) {
-			if (mask[ti]) {
-				return tile.HasSuspendType;
-			}
+		if (tileSet->IsTileMaskSet(tileId, flipX, flipY, rx, top, rx, bottom)) {
+			return suspendType;
 		}
 
 		return SuspendType::None;
@@ -530,20 +665,35 @@ namespace Jazz2::Tiles
 	{
 		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
 		LayerTile& tile = _layers[_sprLayerIndex].Layout[tx + ty * layoutSize.X];
-		return AdvanceDestructibleTileAnimation(tile, tx, ty, amount, {});
+		DestructibleTile* destructible = GetDestructibleTile(tile, tx + ty * layoutSize.X);
+		if (destructible == nullptr) {
+			return false;
+		}
+		return AdvanceDestructibleTileAnimation(tile, *destructible, tx, ty, amount, {});
 	}
 
-	bool TileMap::AdvanceDestructibleTileAnimation(LayerTile& tile, std::int32_t tx, std::int32_t ty, std::int32_t& amount, const StringView soundName)
+	TileMap::DestructibleTile* TileMap::GetDestructibleTile(const LayerTile& tile, std::int32_t index)
 	{
-		AnimatedTile& anim = _animatedTiles[tile.DestructAnimation];
+		if ((tile.Flags & LayerTileFlags::Destructible) != LayerTileFlags::Destructible) {
+			return nullptr;
+		}
+
+		auto it = _destructibleTiles.find(index);
+		return (it != _destructibleTiles.end() ? &it->second : nullptr);
+	}
+
+	bool TileMap::AdvanceDestructibleTileAnimation(LayerTile& tile, DestructibleTile& destructible, std::int32_t tx, std::int32_t ty, std::int32_t& amount, const StringView soundName)
+	{
+		AnimatedTile& anim = _animatedTiles[destructible.Animation];
 		std::int32_t max = (std::int32_t)(anim.Tiles.size() - 2);
-		if (amount > 0 && tile.DestructFrameIndex < max) {
+		if (amount > 0 && destructible.FrameIndex < max) {
 			// Tile not destroyed yet, advance counter by one
-			std::int32_t current = std::min(amount, max - tile.DestructFrameIndex);
+			std::int32_t current = std::min(amount, max - destructible.FrameIndex);
 
-			tile.DestructFrameIndex += current;
-			tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
-			if (tile.DestructFrameIndex >= max) {
+			destructible.FrameIndex += current;
+			tile.TileID = (std::uint16_t)anim.Tiles[destructible.FrameIndex].TileID;
+			InvalidateRenderChunk(_layers[_sprLayerIndex], tx, ty);
+			if (destructible.FrameIndex >= max) {
 				if (!soundName.empty()) {
 					_owner->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
 						ty * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
@@ -574,18 +724,26 @@ namespace Jazz2::Tiles
 
 		for (std::int32_t i = 0; i < _activeCollapsingTiles.size(); i++) {
 			Vector2i tilePos = _activeCollapsingTiles[i];
-			auto& tile = _layers[_sprLayerIndex].Layout[tilePos.X + tilePos.Y * layoutSize.X];
-			if (tile.TileParams == 0) {
+			std::int32_t index = tilePos.X + tilePos.Y * layoutSize.X;
+			auto& tile = _layers[_sprLayerIndex].Layout[index];
+			DestructibleTile* destructible = GetDestructibleTile(tile, index);
+			if (destructible == nullptr) {
+				_activeCollapsingTiles.erase(_activeCollapsingTiles.begin() + i);
+				i--;
+				continue;
+			}
+
+			if (destructible->Params == 0) {
 				std::int32_t amount = 1;
-				if (!AdvanceDestructibleTileAnimation(tile, tilePos.X, tilePos.Y, amount, "SceneryCollapse"_s)) {
-					tile.DestructType = TileDestructType::None;
+				if (!AdvanceDestructibleTileAnimation(tile, *destructible, tilePos.X, tilePos.Y, amount, "SceneryCollapse"_s)) {
+					destructible->Type = TileDestructType::None;
 					_activeCollapsingTiles.erase(_activeCollapsingTiles.begin() + i);
 					i--;
 				} else {
-					tile.TileParams = 4;
+					destructible->Params = 4;
 				}
 			} else {
-				tile.TileParams--;
+				destructible->Params--;
 			}
 		}
 	}
@@ -676,120 +834,238 @@ namespace Jazz2::Tiles
 			}
 
 			// Calculate the index (on the layer map) of the first tile that needs to be drawn to the position determined earlier
-			std::int32_t tileX, tileY, tileAbsX, tileAbsY;
-
-			// Get the actual tile coords on the layer layout
-			if (xt > 0) {
-				tileAbsX = (std::int32_t)std::floor(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-			} else {
-				tileAbsX = (std::int32_t)std::ceil(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-				while (tileX < 0) {
-					tileX += tileCount.X;
-				}
-			}
-
-			if (yt > 0) {
-				tileAbsY = (std::int32_t)std::floor(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
-			} else {
-				tileAbsY = (std::int32_t)std::ceil(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
-				while (tileY < 0) {
-					tileY += tileCount.Y;
-				}
-			}
+			std::int32_t tileAbsX = (std::int32_t)(xt > 0 ? std::floor(xt / (float)TileSet::DefaultTileSize) : std::ceil(xt / (float)TileSet::DefaultTileSize));
+			std::int32_t tileAbsY = (std::int32_t)(yt > 0 ? std::floor(yt / (float)TileSet::DefaultTileSize) : std::ceil(yt / (float)TileSet::DefaultTileSize));
 
 			// Update x1 and y1 with the remainder, so that we start at the tile boundary
-			// minus 1, because indices are updated in the beginning of the loops
 			float remX = fmodf(xt, (float)TileSet::DefaultTileSize);
 			float remY = fmodf(yt, (float)TileSet::DefaultTileSize);
 			x1 -= remX - (float)TileSet::DefaultTileSize;
 			y1 -= remY - (float)TileSet::DefaultTileSize;
-			
-			// Save the tile Y at the left border so that we can roll back to it at the start of every row iteration
-			std::int32_t tileYs = tileY;
-
-			// Calculate the last coordinates we want to draw to
-			float x3 = x1 + (TileSet::DefaultTileSize * 2) + viewSize.X;
-			float y3 = y1 + (TileSet::DefaultTileSize * 2) + viewSize.Y;
-
-			std::int32_t tile_xo = -1;
-			for (float x2 = x1; x2 < x3; x2 += TileSet::DefaultTileSize) {
-				tileX = (tileX + 1) % tileCount.X;
-				tile_xo++;
-				if (!layer.Description.RepeatX) {
-					// If the current tile isn't in the first iteration of the layer horizontally, don't draw this column
-					if (tileAbsX + tile_xo + 1 < 0 || tileAbsX + tile_xo + 1 >= tileCount.X) {
-						continue;
-					}
+
+			// The first visible tile is drawn at (x1, y1)
+			std::int32_t firstTileX = tileAbsX + 1;
+			std::int32_t firstTileY = tileAbsY + 1;
+			std::int32_t visibleTilesX = (viewSize.X / TileSet::DefaultTileSize) + 3;
+			std::int32_t visibleTilesY = (viewSize.Y / TileSet::DefaultTileSize) + 3;
+
+			if (layer.PendingChunkCount > 0) {
+				// Decompress chunks in the visible area and also a bit around it, so they are ready before the camera gets there
+				std::int32_t margin = layer.ChunkSize / 2;
+				LoadLayerChunks(layer, firstTileX - margin, firstTileY - margin, visibleTilesX + margin * 2, visibleTilesY + margin * 2);
+			}
+
+			if (layer.RenderChunks.empty()) {
+				layer.RenderChunksPerRow = (tileCount.X + RenderChunkSize - 1) / RenderChunkSize;
+				layer.RenderChunks.resize(layer.RenderChunksPerRow * ((tileCount.Y + RenderChunkSize - 1) / RenderChunkSize));
+			}
+
+			SmallVector<Vector2i, 8> chunksX, chunksY;
+			GetVisibleRenderChunks(firstTileX, visibleTilesX, tileCount.X, layer.Description.RepeatX, chunksX);
+			GetVisibleRenderChunks(firstTileY, visibleTilesY, tileCount.Y, layer.Description.RepeatY, chunksY);
+
+			for (const Vector2i& chunkY : chunksY) {
+				float y2 = y1 + (chunkY.Y - firstTileY) * TileSet::DefaultTileSize;
+				for (const Vector2i& chunkX : chunksX) {
+					float x2 = x1 + (chunkX.Y - firstTileX) * TileSet::DefaultTileSize;
+					DrawRenderChunk(renderQueue, layer, chunkX.X, chunkY.X, x2, y2);
 				}
-				tileY = tileYs;
-				std::int32_t tile_yo = -1;
-				for (float y2 = y1; y2 < y3; y2 += TileSet::DefaultTileSize) {
-					tileY = (tileY + 1) % tileCount.Y;
-					tile_yo++;
+			}
+		}
+	}
 
-					LayerTile tile = layer.Layout[tileX + tileY * layer.LayoutSize.X];
+	void TileMap::DrawRenderChunk(RenderQueue& renderQueue, TileMapLayer& layer, std::int32_t chunkX, std::int32_t chunkY, float x, float y)
+	{
+		TileMapRenderChunk& chunk = layer.RenderChunks[chunkX + chunkY * layer.RenderChunksPerRow];
 
-					if (!layer.Description.RepeatY) {
-						// If the current tile isn't in the first iteration of the layer vertically, don't draw it
-						if (tileAbsY + tile_yo + 1 < 0 || tileAbsY + tile_yo + 1 >= tileCount.Y) {
-							continue;
-						}
-					}
+		// Geometry depends on current frames of animated tiles, so it has to be rebuilt if any of them changed
+		if (!chunk.IsDirty) {
+			for (const Vector2i& animTile : chunk.AnimatedTiles) {
+				if (_animatedTiles[animTile.X].CurrentTileIdx != animTile.Y) {
+					chunk.IsDirty = true;
+					break;
+				}
+			}
+		}
+		if (chunk.IsDirty) {
+			BuildRenderChunk(layer, chunk, chunkX, chunkY);
+		}
 
-					std::int32_t tileId = ResolveTileID(tile);
-					if (tileId == 0 || tile.Alpha == 0) {
-						continue;
-					}
-					TileSet* tileSet = ResolveTileSet(tileId);
-					if (tileSet == nullptr) {
-						continue;
-					}
+		if (!PreferencesCache::UnalignedViewport) {
+			x = std::floor(x); y = std::floor(y);
+		}
+
+		for (TileMapRenderBatch& batch : chunk.Batches) {
+			RenderCommand* command = RentRenderChunkCommand(batch, layer.Description.RendererType);
+
+			Vector4f color = layer.Description.Color;
+			color.W *= batch.Alpha / 255.0f;
+			command->setInstanceColor(color.Data());
+
+			command->setTransformation(Matrix4x4f::Translation(x, y, 0.0f));
+			command->setLayer(layer.Description.Depth);
 
-					auto command = RentRenderCommand(layer.Description.RendererType);
-					command->setType(RenderCommand::CommandTypes::TileMap);
-					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			renderQueue.addCommand(command);
+		}
+	}
+
+	void TileMap::BuildRenderChunk(TileMapLayer& layer, TileMapRenderChunk& chunk, std::int32_t chunkX, std::int32_t chunkY)
+	{
+		ZoneScopedC(0xA09359);
 
-					Vector2i texSize = tileSet->TextureDiffuse->size();
-					float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
-					float texBiasX = ((tileId % tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.X);
-					float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
-					float texBiasY = ((tileId / tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.Y);
+		std::int32_t x1 = chunkX * RenderChunkSize;
+		std::int32_t y1 = chunkY * RenderChunkSize;
+		std::int32_t x2 = std::min(x1 + RenderChunkSize, layer.LayoutSize.X);
+		std::int32_t y2 = std::min(y1 + RenderChunkSize, layer.LayoutSize.Y);
 
-					// ToDo: Flip normal map somehow
-					if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-						texBiasX += texScaleX;
-						texScaleX *= -1;
+		LoadLayerChunks(layer, x1, y1, x2 - x1, y2 - y1);
+
+		for (TileMapRenderBatch& batch : chunk.Batches) {
+			batch.Vertices.clear();
+		}
+		chunk.AnimatedTiles.clear();
+		chunk.IsDirty = false;
+
+		for (std::int32_t y = y1; y < y2; y++) {
+			for (std::int32_t x = x1; x < x2; x++) {
+				LayerTile* tilePtr = layer.GetTile(x, y);
+				if (tilePtr == nullptr) {
+					continue;
+				}
+				LayerTile& tile = *tilePtr;
+				if ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated && tile.TileID < (std::int32_t)_animatedTiles.size()) {
+					bool alreadyAdded = false;
+					for (const Vector2i& animTile : chunk.AnimatedTiles) {
+						if (animTile.X == tile.TileID) {
+							alreadyAdded = true;
+							break;
+						}
 					}
-					if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-						texBiasY += texScaleY;
-						texScaleY *= -1;
+					if (!alreadyAdded) {
+						chunk.AnimatedTiles.emplace_back(tile.TileID, _animatedTiles[tile.TileID].CurrentTileIdx);
 					}
+				}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-
-					Vector4f color = layer.Description.Color;
-					color.W *= tile.Alpha / 255.0f;
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+				std::int32_t tileId = ResolveTileID(tile);
+				if (tileId == 0 || tile.Alpha == 0) {
+					continue;
+				}
+				TileSet* tileSet = ResolveTileSet(tileId);
+				if (tileSet == nullptr) {
+					continue;
+				}
 
-					float x2r = x2, y2r = y2;
-					if (!PreferencesCache::UnalignedViewport) {
-						x2r = std::floor(x2r); y2r = std::floor(y2r);
+				TileMapRenderBatch* batch = nullptr;
+				for (TileMapRenderBatch& b : chunk.Batches) {
+					if (b.DiffuseTexture == tileSet->TextureDiffuse.get() && b.Alpha == tile.Alpha) {
+						batch = &b;
+						break;
 					}
+				}
+				if (batch == nullptr) {
+					batch = &chunk.Batches.emplace_back();
+					batch->DiffuseTexture = tileSet->TextureDiffuse.get();
+					batch->Alpha = tile.Alpha;
+					batch->LastDrawIndex = 0;
+					batch->UsedCommands = 0;
+				}
 
-					command->setTransformation(Matrix4x4f::Translation(x2r, y2r, 0.0f));
-					command->setLayer(layer.Description.Depth);
-					command->material().setTexture(*tileSet->TextureDiffuse);
+				Vector2i texSize = tileSet->TextureDiffuse->size();
+				float u1 = ((tileId % tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.X);
+				float v1 = ((tileId / tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.Y);
+				float u2 = u1 + TileSet::DefaultTileSize / float(texSize.X);
+				float v2 = v1 + TileSet::DefaultTileSize / float(texSize.Y);
 
-					renderQueue.addCommand(command);
+				// ToDo: Flip normal map somehow
+				if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+					std::swap(u1, u2);
+				}
+				if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+					std::swap(v1, v2);
 				}
+
+				float px1 = (float)((x - x1) * TileSet::DefaultTileSize);
+				float py1 = (float)((y - y1) * TileSet::DefaultTileSize);
+				float px2 = px1 + TileSet::DefaultTileSize;
+				float py2 = py1 + TileSet::DefaultTileSize;
+
+				// Vertices are in the same order as in the sprite shader, so the winding doesn't change
+				const float quad[] = {
+					px2, py1, u2, v1,
+					px2, py2, u2, v2,
+					px1, py1, u1, v1,
+					px1, py2, u1, v2
+				};
+
+				auto& vertices = batch->Vertices;
+				if (!vertices.empty()) {
+					// Degenerate triangles between the previous quad and this one
+					float lastVertex[4];
+					std::memcpy(lastVertex, &vertices[vertices.size() - 4], sizeof(lastVertex));
+					vertices.append(std::begin(lastVertex), std::end(lastVertex));
+					vertices.append(std::begin(quad), std::begin(quad) + 4);
+				}
+				vertices.append(std::begin(quad), std::end(quad));
+			}
+		}
+
+		for (std::int32_t i = (std::int32_t)chunk.Batches.size() - 1; i >= 0; i--) {
+			if (chunk.Batches[i].Vertices.empty()) {
+				chunk.Batches.erase(chunk.Batches.begin() + i);
+			}
+		}
+	}
+
+	RenderCommand* TileMap::RentRenderChunkCommand(TileMapRenderBatch& batch, LayerRendererType type)
+	{
+		if (batch.LastDrawIndex != _drawIndex) {
+			batch.LastDrawIndex = _drawIndex;
+			batch.UsedCommands = 0;
+		}
+
+		RenderCommand* command;
+		if (batch.UsedCommands < batch.Commands.size()) {
+			command = batch.Commands[batch.UsedCommands].get();
+		} else {
+			command = batch.Commands.emplace_back(std::make_unique<RenderCommand>()).get();
+			command->setType(RenderCommand::CommandTypes::TileMap);
+			command->material().setBlendingEnabled(true);
+			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			command->geometry().setNumElementsPerVertex(4);
+		}
+		batch.UsedCommands++;
+
+		bool shaderChanged;
+		switch (type) {
+			case LayerRendererType::Tinted: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::TintedMesh)); break;
+			default: shaderChanged = command->material().setShaderProgramType(Material::ShaderProgramType::MESH_SPRITE); break;
+		}
+		if (shaderChanged) {
+			command->material().reserveUniformsDataMemory();
+
+			// Vertices are already in pixels and in texture coordinates
+			command->setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+			command->setInstanceSpriteSize(1.0f, 1.0f);
+
+			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->intValue(0) != 0) {
+				textureUniform->setIntValue(0); // GL_TEXTURE0
 			}
 		}
+
+		// Vertex pointer can change only if the chunk was rebuilt, but the common VBO has to be filled every frame anyway
+		command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, (GLsizei)(batch.Vertices.size() / 4));
+		command->geometry().setHostVertexPointer(batch.Vertices.data());
+		command->material().setTexture(*batch.DiffuseTexture);
+
+		return command;
+	}
+
+	void TileMap::InvalidateRenderChunk(TileMapLayer& layer, std::int32_t tx, std::int32_t ty)
+	{
+		if (!layer.RenderChunks.empty()) {
+			layer.RenderChunks[(tx / RenderChunkSize) + (ty / RenderChunkSize) * layer.RenderChunksPerRow].IsDirty = true;
+		}
 	}
 
 	float TileMap::TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY)
@@ -848,7 +1124,7 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::ReadLayerConfiguration(Stream& s)
+	void TileMap::ReadLayerConfiguration(BufferedStream& s)
 	{
 		LayerType layerType = (LayerType)s.ReadValue<std::uint8_t>();
 		std::uint16_t layerFlags = s.ReadValue<std::uint16_t>();
@@ -917,30 +1193,151 @@ namespace Jazz2::Tiles
 			newLayer.Description.Color = Vector4f(1.0f, 1.0f, 1.0f, 1.0f);
 		}
 
+		newLayer.ChunkSize = 0;
+		newLayer.ChunksPerRow = 0;
+		newLayer.PendingChunkCount = 0;
+		newLayer.RenderChunksPerRow = 0;
+
+		if ((layerFlags & 0x10) == 0x10 && layerType != LayerType::Sprite) {
+			// Layout is split into independently compressed chunks, they are decompressed when needed for the first time
+			newLayer.ChunkSize = s.ReadValue<std::uint16_t>();
+			if (newLayer.ChunkSize <= 0) {
+				newLayer.ChunkSize = LayerChunkSize;
+			}
+			newLayer.ChunksPerRow = (width + newLayer.ChunkSize - 1) / newLayer.ChunkSize;
+			std::int32_t chunkCount = newLayer.ChunksPerRow * ((height + newLayer.ChunkSize - 1) / newLayer.ChunkSize);
+			newLayer.Chunks.resize(chunkCount);
+			for (std::int32_t i = 0; i < chunkCount; i++) {
+				auto& chunk = newLayer.Chunks[i];
+				chunk.Offset = s.ReadValue<std::uint32_t>();
+				chunk.Size = s.ReadValue<std::uint32_t>();
+				chunk.Loaded = false;
+			}
+			newLayer.PendingChunkCount = chunkCount;
+			return;
+		}
+
 		newLayer.Layout = std::make_unique<LayerTile[]>(width * height);
 
 		for (std::int32_t i = 0; i < (width * height); i++) {
-			std::uint8_t tileFlags = s.ReadValue<std::uint8_t>();
-			std::uint16_t tileIdx = s.ReadValue<std::uint16_t>();
+			ReadLayerTile(s, newLayer.Layout[i]);
+		}
+	}
 
-			std::uint8_t tileModifier = (std::uint8_t)(tileFlags >> 4);
+	void TileMap::ReadLayerChunkData(Stream& s)
+	{
+		std::int32_t size = s.ReadValue<std::int32_t>();
+		if (size <= 0) {
+			return;
+		}
 
-			LayerTile& tile = newLayer.Layout[i];
-			tile.TileID = tileIdx;
+		std::unique_ptr<std::uint8_t[]> data = std::make_unique<std::uint8_t[]>(size);
+		std::uint32_t dataSize = (std::uint32_t)s.Read(data.get(), size);
+		if (dataSize != (std::uint32_t)size) {
+			LOGE("Layer chunk data are truncated (%u of %i bytes)", dataSize, size);
+		}
 
-			tile.Flags = (LayerTileFlags)(tileFlags & 0x0f);
+		// Each chunk gets its own copy of compressed data, so it can be released right after the chunk is decompressed
+		for (auto& layer : _layers) {
+			for (std::int32_t i = 0; i < (std::int32_t)layer.Chunks.size(); i++) {
+				auto& chunk = layer.Chunks[i];
+				if (chunk.Size == 0) {
+					continue;
+				}
+				if (chunk.Offset > dataSize || chunk.Size > dataSize - chunk.Offset) {
+					LOGE("Layer chunk %i is out of bounds", i);
+					chunk.Size = 0;
+					continue;
+				}
+				chunk.CompressedData = std::make_unique<std::uint8_t[]>(chunk.Size);
+				std::memcpy(chunk.CompressedData.get(), data.get() + chunk.Offset, chunk.Size);
+			}
+		}
+	}
 
-			if (tileModifier == 1 /*Translucent*/) {
-				tile.Alpha = 192;
-			} else if (tileModifier == 2 /*Invisible*/) {
-				tile.Alpha = 0;
-			} else {
-				tile.Alpha = 255;
+	void TileMap::LoadLayerChunks(TileMapLayer& layer, std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height)
+	{
+		if (layer.PendingChunkCount <= 0 || width <= 0 || height <= 0) {
+			return;
+		}
+
+		std::int32_t chunkSize = layer.ChunkSize;
+		std::int32_t chunkCountX = layer.ChunksPerRow;
+		std::int32_t chunkCountY = (std::int32_t)layer.Chunks.size() / chunkCountX;
+
+		// Repeating layers wrap around, otherwise the requested area is clamped to the layout
+		std::int32_t cx1, cx2, cy1, cy2;
+		if (layer.Description.RepeatX) {
+			cx1 = FloorDivide(x, chunkSize);
+			cx2 = std::min(FloorDivide(x + width - 1, chunkSize), cx1 + chunkCountX - 1);
+		} else {
+			cx1 = std::max(x, 0) / chunkSize;
+			cx2 = std::min(x + width - 1, layer.LayoutSize.X - 1);
+			if (cx2 < 0) {
+				return;
+			}
+			cx2 /= chunkSize;
+		}
+		if (layer.Description.RepeatY) {
+			cy1 = FloorDivide(y, chunkSize);
+			cy2 = std::min(FloorDivide(y + height - 1, chunkSize), cy1 + chunkCountY - 1);
+		} else {
+			cy1 = std::max(y, 0) / chunkSize;
+			cy2 = std::min(y + height - 1, layer.LayoutSize.Y - 1);
+			if (cy2 < 0) {
+				return;
+			}
+			cy2 /= chunkSize;
+		}
+
+		for (std::int32_t cy = cy1; cy <= cy2; cy++) {
+			std::int32_t chunkY = ((cy % chunkCountY) + chunkCountY) % chunkCountY;
+			for (std::int32_t cx = cx1; cx <= cx2; cx++) {
+				std::int32_t chunkX = ((cx % chunkCountX) + chunkCountX) % chunkCountX;
+				LoadLayerChunk(layer, chunkX + chunkY * chunkCountX);
+			}
+		}
+	}
+
+	void TileMap::LoadLayerChunk(TileMapLayer& layer, std::int32_t chunkIndex)
+	{
+		auto& chunk = layer.Chunks[chunkIndex];
+		if (chunk.Loaded) {
+			return;
+		}
+
+		chunk.Loaded = true;
+		layer.PendingChunkCount--;
+
+		if (chunk.CompressedData == nullptr) {
+			return;
+		}
+
+		ZoneScopedNC("LoadLayerChunk", 0xA09359);
+
+		// Only the part of the chunk inside the layout is stored, the rest of tiles stays empty
+		std::int32_t chunkSize = layer.ChunkSize;
+		std::int32_t width = std::min(chunkSize, layer.LayoutSize.X - (chunkIndex % layer.ChunksPerRow) * chunkSize);
+		std::int32_t height = std::min(chunkSize, layer.LayoutSize.Y - (chunkIndex / layer.ChunksPerRow) * chunkSize);
+
+		chunk.Tiles = std::make_unique<LayerTile[]>(chunkSize * chunkSize);
+
+		{
+			MemoryStream ms(chunk.CompressedData.get(), chunk.Size);
+			DeflateStream ds(ms, chunk.Size);
+			BufferedStream bs(ds);
+
+			for (std::int32_t y = 0; y < height; y++) {
+				for (std::int32_t x = 0; x < width; x++) {
+					ReadLayerTile(bs, chunk.Tiles[x + y * chunkSize]);
+				}
 			}
 		}
+
+		chunk.CompressedData = nullptr;
 	}
 
-	void TileMap::ReadAnimatedTiles(Stream& s)
+	void TileMap::ReadAnimatedTiles(BufferedStream& s)
 	{
 		int16_t count = s.ReadValue<int16_t>();
 
@@ -973,52 +1370,55 @@ namespace Jazz2::Tiles
 
 	void TileMap::SetTileEventFlags(std::int32_t x, std::int32_t y, EventType tileEvent, std::uint8_t* tileParams)
 	{
-		auto& tile = _layers[_sprLayerIndex].Layout[x + y * _layers[_sprLayerIndex].LayoutSize.X];
+		std::int32_t index = x + y * _layers[_sprLayerIndex].LayoutSize.X;
+		auto& tile = _layers[_sprLayerIndex].Layout[index];
 
 		switch (tileEvent) {
 			case EventType::ModifierOneWay:
 				tile.Flags |= LayerTileFlags::OneWay;
 				break;
 			case EventType::ModifierVine:
-				tile.HasSuspendType = SuspendType::Vine;
+				tile.SetSuspendType(SuspendType::Vine);
 				break;
 			case EventType::ModifierHook:
-				tile.HasSuspendType = SuspendType::Hook;
+				tile.SetSuspendType(SuspendType::Hook);
 				break;
 			case EventType::ModifierHurt:
 				tile.Flags |= LayerTileFlags::Hurt;
 				break;
 			case EventType::SceneryDestruct:
-				SetTileDestructibleEventParams(tile, TileDestructType::Weapon, tileParams[0] | (tileParams[1] << 8));
+				SetTileDestructibleEventParams(tile, index, TileDestructType::Weapon, tileParams[0] | (tileParams[1] << 8));
 				break;
 			case EventType::SceneryDestructButtstomp:
-				SetTileDestructibleEventParams(tile, TileDestructType::Special, tileParams[0]);
+				SetTileDestructibleEventParams(tile, index, TileDestructType::Special, tileParams[0]);
 				break;
 			case EventType::TriggerArea:
-				SetTileDestructibleEventParams(tile, TileDestructType::Trigger, tileParams[0]);
+				SetTileDestructibleEventParams(tile, index, TileDestructType::Trigger, tileParams[0]);
 				break;
 			case EventType::SceneryDestructSpeed:
-				SetTileDestructibleEventParams(tile, TileDestructType::Speed, tileParams[0]);
+				SetTileDestructibleEventParams(tile, index, TileDestructType::Speed, tileParams[0]);
 				break;
 			case EventType::SceneryCollapse:
 				// TODO: Framerate (tileParams[1]) not used
-				SetTileDestructibleEventParams(tile, TileDestructType::Collapse, tileParams[0]);
+				SetTileDestructibleEventParams(tile, index, TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
 	}
 
-	void TileMap::SetTileDestructibleEventParams(LayerTile& tile, TileDestructType type, std::uint16_t tileParams)
+	void TileMap::SetTileDestructibleEventParams(LayerTile& tile, std::int32_t index, TileDestructType type, std::uint16_t tileParams)
 	{
 		if ((tile.Flags & LayerTileFlags::Animated) != LayerTileFlags::Animated) {
 			return;
 		}
 
-		tile.DestructType = type;
-		tile.Flags &= ~LayerTileFlags::Animated;
-		tile.DestructAnimation = tile.TileID;
-		tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[0].TileID;
-		tile.TileParams = tileParams;
-		tile.DestructFrameIndex = 0;
+		DestructibleTile& destructible = _destructibleTiles[index];
+		destructible.Type = type;
+		destructible.Animation = tile.TileID;
+		destructible.Params = tileParams;
+		destructible.FrameIndex = 0;
+
+		tile.Flags = (tile.Flags & ~LayerTileFlags::Animated) | LayerTileFlags::Destructible;
+		tile.TileID = (std::uint16_t)_animatedTiles[destructible.Animation].Tiles[0].TileID;
 	}
 
 	void TileMap::CreateDebris(const DestructibleDebris& debris)
@@ -1039,15 +1439,19 @@ namespace Jazz2::Tiles
 				}
 
 				if (_sprLayerIndex + 1 < _layers.size() && _layers[_sprLayerIndex + 1].Description.SpeedX == 1.0f && _layers[_sprLayerIndex + 1].Description.SpeedY == 1.0f) {
-					tileId = ResolveTileID(_layers[_sprLayerIndex + 1].Layout[x + y * spriteLayer.LayoutSize.X]);
-					if (tileSet->IsTileFilled(tileId)) {
-						return;
+					auto& nextLayer = _layers[_sprLayerIndex + 1];
+					LoadLayerChunks(nextLayer, x, y, 1, 1);
+					if (LayerTile* nextTile = nextLayer.GetTile(x, y)) {
+						tileId = ResolveTileID(*nextTile);
+						if (tileSet->IsTileFilled(tileId)) {
+							return;
+						}
 					}
 				}
 			}
 		}
 
-		_debrisList.push_back(debris);
+		_debris.Add(debris);
 	}
 
 	void TileMap::CreateTileDebris(std::int32_t tileId, std::int32_t x, std::int32_t y)
@@ -1084,7 +1488,7 @@ namespace Jazz2::Tiles
 		}*/
 
 		for (std::int32_t i = 0; i < 4; i++) {
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris;
 			debris.Pos = Vector2f(x * TileSet::DefaultTileSize + (i % 2) * QuarterSize, y * TileSet::DefaultTileSize + (i / 2) * QuarterSize);
 			debris.Depth = z;
 			debris.Size = Vector2f(QuarterSize, QuarterSize);
@@ -1108,6 +1512,7 @@ namespace Jazz2::Tiles
 
 			debris.DiffuseTexture = tileSet->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::None;
+			_debris.Add(debris);
 		}
 	}
 
@@ -1123,7 +1528,7 @@ namespace Jazz2::Tiles
 			for (std::int32_t fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
 				float currentSize = DebrisSize * Random().FastFloat(0.2f, 1.1f);
 
-				DestructibleDebris& debris = _debrisList.emplace_back();
+				DestructibleDebris debris;
 				debris.Pos = Vector2f(x + (isFacingLeft ? res->Base->FrameDimensions.X - fx : fx), y + fy);
 				debris.Depth = (std::uint16_t)pos.Z;
 				debris.Size = Vector2f(currentSize, currentSize);
@@ -1148,6 +1553,7 @@ namespace Jazz2::Tiles
 
 				debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 				debris.Flags = DebrisFlags::Bounce;
+				_debris.Add(debris);
 			}
 		}
 	}
@@ -1161,7 +1567,7 @@ namespace Jazz2::Tiles
 		for (std::int32_t i = 0; i < count; i++) {
 			float speedX = Random().FastFloat(-1.0f, 1.0f) * Random().FastFloat(0.2f, 0.8f) * count;
 
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris;
 			debris.Pos = Vector2f(x, y);
 			debris.Depth = (std::uint16_t)pos.Z;
 			debris.Size = Vector2f((float)res->Base->FrameDimensions.X, (float)res->Base->FrameDimensions.Y);
@@ -1188,6 +1594,7 @@ namespace Jazz2::Tiles
 
 			debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::Bounce;
+			_debris.Add(debris);
 		}
 	}
 
@@ -1195,77 +1602,116 @@ namespace Jazz2::Tiles
 	{
 		ZoneScopedC(0xA09359);
 
-		std::int32_t size = (std::int32_t)_debrisList.size();
+		std::int32_t size = _debris.Count();
 		for (std::int32_t i = 0; i < size; i++) {
-			DestructibleDebris& debris = _debrisList[i];
-
-			if (debris.Scale <= 0.0f || debris.Alpha <= 0.0f) {
-				std::swap(debris, _debrisList[size - 1]);
-				_debrisList.pop_back();
+			if (_debris.Scale[i] <= 0.0f || _debris.Alpha[i] <= 0.0f) {
+				_debris.RemoveAt(i);
 				i--;
 				size--;
 				continue;
 			}
 
-			debris.Time -= timeMult;
-			if (debris.Time <= 0.0f) {
-				debris.AlphaSpeed = -std::min(0.02f, debris.Alpha);
-			}
-
-			if ((debris.Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
-				// Debris should collide with tilemap
-				float nx = debris.Pos.X + debris.Speed.X * timeMult;
-				float ny = debris.Pos.Y + debris.Speed.Y * timeMult;
-				AABB aabb = AABBf(nx - 1, ny - 1, nx + 1, ny + 1);
-				TileCollisionParams params = { TileDestructType::None, true };
-				if (IsTileEmpty(aabb, params)) {
-					// Nothing...
-				} else if ((debris.Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
-					debris.ScaleSpeed = -0.02f;
-					debris.AlphaSpeed = -0.006f;
-					debris.Speed = Vector2f::Zero;
-					debris.Acceleration = Vector2f::Zero;
-				} else {
-					// Place us to the ground only if no horizontal movement was
-					// involved (this prevents speeds resetting if the actor
-					// collides with a wall from the side while in the air)
-					aabb.T = debris.Pos.Y - 1;
-					aabb.B = debris.Pos.Y + 1;
-
-					if (IsTileEmpty(aabb, params)) {
-						if (debris.Speed.Y > 0.0f) {
-							debris.Speed.Y = -(0.8f/*elasticity*/ * debris.Speed.Y);
-							//OnHitFloorHook();
-						} else {
-							debris.Speed.Y = 0;
-							//OnHitCeilingHook();
-						}
-					}
+			_debris.Time[i] -= timeMult;
+			if (_debris.Time[i] <= 0.0f) {
+				_debris.AlphaSpeed[i] = -std::min(0.02f, _debris.Alpha[i]);
+			}
+		}
 
-					// If the actor didn't move all the way horizontally,
-					// it hit a wall (or was already touching it)
-					aabb = AABBf(debris.Pos.X - 1, ny - 1, debris.Pos.X + 1, ny + 1);
-					if (IsTileEmpty(aabb, params)) {
-						debris.Speed.X = -(0.8f/*elasticity*/ * debris.Speed.X);
-						debris.AngleSpeed = -(0.8f/*elasticity*/ * debris.AngleSpeed);
-						//OnHitWallHook();
-					}
-				}
+		if (size == 0) {
+			return;
+		}
+
+		UpdateDebrisCollisions(timeMult);
+
+		IntegrateAccelerated(_debris.PosX.data(), _debris.SpeedX.data(), _debris.AccelerationX.data(), timeMult, 10.0f, size);
+		IntegrateAccelerated(_debris.PosY.data(), _debris.SpeedY.data(), _debris.AccelerationY.data(), timeMult, 10.0f, size);
+		IntegrateLinear(_debris.Scale.data(), _debris.ScaleSpeed.data(), timeMult, size);
+		IntegrateLinear(_debris.Angle.data(), _debris.AngleSpeed.data(), timeMult, size);
+		IntegrateLinear(_debris.Alpha.data(), _debris.AlphaSpeed.data(), timeMult, size);
+	}
+
+	void TileMap::UpdateDebrisCollisions(float timeMult)
+	{
+		// Debris that should collide with tilemap are checked all at once
+		_debrisCollisionIndices.clear();
+		_debrisCollisionQueries.clear();
+
+		std::int32_t size = _debris.Count();
+		for (std::int32_t i = 0; i < size; i++) {
+			if ((_debris.Flags[i] & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
+				float nx = _debris.PosX[i] + _debris.SpeedX[i] * timeMult;
+				float ny = _debris.PosY[i] + _debris.SpeedY[i] * timeMult;
+				_debrisCollisionIndices.push_back(i);
+				_debrisCollisionQueries.emplace_back(nx - 1, ny - 1, nx + 1, ny + 1);
 			}
+		}
+
+		if (_debrisCollisionQueries.empty()) {
+			return;
+		}
 
-			debris.Pos.X += debris.Speed.X * timeMult + 0.5f * debris.Acceleration.X * timeMult * timeMult;
-			debris.Pos.Y += debris.Speed.Y * timeMult + 0.5f * debris.Acceleration.Y * timeMult * timeMult;
+		TileCollisionParams params = { TileDestructType::None, true };
+		_debrisCollisionResults.resize_for_overwrite(_debrisCollisionQueries.size());
+		AreTilesEmpty(arrayView(_debrisCollisionQueries.data(), _debrisCollisionQueries.size()), arrayView(_debrisCollisionResults.data(), _debrisCollisionResults.size()), params);
 
-			if (debris.Acceleration.X != 0.0f) {
-				debris.Speed.X = std::min(debris.Speed.X + debris.Acceleration.X * timeMult, 10.0f);
+		// Only bouncing debris that collided need to find out the direction of the collision
+		std::int32_t bounceCount = 0;
+		std::int32_t collisionCount = (std::int32_t)_debrisCollisionIndices.size();
+		for (std::int32_t j = 0; j < collisionCount; j++) {
+			if (_debrisCollisionResults[j]) {
+				continue;
 			}
-			if (debris.Acceleration.Y != 0.0f) {
-				debris.Speed.Y = std::min(debris.Speed.Y + debris.Acceleration.Y * timeMult, 10.0f);
+
+			std::int32_t i = _debrisCollisionIndices[j];
+			if ((_debris.Flags[i] & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
+				_debris.ScaleSpeed[i] = -0.02f;
+				_debris.AlphaSpeed[i] = -0.006f;
+				_debris.SpeedX[i] = 0.0f;
+				_debris.SpeedY[i] = 0.0f;
+				_debris.AccelerationX[i] = 0.0f;
+				_debris.AccelerationY[i] = 0.0f;
+			} else {
+				_debrisCollisionIndices[bounceCount++] = i;
 			}
+		}
 
-			debris.Scale += debris.ScaleSpeed * timeMult;
-			debris.Angle += debris.AngleSpeed * timeMult;
-			debris.Alpha += debris.AlphaSpeed * timeMult;
+		if (bounceCount == 0) {
+			return;
+		}
+
+		_debrisCollisionIndices.resize(bounceCount);
+		_debrisCollisionQueries.clear();
+		for (std::int32_t i : _debrisCollisionIndices) {
+			float nx = _debris.PosX[i] + _debris.SpeedX[i] * timeMult;
+			float ny = _debris.PosY[i] + _debris.SpeedY[i] * timeMult;
+			// Place us to the ground only if no horizontal movement was
+			// involved (this prevents speeds resetting if the actor
+			// collides with a wall from the side while in the air)
+			_debrisCollisionQueries.emplace_back(nx - 1, _debris.PosY[i] - 1, nx + 1, _debris.PosY[i] + 1);
+			// If the actor didn't move all the way horizontally,
+			// it hit a wall (or was already touching it)
+			_debrisCollisionQueries.emplace_back(_debris.PosX[i] - 1, ny - 1, _debris.PosX[i] + 1, ny + 1);
+		}
+
+		_debrisCollisionResults.resize_for_overwrite(_debrisCollisionQueries.size());
+		AreTilesEmpty(arrayView(_debrisCollisionQueries.data(), _debrisCollisionQueries.size()), arrayView(_debrisCollisionResults.data(), _debrisCollisionResults.size()), params);
+
+		for (std::int32_t j = 0; j < bounceCount; j++) {
+			std::int32_t i = _debrisCollisionIndices[j];
+			if (_debrisCollisionResults[j * 2]) {
+				if (_debris.SpeedY[i] > 0.0f) {
+					_debris.SpeedY[i] = -(0.8f/*elasticity*/ * _debris.SpeedY[i]);
+					//OnHitFloorHook();
+				} else {
+					_debris.SpeedY[i] = 0;
+					//OnHitCeilingHook();
+				}
+			}
+			if (_debrisCollisionResults[j * 2 + 1]) {
+				_debris.SpeedX[i] = -(0.8f/*elasticity*/ * _debris.SpeedX[i]);
+				_debris.AngleSpeed[i] = -(0.8f/*elasticity*/ * _debris.AngleSpeed[i]);
+				//OnHitWallHook();
+			}
 		}
 	}
 
@@ -1281,37 +1727,91 @@ namespace Jazz2::Tiles
 		viewportRect.W += MaxDebrisSize * 2.0f;
 		viewportRect.H += MaxDebrisSize * 2.0f;
 
-		for (const auto& debris : _debrisList) {
-			if (!viewportRect.Contains(debris.Pos)) {
+		std::int32_t size = _debris.Count();
+		for (std::int32_t i = 0; i < size; i++) {
+			Vector2f pos = Vector2f(_debris.PosX[i], _debris.PosY[i]);
+			if (!viewportRect.Contains(pos)) {
 				continue;
 			}
 
+			const DebrisAppearance& appearance = _debris.Appearance[i];
+
 			auto command = RentRenderCommand(LayerRendererType::Default);
 			command->setType(RenderCommand::CommandTypes::Particle);
 
-			if ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
+			if ((_debris.Flags[i] & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
 			} else {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			}
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			command->setInstanceTexRect(appearance.TexScaleX, appearance.TexBiasX, appearance.TexScaleY, appearance.TexBiasY);
+			command->setInstanceSpriteSize(appearance.Size.X, appearance.Size.Y);
+			command->setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, _debris.Alpha[i]).Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
-			worldMatrix.RotateZ(debris.Angle);
-			worldMatrix.Scale(debris.Scale, debris.Scale, 1.0f);
-			worldMatrix.Translate(debris.Size.X  * -0.5f, debris.Size.Y * -0.5f, 0.0f);
+			Matrix4x4f worldMatrix = Matrix4x4f::Translation(pos.X, pos.Y, 0.0f);
+			worldMatrix.RotateZ(_debris.Angle[i]);
+			worldMatrix.Scale(_debris.Scale[i], _debris.Scale[i], 1.0f);
+			worldMatrix.Translate(appearance.Size.X * -0.5f, appearance.Size.Y * -0.5f, 0.0f);
 			command->setTransformation(worldMatrix);
-			command->setLayer(debris.Depth);
-			command->material().setTexture(*debris.DiffuseTexture);
+			command->setLayer(appearance.Depth);
+			command->material().setTexture(*appearance.DiffuseTexture);
 
 			renderQueue.addCommand(command);
 		}
 	}
 
+	void TileMap::DebrisStorage::Add(const DestructibleDebris& debris)
+	{
+		PosX.push_back(debris.Pos.X);
+		PosY.push_back(debris.Pos.Y);
+		SpeedX.push_back(debris.Speed.X);
+		SpeedY.push_back(debris.Speed.Y);
+		AccelerationX.push_back(debris.Acceleration.X);
+		AccelerationY.push_back(debris.Acceleration.Y);
+		Scale.push_back(debris.Scale);
+		ScaleSpeed.push_back(debris.ScaleSpeed);
+		Angle.push_back(debris.Angle);
+		AngleSpeed.push_back(debris.AngleSpeed);
+		Alpha.push_back(debris.Alpha);
+		AlphaSpeed.push_back(debris.AlphaSpeed);
+		Time.push_back(debris.Time);
+		Flags.push_back(debris.Flags);
+
+		DebrisAppearance& appearance = Appearance.emplace_back();
+		appearance.Size = debris.Size;
+		appearance.TexScaleX = debris.TexScaleX;
+		appearance.TexBiasX = debris.TexBiasX;
+		appearance.TexScaleY = debris.TexScaleY;
+		appearance.TexBiasY = debris.TexBiasY;
+		appearance.DiffuseTexture = debris.DiffuseTexture;
+		appearance.Depth = debris.Depth;
+	}
+
+	void TileMap::DebrisStorage::RemoveAt(std::int32_t index)
+	{
+		auto removeAt = [index](auto& array) {
+			array[index] = array.back();
+			array.pop_back();
+		};
+
+		removeAt(PosX);
+		removeAt(PosY);
+		removeAt(SpeedX);
+		removeAt(SpeedY);
+		removeAt(AccelerationX);
+		removeAt(AccelerationY);
+		removeAt(Scale);
+		removeAt(ScaleSpeed);
+		removeAt(Angle);
+		removeAt(AngleSpeed);
+		removeAt(Alpha);
+		removeAt(AlphaSpeed);
+		removeAt(Time);
+		removeAt(Flags);
+		removeAt(Appearance);
+	}
+
 	bool TileMap::GetTrigger(std::uint8_t triggerId)
 	{
 		return _triggerState[triggerId];
@@ -1325,21 +1825,19 @@ namespace Jazz2::Tiles
 
 		_triggerState.Set(triggerId, newState);
 
-		// Go through all tiles and update any that are influenced by this trigger
-		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
-		std::int32_t n = layoutSize.X * layoutSize.Y;
-		for (std::int32_t i = 0; i < n; i++) {
-			LayerTile& tile = _layers[_sprLayerIndex].Layout[i];
-			if (tile.DestructType == TileDestructType::Trigger && tile.TileParams == triggerId) {
-				if (_animatedTiles[tile.DestructAnimation].Tiles.size() > 1) {
-					tile.DestructFrameIndex = (newState ? 1 : 0);
-					tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[tile.DestructFrameIndex].TileID;
+		// Go through all destructible tiles and update any that are influenced by this trigger
+		for (auto& [index, destructible] : _destructibleTiles) {
+			if (destructible.Type == TileDestructType::Trigger && destructible.Params == triggerId) {
+				if (_animatedTiles[destructible.Animation].Tiles.size() > 1) {
+					destructible.FrameIndex = (newState ? 1 : 0);
+					_layers[_sprLayerIndex].Layout[index].TileID = (std::uint16_t)_animatedTiles[destructible.Animation].Tiles[destructible.FrameIndex].TileID;
+					InvalidateRenderChunk(_layers[_sprLayerIndex], index % _layers[_sprLayerIndex].LayoutSize.X, index / _layers[_sprLayerIndex].LayoutSize.X);
 				}
 			}
 		}
 	}
 
-	void TileMap::InitializeFromStream(Stream& src)
+	void TileMap::InitializeFromStream(Stream& src, bool legacyFormat)
 	{
 		std::int32_t layoutSize = src.ReadVariableInt32();
 		if (layoutSize == -1) {
@@ -1352,17 +1850,37 @@ namespace Jazz2::Tiles
 		std::int32_t realLayoutSize = spriteLayer.LayoutSize.X * spriteLayer.LayoutSize.Y;
 		RETURN_ASSERT_MSG(layoutSize == realLayoutSize, "Layout size mismatch");
 
-		for (std::int32_t i = 0; i < layoutSize; i++) {
-			auto& tile = spriteLayer.Layout[i];
-			tile.DestructFrameIndex = src.ReadVariableInt32();
-			if (tile.DestructFrameIndex > 0) {
-				auto& anim = _animatedTiles[tile.DestructAnimation];
-				std::int32_t max = (std::int32_t)(anim.Tiles.size() - 2);
-				if (tile.DestructFrameIndex > max) {
-					LOGW("Serialized tile %i with animation frame %i is out of range", i, tile.DestructFrameIndex);
-					tile.DestructFrameIndex = max;
+		if (legacyFormat) {
+			// Frame index of all tiles of the sprite layer was saved in older versions
+			for (std::int32_t i = 0; i < layoutSize; i++) {
+				std::int32_t frameIndex = src.ReadVariableInt32();
+				DestructibleTile* destructible = GetDestructibleTile(spriteLayer.Layout[i], i);
+				if (destructible != nullptr && frameIndex != destructible->FrameIndex) {
+					RestoreDestructibleTile(i, *destructible, frameIndex);
+				}
+			}
+		} else {
+			// Only modified tiles are saved, all other tiles are in their original state
+			for (auto& [index, destructible] : _destructibleTiles) {
+				if (destructible.FrameIndex != 0) {
+					RestoreDestructibleTile(index, destructible, 0);
+				}
+			}
+
+			std::int32_t modifiedCount = src.ReadVariableInt32();
+			std::int32_t index = 0;
+			for (std::int32_t i = 0; i < modifiedCount; i++) {
+				index += src.ReadVariableInt32();
+				std::int32_t frameIndex = src.ReadVariableInt32();
+				if (index < 0 || index >= layoutSize) {
+					LOGW("Serialized tile %i is out of range", index);
+					break;
+				}
+
+				DestructibleTile* destructible = GetDestructibleTile(spriteLayer.Layout[index], index);
+				if (destructible != nullptr) {
+					RestoreDestructibleTile(index, *destructible, frameIndex);
 				}
-				tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
 			}
 		}
 
@@ -1372,20 +1890,49 @@ namespace Jazz2::Tiles
 	void TileMap::SerializeResumableToStream(Stream& dest)
 	{
 		if (_sprLayerIndex == -1) {
-			dest.WriteValue<std::int32_t>(-1);
+			dest.WriteVariableInt32(-1);
 			return;
 		}
 
 		auto& spriteLayer = _layers[_sprLayerIndex];
 		std::int32_t layoutSize = spriteLayer.LayoutSize.X * spriteLayer.LayoutSize.Y;
 		dest.WriteVariableInt32(layoutSize);
-		for (std::int32_t i = 0; i < layoutSize; i++) {
-			dest.WriteVariableInt32(spriteLayer.Layout[i].DestructFrameIndex);
+
+		// Only tiles that differ from the original state are saved, they are sorted by index, so the index can be delta-encoded
+		SmallVector<std::pair<std::int32_t, std::int32_t>, 0> modifiedTiles;
+		for (auto& [index, destructible] : _destructibleTiles) {
+			if (destructible.FrameIndex != 0) {
+				modifiedTiles.emplace_back(index, destructible.FrameIndex);
+			}
+		}
+		std::sort(modifiedTiles.begin(), modifiedTiles.end());
+
+		dest.WriteVariableInt32((std::int32_t)modifiedTiles.size());
+		std::int32_t lastIndex = 0;
+		for (auto& [index, frameIndex] : modifiedTiles) {
+			dest.WriteVariableInt32(index - lastIndex);
+			dest.WriteVariableInt32(frameIndex);
+			lastIndex = index;
 		}
 
 		dest.Write(_triggerState.RawData(), _triggerState.SizeInBytes());
 	}
 
+	void TileMap::RestoreDestructibleTile(std::int32_t index, DestructibleTile& destructible, std::int32_t frameIndex)
+	{
+		auto& anim = _animatedTiles[destructible.Animation];
+		std::int32_t max = (std::int32_t)(anim.Tiles.size() - 1);
+		if (frameIndex < 0 || frameIndex > max) {
+			LOGW("Serialized tile %i with animation frame %i is out of range", index, frameIndex);
+			frameIndex = std::clamp(frameIndex, 0, max);
+		}
+
+		auto& spriteLayer = _layers[_sprLayerIndex];
+		destructible.FrameIndex = frameIndex;
+		spriteLayer.Layout[index].TileID = (std::uint16_t)anim.Tiles[frameIndex].TileID;
+		InvalidateRenderChunk(spriteLayer, index % spriteLayer.LayoutSize.X, index / spriteLayer.LayoutSize.X);
+	}
+
 	void TileMap::RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y)
 	{
 		auto target = _texturedBackgroundPass._target.get();
@@ -1398,10 +1945,9 @@ namespace Jazz2::Tiles
 
 		auto* command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto* instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue((float)viewSize.X, (float)viewSize.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command->setInstanceSpriteSize((float)viewSize.X, (float)viewSize.Y);
+		command->setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue((float)viewSize.X, (float)viewSize.Y);
 		command->material().uniform("uCameraPos")->setFloatVector(viewCenter.Data());
@@ -1450,6 +1996,73 @@ namespace Jazz2::Tiles
 		return tileId;
 	}
 
+	bool TileMap::ChangesDestructibleTiles(const TileCollisionParams& params)
+	{
+		// Destructible tiles are changed while checking, so such queries have to check all positions one by one
+		return ((params.DestructType & (TileDestructType::Weapon | TileDestructType::Speed | TileDestructType::Collapse | TileDestructType::Special)) != TileDestructType::None);
+	}
+
+	bool TileMap::IsOutOfLevel(const AABBf& aabb, Vector2i layoutSize, bool& isEmpty) const
+	{
+		// Consider out-of-level coordinates as solid walls
+		if (aabb.L < 0 || aabb.R >= layoutSize.X * TileSet::DefaultTileSize) {
+			isEmpty = false;
+			return true;
+		}
+		if (aabb.B >= layoutSize.Y * TileSet::DefaultTileSize) {
+			isEmpty = (_pitType != PitType::StandOnPlatform);
+			return true;
+		}
+		return false;
+	}
+
+	TileMap::PixelRange TileMap::GetCoveredPixels(const AABBf& aabb, Vector2i layoutSize)
+	{
+		PixelRange range;
+		range.X1 = std::max((std::int32_t)aabb.L, 0);
+		range.X2 = std::min((std::int32_t)std::ceil(aabb.R), layoutSize.X * TileSet::DefaultTileSize - 1);
+		range.Y1 = std::max((std::int32_t)aabb.T, 0);
+		range.Y2 = std::min((std::int32_t)std::ceil(aabb.B), layoutSize.Y * TileSet::DefaultTileSize - 1);
+
+		if (range.Y2 <= 0) {
+			range.Y1 = 0;
+			range.Y2 = 1;
+		}
+		return range;
+	}
+
+	bool TileMap::ResolveSolidTile(LayerTile& tile, bool downwards, SolidTile& result)
+	{
+		if ((tile.Flags & LayerTileFlags::SuspendMask) != LayerTileFlags::None || ((tile.Flags & LayerTileFlags::OneWay) == LayerTileFlags::OneWay && !downwards)) {
+			return false;
+		}
+
+		std::int32_t tileId = ResolveTileID(tile);
+		TileSet* tileSet = ResolveTileSet(tileId);
+		if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
+			return false;
+		}
+
+		result.Set = tileSet;
+		result.TileId = tileId;
+		result.FlipX = ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX);
+		result.FlipY = ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY);
+		return true;
+	}
+
+	bool TileMap::IsTileMaskSetInRange(const SolidTile& solidTile, std::int32_t x, std::int32_t y, const PixelRange& range)
+	{
+		std::int32_t tx = x * TileSet::DefaultTileSize;
+		std::int32_t ty = y * TileSet::DefaultTileSize;
+
+		std::int32_t left = std::max(range.X1 - tx, 0);
+		std::int32_t right = std::min(range.X2 - tx, TileSet::DefaultTileSize - 1);
+		std::int32_t top = std::max(range.Y1 - ty, 0);
+		std::int32_t bottom = std::min(range.Y2 - ty, TileSet::DefaultTileSize - 1);
+
+		return solidTile.Set->IsTileMaskSet(solidTile.TileId, solidTile.FlipX, solidTile.FlipY, left, top, right, bottom);
+	}
+
 	void TileMap::TexturedBackgroundPass::Initialize()
 	{
 		bool notInitialized = (_view == nullptr);
@@ -1505,13 +2118,18 @@ namespace Jazz2::Tiles
 	{
 		TileMapLayer& layer = _owner->_layers[_owner->_texturedBackgroundLayer];
 		Vector2i layoutSize = layer.LayoutSize;
+		_owner->LoadLayerChunks(layer, 0, 0, layoutSize.X, layoutSize.Y);
 
 		std::int32_t renderCommandIndex = 0;
 		bool isAnimated = false;
 
 		for (std::int32_t y = 0; y < layoutSize.Y; y++) {
 			for (std::int32_t x = 0; x < layoutSize.X; x++) {
-				LayerTile& tile = layer.Layout[x + y * layer.LayoutSize.X];
+				LayerTile* tilePtr = layer.GetTile(x, y);
+				if (tilePtr == nullptr) {
+					continue;
+				}
+				LayerTile& tile = *tilePtr;
 
 				std::int32_t tileId = _owner->ResolveTileID(tile);
 				if (tileId == 0) {
@@ -1540,10 +2158,9 @@ namespace Jazz2::Tiles
 					texScaleY *= -1;
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->setInstanceSpriteSize(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->setInstanceColor(Colorf::White.Data());
 
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize, 0.0f));
 				command->material().setTexture(*tileSet->TextureDiffuse);
@@ -6,9 +6,12 @@
 #include "../SuspendType.h"
 #include "TileSet.h"
 
+#include "../../nCine/Base/HashMap.h"
 #include "../../nCine/Graphics/Camera.h"
 #include "../../nCine/Graphics/Viewport.h"
 
+#include <Containers/ArrayView.h>
+#include <IO/BufferedStream.h>
 #include <IO/Stream.h>
 
 using namespace Death::IO;
@@ -59,23 +62,68 @@ namespace Jazz2::Tiles
 		FlipX = 0x01,
 		FlipY = 0x02,
 		Animated = 0x04,
+		Destructible = 0x08,	// Destructible state is stored separately in TileMap
 
 		OneWay = 0x10,
-		Hurt = 0x20
+		Hurt = 0x20,
+
+		SuspendVine = 0x40,
+		SuspendHook = 0x80,
+		SuspendMask = 0xC0
 	};
 
 	DEFINE_ENUM_OPERATORS(LayerTileFlags);
 
+	/** @brief Tile of a tile map layer, it's packed to 4 bytes, so the layout of the whole layer can stay in cache */
 	struct LayerTile {
-		std::int32_t TileID;
-		std::uint16_t TileParams;
+		std::uint16_t TileID;				// Tile index, or animated tile index if LayerTileFlags::Animated is set
 		LayerTileFlags Flags;
 		std::uint8_t Alpha;
-		SuspendType HasSuspendType;
-		TileDestructType DestructType;
-		std::int32_t DestructAnimation;		// Animation index for a destructible tile that uses an animation, but doesn't animate normally
-		std::int32_t DestructFrameIndex;	// Denotes the specific frame from the above animation that is currently active
-											// Collapsible: Delay ("wait" parameter); Trigger: Trigger ID
+
+		SuspendType GetSuspendType() const {
+			return (SuspendType)((std::uint8_t)(Flags & LayerTileFlags::SuspendMask) >> 6);
+		}
+
+		void SetSuspendType(SuspendType value) {
+			Flags = (Flags & ~LayerTileFlags::SuspendMask) | (LayerTileFlags)(((std::uint8_t)value << 6) & (std::uint8_t)LayerTileFlags::SuspendMask);
+		}
+	};
+
+	static_assert(sizeof(LayerTile) == 4, "LayerTile should be packed to 4 bytes");
+
+	/** @brief Independently compressed rectangular part of a tile map layer */
+	struct TileMapLayerChunk {
+		/** @brief Compressed tiles, they are released once the chunk is decompressed */
+		std::unique_ptr<std::uint8_t[]> CompressedData;
+		/** @brief Offset of compressed data in the chunk data of the level */
+		std::uint32_t Offset;
+		/** @brief Size of compressed data, `0` if all tiles of the chunk are empty */
+		std::uint32_t Size;
+		/** @brief Decompressed tiles with stride of the chunk size, `nullptr` if all tiles are empty or the chunk is not loaded yet */
+		std::unique_ptr<LayerTile[]> Tiles;
+		bool Loaded;
+	};
+
+	/** @brief Cached vertices of all tiles in a render chunk that share the same texture and alpha */
+	struct TileMapRenderBatch {
+		Texture* DiffuseTexture;
+		std::uint8_t Alpha;
+		/** @brief Triangle strip of positions and texture coordinates, quads of tiles are joined by degenerate triangles */
+		SmallVector<float, 0> Vertices;
+		/** @brief Render commands of the batch, there is more than one only if a repeating layer shows the chunk multiple times */
+		SmallVector<std::unique_ptr<RenderCommand>, 1> Commands;
+		std::uint32_t LastDrawIndex;
+		std::size_t UsedCommands;
+	};
+
+	/** @brief Rectangular part of a tile map layer with cached geometry, it's rebuilt only if any of its tiles changed */
+	struct TileMapRenderChunk {
+		SmallVector<TileMapRenderBatch, 1> Batches;
+		/** @brief Animated tiles in the chunk with their current frames at the time the geometry was built */
+		SmallVector<Vector2i, 0> AnimatedTiles;
+		bool IsDirty;
+
+		TileMapRenderChunk() : IsDirty(true) { }
 	};
 
 	struct TileMapLayer {
@@ -85,6 +133,31 @@ namespace Jazz2::Tiles
 		Vector2i LayoutSize;
 
 		LayerDescription Description;
+
+		/** @brief Chunks that are decompressed on demand instead of @ref Layout, empty if the whole layout was loaded at once */
+		SmallVector<TileMapLayerChunk, 0> Chunks;
+		std::int32_t ChunkSize;
+		std::int32_t ChunksPerRow;
+		std::int32_t PendingChunkCount;
+
+		/** @brief Render chunks of @ref Layout, they are allocated on the first draw */
+		SmallVector<TileMapRenderChunk, 0> RenderChunks;
+		std::int32_t RenderChunksPerRow;
+
+		/** @brief Returns a tile at specified position, or `nullptr` if it's in an empty chunk or in a chunk that is not loaded yet */
+		LayerTile* GetTile(std::int32_t x, std::int32_t y) {
+			if (Layout != nullptr) {
+				return &Layout[x + y * LayoutSize.X];
+			}
+			if (Chunks.empty()) {
+				return nullptr;
+			}
+			auto& chunk = Chunks[(x / ChunkSize) + (y / ChunkSize) * ChunksPerRow];
+			if (chunk.Tiles == nullptr) {
+				return nullptr;
+			}
+			return &chunk.Tiles[(x % ChunkSize) + (y % ChunkSize) * ChunkSize];
+		}
 	};
 
 	struct AnimatedTileFrame {
@@ -109,6 +182,10 @@ namespace Jazz2::Tiles
 		static constexpr std::int32_t TriggerCount = 32;
 		static constexpr std::int32_t AnimatedTileMask = 0x80000000;
 		static constexpr std::int32_t HardcodedOffset = 70;
+		/** @brief Size of independently compressed layer chunks in tiles */
+		static constexpr std::int32_t LayerChunkSize = 64;
+		/** @brief Size of render chunks with cached geometry in tiles */
+		static constexpr std::int32_t RenderChunkSize = 16;
 
 		enum class DebrisFlags {
 			None = 0x00,
@@ -164,14 +241,20 @@ namespace Jazz2::Tiles
 
 		bool IsTileEmpty(std::int32_t tx, std::int32_t ty);
 		bool IsTileEmpty(const AABBf& aabb, TileCollisionParams& params);
+		/** @brief Returns index of the first offset where the moved AABB doesn't collide with tiles, or -1 if there is none */
+		std::int32_t FindFirstEmpty(const AABBf& aabb, ArrayView<const Vector2f> offsets, TileCollisionParams& params);
+		/** @brief Checks multiple AABBs at once, solidity of each tile is resolved only once for consecutive AABBs in the same tile */
+		void AreTilesEmpty(ArrayView<const AABBf> aabbs, ArrayView<bool> results, TileCollisionParams& params);
 		bool CanBeDestroyed(const AABBf& aabb, TileCollisionParams& params);
 		bool IsTileHurting(float x, float y);
 		SuspendType GetTileSuspendState(float x, float y);
 		bool AdvanceDestructibleTileAnimation(std::int32_t tx, std::int32_t ty, std::int32_t amount);
 
 		void AddTileSet(const StringView tileSetPath, std::uint16_t offset, std::uint16_t count, const std::uint8_t* paletteRemapping = nullptr);
-		void ReadLayerConfiguration(Stream& s);
-		void ReadAnimatedTiles(Stream& s);
+		void ReadLayerConfiguration(BufferedStream& s);
+		void ReadAnimatedTiles(BufferedStream& s);
+		/** @brief Reads compressed chunk data of all chunked layers, it must be called after all layers were read */
+		void ReadLayerChunkData(Stream& s);
 		void SetTileEventFlags(std::int32_t x, std::int32_t y, EventType tileEvent, std::uint8_t* tileParams);
 
 		Color* GetCaptionTile() const
@@ -187,7 +270,9 @@ namespace Jazz2::Tiles
 		bool GetTrigger(std::uint8_t triggerId);
 		void SetTrigger(std::uint8_t triggerId, bool newState);
 
-		void InitializeFromStream(Stream& src);
+		/** @brief Restores modified tiles and triggers, if @p legacyFormat is set, the stream contains state of all tiles of the sprite layer */
+		void InitializeFromStream(Stream& src, bool legacyFormat = false);
+		/** @brief Saves tiles that differ from the original state of the level and triggers */
 		void SerializeResumableToStream(Stream& dest);
 
 		void OnInitializeViewport();
@@ -205,6 +290,63 @@ namespace Jazz2::Tiles
 			std::int32_t Count;
 		};
 
+		struct DestructibleTile {
+			TileDestructType Type;
+			std::uint16_t Params;		// Collapsible: Delay ("wait" parameter); Trigger: Trigger ID
+			std::int32_t Animation;		// Animation index for a destructible tile that uses an animation, but doesn't animate normally
+			std::int32_t FrameIndex;	// Denotes the specific frame from the above animation that is currently active
+		};
+
+		/** @brief Inclusive range of pixels covered by an AABB, clamped to the layout */
+		struct PixelRange {
+			std::int32_t X1, Y1, X2, Y2;
+		};
+
+		/** @brief Resolved tile that can collide */
+		struct SolidTile {
+			TileSet* Set;
+			std::int32_t TileId;
+			bool FlipX;
+			bool FlipY;
+		};
+
+		struct DebrisAppearance {
+			Vector2f Size;
+			float TexScaleX;
+			float TexBiasX;
+			float TexScaleY;
+			float TexBiasY;
+			Texture* DiffuseTexture;
+			std::uint16_t Depth;
+		};
+
+		// Debris are stored as structure of arrays, so all of them can be integrated at once by vectorized kernels
+		struct DebrisStorage {
+			SmallVector<float, 0> PosX;
+			SmallVector<float, 0> PosY;
+			SmallVector<float, 0> SpeedX;
+			SmallVector<float, 0> SpeedY;
+			SmallVector<float, 0> AccelerationX;
+			SmallVector<float, 0> AccelerationY;
+			SmallVector<float, 0> Scale;
+			SmallVector<float, 0> ScaleSpeed;
+			SmallVector<float, 0> Angle;
+			SmallVector<float, 0> AngleSpeed;
+			SmallVector<float, 0> Alpha;
+			SmallVector<float, 0> AlphaSpeed;
+			SmallVector<float, 0> Time;
+			SmallVector<DebrisFlags, 0> Flags;
+			SmallVector<DebrisAppearance, 0> Appearance;
+
+			std::int32_t Count() const {
+				return (std::int32_t)PosX.size();
+			}
+
+			void Add(const DestructibleDebris& debris);
+			/** @brief Removes debris by moving the last one in its place */
+			void RemoveAt(std::int32_t index);
+		};
+
 		class TexturedBackgroundPass : public SceneNode
 		{
 			friend class TileMap;
@@ -235,32 +377,53 @@ namespace Jazz2::Tiles
 
 		SmallVector<TileSetPart, 2> _tileSets;
 		SmallVector<TileMapLayer, 0> _layers;
+		// Only a few tiles of the sprite layer are destructible, so their state is indexed by position in the layout
+		HashMap<std::int32_t, DestructibleTile> _destructibleTiles;
 		SmallVector<AnimatedTile, 0> _animatedTiles;
 		SmallVector<Vector2i, 0> _activeCollapsingTiles;
 		float _collapsingTimer;
 		BitArray _triggerState;
 
-		SmallVector<DestructibleDebris, 0> _debrisList;
+		DebrisStorage _debris;
+		SmallVector<std::int32_t, 0> _debrisCollisionIndices;
+		SmallVector<AABBf, 0> _debrisCollisionQueries;
+		SmallVector<bool, 0> _debrisCollisionResults;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		std::int32_t _renderCommandsCount;
+		std::uint32_t _drawIndex;
 
 		std::int32_t _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 
 		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer);
+		void LoadLayerChunks(TileMapLayer& layer, std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height);
+		void LoadLayerChunk(TileMapLayer& layer, std::int32_t chunkIndex);
 		static float TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY);
 		RenderCommand* RentRenderCommand(LayerRendererType type);
+		void DrawRenderChunk(RenderQueue& renderQueue, TileMapLayer& layer, std::int32_t chunkX, std::int32_t chunkY, float x, float y);
+		void BuildRenderChunk(TileMapLayer& layer, TileMapRenderChunk& chunk, std::int32_t chunkX, std::int32_t chunkY);
+		RenderCommand* RentRenderChunkCommand(TileMapRenderBatch& batch, LayerRendererType type);
+		void InvalidateRenderChunk(TileMapLayer& layer, std::int32_t tx, std::int32_t ty);
 
-		bool AdvanceDestructibleTileAnimation(LayerTile& tile, std::int32_t tx, std::int32_t ty, std::int32_t& amount, const StringView soundName);
+		DestructibleTile* GetDestructibleTile(const LayerTile& tile, std::int32_t index);
+		bool AdvanceDestructibleTileAnimation(LayerTile& tile, DestructibleTile& destructible, std::int32_t tx, std::int32_t ty, std::int32_t& amount, const StringView soundName);
 		void AdvanceCollapsingTileTimers(float timeMult);
-		void SetTileDestructibleEventParams(LayerTile& tile, TileDestructType type, std::uint16_t tileParams);
+		void SetTileDestructibleEventParams(LayerTile& tile, std::int32_t index, TileDestructType type, std::uint16_t tileParams);
+		void RestoreDestructibleTile(std::int32_t index, DestructibleTile& destructible, std::int32_t frameIndex);
 
 		void UpdateDebris(float timeMult);
+		void UpdateDebrisCollisions(float timeMult);
 		void DrawDebris(RenderQueue& renderQueue);
 
 		void RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y);
 
 		TileSet* ResolveTileSet(std::int32_t& tileId);
 		std::int32_t ResolveTileID(LayerTile& tile);
+
+		static bool ChangesDestructibleTiles(const TileCollisionParams& params);
+		bool IsOutOfLevel(const AABBf& aabb, Vector2i layoutSize, bool& isEmpty) const;
+		static PixelRange GetCoveredPixels(const AABBf& aabb, Vector2i layoutSize);
+		bool ResolveSolidTile(LayerTile& tile, bool downwards, SolidTile& result);
+		static bool IsTileMaskSetInRange(const SolidTile& solidTile, std::int32_t x, std::int32_t y, const PixelRange& range);
 	};
 }
\ No newline at end of file
@@ -2,8 +2,17 @@
 
 namespace Jazz2::Tiles
 {
+	static std::uint32_t ReverseBits(std::uint32_t value)
+	{
+		value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+		value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+		value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+		value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+		return (value >> 16) | (value << 16);
+	}
+
 	TileSet::TileSet(std::uint16_t tileCount, std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask, std::uint32_t maskSize, std::unique_ptr<Color[]> captionTile)
-		: TextureDiffuse(std::move(textureDiffuse)), _mask(std::move(mask)), _captionTile(std::move(captionTile)),
+		: TextureDiffuse(std::move(textureDiffuse)), _captionTile(std::move(captionTile)),
 			_isMaskEmpty(), _isMaskFilled(), _isTileFilled()
 	{
 		// TilesPerRow is used only for rendering
@@ -20,18 +29,34 @@ namespace Jazz2::Tiles
 		_isTileFilled.SetSize(TileCount);
 
 		std::uint32_t maskMaxTiles = maskSize / (DefaultTileSize * DefaultTileSize);
+		_rowMasks = std::make_unique<std::uint32_t[]>(std::size_t(tileCount) * 4 * DefaultTileSize);
 
 		for (std::uint32_t i = 0; i < tileCount; i++) {
 			bool maskEmpty = true;
 			bool maskFilled = true;
 
 			if (i < maskMaxTiles) {
-				auto maskOffset = &_mask[i * DefaultTileSize * DefaultTileSize];
-				for (std::int32_t x = 0; x < DefaultTileSize * DefaultTileSize; x++) {
-					bool masked = (maskOffset[x] > 0);
-					maskEmpty &= !masked;
-					maskFilled &= masked;
+				auto maskOffset = &mask[i * DefaultTileSize * DefaultTileSize];
+				std::uint32_t* rows = &_rowMasks[i * 4 * DefaultTileSize];
+				for (std::int32_t y = 0; y < DefaultTileSize; y++) {
+					std::uint32_t row = 0;
+					for (std::int32_t x = 0; x < DefaultTileSize; x++) {
+						if (maskOffset[y * DefaultTileSize + x] > 0) {
+							row |= (1u << x);
+						}
+					}
+
+					std::uint32_t rowFlipped = ReverseBits(row);
+					rows[y] = row;
+					rows[DefaultTileSize + y] = rowFlipped;
+					rows[2 * DefaultTileSize + (DefaultTileSize - 1 - y)] = row;
+					rows[3 * DefaultTileSize + (DefaultTileSize - 1 - y)] = rowFlipped;
+
+					maskEmpty &= (row == 0);
+					maskFilled &= (row == 0xFFFFFFFFu);
 				}
+			} else {
+				maskFilled = false;
 			}
 
 			if (maskEmpty) {
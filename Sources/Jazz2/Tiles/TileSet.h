@@ -16,13 +16,31 @@ namespace Jazz2::Tiles
 		std::int32_t TileCount;
 		std::int32_t TilesPerRow;
 
-		std::uint8_t* GetTileMask(std::int32_t tileId) const
+		/** @brief Returns collision mask of a tile as one 32-bit word per row, the least significant bit is the leftmost pixel */
+		const std::uint32_t* GetTileRowMask(std::int32_t tileId, bool flipX, bool flipY) const
 		{
 			if (tileId >= TileCount) {
 				return nullptr;
 			}
 
-			return &_mask[tileId * DefaultTileSize * DefaultTileSize];
+			return &_rowMasks[(tileId * 4 + (flipX ? 1 : 0) + (flipY ? 2 : 0)) * DefaultTileSize];
+		}
+
+		/** @brief Returns `true` if any pixel of the tile mask is set in a given inclusive rectangle (in already flipped coordinates) */
+		bool IsTileMaskSet(std::int32_t tileId, bool flipX, bool flipY, std::int32_t left, std::int32_t top, std::int32_t right, std::int32_t bottom) const
+		{
+			if (tileId >= TileCount || left > right || top > bottom) {
+				return false;
+			}
+
+			const std::uint32_t* rows = &_rowMasks[(tileId * 4 + (flipX ? 1 : 0) + (flipY ? 2 : 0)) * DefaultTileSize];
+			std::uint32_t columns = (0xFFFFFFFFu >> (DefaultTileSize - 1 - right + left)) << left;
+			for (std::int32_t y = top; y <= bottom; y++) {
+				if ((rows[y] & columns) != 0) {
+					return true;
+				}
+			}
+			return false;
 		}
 
 		bool IsTileMaskEmpty(std::int32_t tileId) const
@@ -58,7 +76,10 @@ namespace Jazz2::Tiles
 		}
 
 	private:
-		std::unique_ptr<uint8_t[]> _mask;
+		static_assert(DefaultTileSize == 32, "Tile row mask must fit into 32-bit integer");
+
+		// Normal, X-flipped, Y-flipped and XY-flipped variant of each tile
+		std::unique_ptr<std::uint32_t[]> _rowMasks;
 		std::unique_ptr<Color[]> _captionTile;
 		BitArray _isMaskEmpty;
 		BitArray _isMaskFilled;
@@ -54,10 +54,9 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->setInstanceTexRect(texCoords.Data());
+		command->setInstanceSpriteSize(size.Data());
+		command->setInstanceColor(color.Data());
 
 		Matrix4x4f worldMatrix = Matrix4x4f::Translation(pos.X, pos.Y, 0.0f);
 		if (std::abs(angle) > 0.01f) {
@@ -88,9 +87,8 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->setInstanceSpriteSize(size.Data());
+		command->setInstanceColor(color.Data());
 
 		command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
 		command->setLayer(z);
@@ -284,6 +284,7 @@ namespace Jazz2::UI
 		// Create copy of the buffer
 		std::memcpy(_lastBuffer.get(), _buffer.get(), _width * _height);
 
+#if defined(WITH_AUDIO)
 		for (std::size_t i = 0; i < _sfxPlaylist.size(); i++) {
 			if (_sfxPlaylist[i].Frame == _frameIndex) {
 				auto& item = _sfxPlaylist[i];
@@ -299,6 +300,7 @@ namespace Jazz2::UI
 				item.CurrentPlayer->play();
 			}
 		}
+#endif
 
 		_frameIndex++;
 	}
@@ -369,10 +371,9 @@ namespace Jazz2::UI
 		frameOffset.X = std::round(frameOffset.X);
 		frameOffset.Y = std::round(frameOffset.Y);
 
-		auto* instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(frameSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		_renderCommand.setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		_renderCommand.setInstanceSpriteSize(frameSize.Data());
+		_renderCommand.setInstanceColor(Colorf::White.Data());
 
 		_renderCommand.setTransformation(Matrix4x4f::Translation(frameOffset.X, frameOffset.Y, 0.0f));
 		_renderCommand.material().setTexture(*_owner->_texture);
@@ -387,7 +388,9 @@ namespace Jazz2::UI
 	}
 
 	Cinematics::SfxItem::SfxItem(std::unique_ptr<Stream> stream, const StringView path)
+#if defined(WITH_AUDIO)
 		: Buffer(std::make_unique<AudioBuffer>(std::move(stream), path))
+#endif
 	{
 	}
 }
\ No newline at end of file
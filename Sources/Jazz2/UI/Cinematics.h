@@ -60,7 +60,9 @@ namespace Jazz2::UI
 		};
 
 		struct SfxItem {
+#if defined(WITH_AUDIO)
 			std::unique_ptr<AudioBuffer> Buffer;
+#endif
 
 			SfxItem();
 			SfxItem(std::unique_ptr<Stream> stream, const StringView path);
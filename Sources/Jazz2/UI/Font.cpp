@@ -478,10 +478,9 @@ namespace Jazz2::UI
 
 					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(charWidth * scale, uvRect.H * scale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+					command->setInstanceTexRect(texCoords.Data());
+					command->setInstanceSpriteSize(charWidth * scale, uvRect.H * scale);
+					command->setInstanceColor(color.Data());
 
 					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
 					command->setLayer(z - (charOffset & 1));
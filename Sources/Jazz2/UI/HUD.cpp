@@ -279,10 +279,9 @@ namespace Jazz2::UI
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(Vector4f(1.0f, 0.0f, 1.0f, 0.0f).Data());
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
+			command->setInstanceTexRect(Vector4f(1.0f, 0.0f, 1.0f, 0.0f).Data());
+			command->setInstanceSpriteSize(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
+			command->setInstanceColor(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
 
 			command->setTransformation(Matrix4x4f::Identity);
 			command->setLayer(999);
@@ -1203,10 +1202,9 @@ namespace Jazz2::UI
 
 		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(1.0f, 1.0f);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command->setInstanceSpriteSize(1.0f, 1.0f);
+		command->setInstanceColor(color.Data());
 
 		command->setTransformation(Matrix4x4f::Identity);
 		command->setLayer(z);
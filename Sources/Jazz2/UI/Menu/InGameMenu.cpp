@@ -278,6 +278,7 @@ namespace Jazz2::UI::Menu
 			_root->OnInitializeViewport(res.X, res.Y);
 		}
 
+#if defined(WITH_AUDIO)
 		if ((type & ChangedPreferencesType::Audio) == ChangedPreferencesType::Audio) {
 			if (_root->_music != nullptr) {
 				_root->_music->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
@@ -286,6 +287,7 @@ namespace Jazz2::UI::Menu
 				_root->_sugarRushMusic->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
 			}
 		}
+#endif
 
 		if ((type & ChangedPreferencesType::Language) == ChangedPreferencesType::Language) {
 			// All sections have to be recreated to load new language
@@ -390,6 +392,7 @@ namespace Jazz2::UI::Menu
 
 	void InGameMenu::PlaySfx(const StringView identifier, float gain)
 	{
+#if defined(WITH_AUDIO)
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
@@ -402,6 +405,7 @@ namespace Jazz2::UI::Menu
 		} else {
 			LOGE("Sound effect \"%s\" was not found", identifier.data());
 		}
+#endif
 	}
 
 	void InGameMenu::ResumeGame()
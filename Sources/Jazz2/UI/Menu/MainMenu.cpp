@@ -397,11 +397,13 @@ namespace Jazz2::UI::Menu
 			OnInitializeViewport(res.X, res.Y);
 		}
 
+#if defined(WITH_AUDIO)
 		if ((type & ChangedPreferencesType::Audio) == ChangedPreferencesType::Audio) {
 			if (_music != nullptr) {
 				_music->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
 			}
 		}
+#endif
 
 		if ((type & ChangedPreferencesType::Language) == ChangedPreferencesType::Language) {
 			// All sections have to be recreated to load new language
@@ -518,6 +520,7 @@ namespace Jazz2::UI::Menu
 
 	void MainMenu::PlaySfx(const StringView identifier, float gain)
 	{
+#if defined(WITH_AUDIO)
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
@@ -530,6 +533,7 @@ namespace Jazz2::UI::Menu
 		} else {
 			LOGE("Sound effect \"%s\" was not found", identifier.data());
 		}
+#endif
 	}
 
 	bool MainMenu::ActionPressed(PlayerActions action)
@@ -708,10 +712,9 @@ namespace Jazz2::UI::Menu
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			command->setInstanceTexRect(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
+			command->setInstanceSpriteSize(debris.Size.X, debris.Size.Y);
+			command->setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
 			worldMatrix.RotateZ(debris.Angle);
@@ -823,10 +826,9 @@ namespace Jazz2::UI::Menu
 		Vector2i viewSize = _canvasBackground->ViewSize;
 		auto command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command->setInstanceSpriteSize(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
+		command->setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
 		command->material().uniform("uShift")->setFloatVector(_texturedBackgroundPos.Data());
@@ -876,10 +878,9 @@ namespace Jazz2::UI::Menu
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(repeats, 0.0f, repeats, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+			command->setInstanceTexRect(repeats, 0.0f, repeats, 0.0f);
+			command->setInstanceSpriteSize(size.Data());
+			command->setInstanceColor(Colorf::White.Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(center.X, center.Y, 0.0f);
 			worldMatrix.RotateZ(animTime * -0.2f);
@@ -921,10 +922,9 @@ namespace Jazz2::UI::Menu
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(repeats, 0.0f, repeats, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+			command->setInstanceTexRect(repeats, 0.0f, repeats, 0.0f);
+			command->setInstanceSpriteSize(size.Data());
+			command->setInstanceColor(Colorf::White.Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(centerBg.X, centerBg.Y, 0.0f);
 			worldMatrix.RotateZ(animTime * 0.4f);
@@ -966,10 +966,9 @@ namespace Jazz2::UI::Menu
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(repeats, 0.0f, repeats, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+			command->setInstanceTexRect(repeats, 0.0f, repeats, 0.0f);
+			command->setInstanceSpriteSize(size.Data());
+			command->setInstanceColor(Colorf::White.Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(centerBg.X, centerBg.Y, 0.0f);
 			worldMatrix.RotateZ(animTime * 0.3f);
@@ -1056,10 +1055,9 @@ namespace Jazz2::UI::Menu
 				float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
 				float texBiasY = ((tile.TileID / _owner->_tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.Y);
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->setInstanceSpriteSize(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->setInstanceColor(Colorf::White.Data());
 				
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize, 0.0f));
 				command->material().setTexture(*_owner->_tileSet->TextureDiffuse);
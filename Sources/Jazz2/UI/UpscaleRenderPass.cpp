@@ -138,20 +138,19 @@ namespace Jazz2::UI
 
 	bool UpscaleRenderPass::OnDraw(RenderQueue& renderQueue)
 	{
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
 #if !defined(DISABLE_RESCALE_SHADERS)
 		if (_resizeShader != nullptr) {
 			// TexRectUniformName is reused for input texture size
 			Vector2i size = _target->size();
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
+			_renderCommand.setInstanceTexRect((float)size.X, (float)size.Y, 0.0f, 0.0f);
 		} else
 #endif
 		{
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+			_renderCommand.setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
 		}
 
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(_targetSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		_renderCommand.setInstanceSpriteSize(_targetSize.Data());
+		_renderCommand.setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		_renderCommand.material().setTexture(0, *_target);
 
@@ -170,10 +169,9 @@ namespace Jazz2::UI
 	bool UpscaleRenderPass::AntialiasingSubpass::OnDraw(RenderQueue& renderQueue)
 	{
 		Vector2i size = _target->size();
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(_targetSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		_renderCommand.setInstanceTexRect((float)size.X, (float)size.Y, 0.0f, 0.0f);
+		_renderCommand.setInstanceSpriteSize(_targetSize.Data());
+		_renderCommand.setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		_renderCommand.material().setTexture(0, *_target);
 
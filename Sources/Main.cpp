@@ -13,7 +13,9 @@
 #endif
 
 #include "nCine/IAppEventHandler.h"
+#include "nCine/ServiceLocator.h"
 #include "nCine/tracy.h"
+#include "nCine/Base/FrameTimer.h"
 #include "nCine/Base/Timer.h"
 #include "nCine/Graphics/BinaryShaderCache.h"
 #include "nCine/Graphics/RenderResources.h"
@@ -31,6 +33,7 @@
 #include "Jazz2/UI/Menu/LoadingSection.h"
 #include "Jazz2/UI/Menu/SimpleMessageSection.h"
 
+#include "Jazz2/Compatibility/CacheManifest.h"
 #include "Jazz2/Compatibility/JJ2Anims.h"
 #include "Jazz2/Compatibility/JJ2Data.h"
 #include "Jazz2/Compatibility/JJ2Episode.h"
@@ -47,6 +50,12 @@
 using namespace Jazz2::Multiplayer;
 #endif
 
+#if defined(RENDER_BENCHMARK)
+#	include "nCine/Backends/NullGfxDevice.h"
+#	include "nCine/Graphics/RenderStatistics.h"
+#	include <cfloat>
+#endif
+
 #if defined(DEATH_TRACE) && (defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX))
 #	include "TermLogo.h"
 #endif
@@ -86,7 +95,7 @@ public:
 	static constexpr std::int32_t DefaultWidth = 720;
 	static constexpr std::int32_t DefaultHeight = 405;
 
-	static constexpr std::uint16_t StateVersion = 2;
+	static constexpr std::uint16_t StateVersion = 3;
 	static constexpr char StateFileName[] = "Jazz2.resume";
 
 #if defined(WITH_MULTIPLAYER)
@@ -98,6 +107,9 @@ public:
 	void OnInit() override;
 	void OnFrameStart() override;
 	void OnPostUpdate() override;
+#if defined(RENDER_BENCHMARK)
+	void OnFrameEnd() override;
+#endif
 	void OnResizeWindow(int width, int height) override;
 	void OnShutdown() override;
 	void OnSuspend() override;
@@ -146,6 +158,43 @@ private:
 #if defined(WITH_MULTIPLAYER)
 	std::unique_ptr<NetworkManager> _networkManager;
 #endif
+#if defined(RENDER_BENCHMARK)
+	enum class BenchmarkMetric {
+		FrameTime,
+		UpdateTime,
+		VisitTime,
+		DrawTime,
+		Commands,
+		Culled,
+		Batches,
+		StateChanges,
+		UniformBytes,
+		GLCalls,
+		GLDrawCalls,
+		GLBindings,
+		GLUploadedBytes,
+
+		Count
+	};
+
+	struct BenchmarkAccumulator {
+		double Sum = 0.0;
+		float Min = FLT_MAX;
+		float Max = 0.0f;
+	};
+
+	static constexpr std::int32_t BenchmarkWarmupFrames = 60;
+	static constexpr std::int32_t BenchmarkMeasuredFrames = 3600;
+	static constexpr float BenchmarkCameraSpeed = 6.0f;
+
+	LevelHandler* _benchmarkLevel = nullptr;
+	std::int32_t _benchmarkFrame = 0;
+	BenchmarkAccumulator _benchmarkMetrics[(std::int32_t)BenchmarkMetric::Count];
+
+	void MoveBenchmarkCamera();
+	void AddBenchmarkValue(BenchmarkMetric metric, float value);
+	void PrintBenchmarkResults();
+#endif
 
 	void InitializeBase();
 	void SetStateHandler(std::unique_ptr<IStateHandler>&& handler);
@@ -162,6 +211,9 @@ private:
 	static void SaveEpisodeEnd(const LevelInitialization& levelInit);
 	static void SaveEpisodeContinue(const LevelInitialization& levelInit);
 	static bool TryParseAddressAndPort(const StringView input, String& address, std::uint16_t& port);
+#if defined(DEDICATED_SERVER) || defined(RENDER_BENCHMARK)
+	static void ParseLevelPath(const StringView input, StringView& episodeName, StringView& levelName);
+#endif
 	static void ExtractPakFile(const StringView pakFile, const StringView targetPath);
 };
 
@@ -192,12 +244,23 @@ void GameEventHandler::OnPreInit(AppConfiguration& config)
 	PreferencesCache::Initialize(config);
 
 	config.windowTitle = NCINE_APP_NAME;
+#if defined(DEDICATED_SERVER)
+	// Dedicated server has no window, frame limit is used as its fixed tick rate instead
+	config.withAudio = false;
+	config.frameLimit = (std::uint32_t)FrameTimer::FramesPerSecond;
+#elif defined(RENDER_BENCHMARK)
+	// Render benchmark runs as fast as possible, audio would only add noise to measurements
+	config.withAudio = false;
+	config.withVSync = false;
+	config.frameLimit = 0;
+#else
 	if (PreferencesCache::MaxFps == PreferencesCache::UseVsync) {
 		config.withVSync = true;
 	} else {
 		config.withVSync = false;
 		config.frameLimit = PreferencesCache::MaxFps;
 	}
+#endif
 #if !defined(DEATH_TARGET_SWITCH)
 	config.resolution.Set(LevelHandler::DefaultWidth, LevelHandler::DefaultHeight);
 #endif
@@ -226,37 +289,95 @@ void GameEventHandler::OnInit()
 
 	auto& resolver = ContentResolver::Get();
 
-#if defined(DEATH_TARGET_ANDROID)
+#if defined(DEDICATED_SERVER)
+	// Only collision masks and metadata are needed, textures, sounds and shaders are never loaded
+	resolver.SetHeadless(true);
+
+	InitializeBase();
+	RefreshCache();
+
+	if ((_flags & Flags::IsPlayable) != Flags::IsPlayable) {
+		LOGE("Game files were not found, cannot start dedicated server");
+		theApplication().quit();
+		return;
+	}
+
+	// Level can be specified as "/server:<episode>/<level>"
+	StringView episodeName = "prince"_s;
+	StringView levelName = "01_castle1"_s;
+	if (PreferencesCache::InitialState.hasPrefix("/server:"_s)) {
+		ParseLevelPath(PreferencesCache::InitialState.exceptPrefix(8), episodeName, levelName);
+	}
+
+	LevelInitialization levelInit(episodeName, levelName, GameDifficulty::Multiplayer, PreferencesCache::EnableReforgedGameplay);
+	if (!CreateServer(std::move(levelInit), MultiplayerDefaultPort)) {
+		LOGE("Cannot create server on port %u", MultiplayerDefaultPort);
+		theApplication().quit();
+	}
+#elif defined(RENDER_BENCHMARK)
+	// Level is loaded directly without intro and menus, camera then follows a scripted path over the whole level
+	resolver.CompileShaders();
+
+	InitializeBase();
+	RefreshCache();
+
+	if ((_flags & Flags::IsPlayable) != Flags::IsPlayable) {
+		LOGE("Game files were not found, cannot start render benchmark");
+		theApplication().quit();
+		return;
+	}
+
+	// Level can be specified as "/benchmark:<episode>/<level>"
+	StringView episodeName = "prince"_s;
+	StringView levelName = "01_castle1"_s;
+	if (PreferencesCache::InitialState.hasPrefix("/benchmark:"_s)) {
+		ParseLevelPath(PreferencesCache::InitialState.exceptPrefix(11), episodeName, levelName);
+	}
+
+	LevelInitialization levelInit(episodeName, levelName, GameDifficulty::Normal, PreferencesCache::EnableReforgedGameplay, false, PlayerType::Jazz);
+	auto levelHandler = std::make_unique<LevelHandler>(this);
+	if (!levelHandler->Initialize(levelInit)) {
+		LOGE("Cannot load level \"%s/%s\", cannot start render benchmark", String(episodeName).data(), String(levelName).data());
+		theApplication().quit();
+		return;
+	}
+	_benchmarkLevel = levelHandler.get();
+	SetStateHandler(std::move(levelHandler));
+
+	Vector2i res = theApplication().resolution();
+	LOGI("Running render benchmark of \"%s/%s\" at %ix%i for %i frames", String(episodeName).data(), String(levelName).data(), res.X, res.Y, BenchmarkMeasuredFrames);
+#else
+#	if defined(DEATH_TARGET_ANDROID)
 	theApplication().setAutoSuspension(true);
 
 	if (AndroidJniWrap_Activity::hasExternalStoragePermission()) {
 		_flags |= Flags::HasExternalStoragePermission;
 	}
-#elif !defined(DEATH_TARGET_IOS) && !defined(DEATH_TARGET_SWITCH)
-#	if defined(DEATH_TARGET_WINDOWS_RT)
+#	elif !defined(DEATH_TARGET_IOS) && !defined(DEATH_TARGET_SWITCH)
+#		if defined(DEATH_TARGET_WINDOWS_RT)
 	// Xbox is always fullscreen
 	if (PreferencesCache::EnableFullscreen || Environment::CurrentDeviceType == DeviceType::Xbox) {
-#	else
+#		else
 	if (PreferencesCache::EnableFullscreen) {
-#	endif
+#		endif
 		theApplication().gfxDevice().setResolution(true);
 		theApplication().inputManager().setCursor(IInputManager::Cursor::Hidden);
 	}
 
-#	if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_SWITCH) && !defined(DEATH_TARGET_WINDOWS_RT)
+#		if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_SWITCH) && !defined(DEATH_TARGET_WINDOWS_RT)
 	// Try to load gamepad mappings from `Content` directory (or from parent directory of `Source` on Android)
-#	if defined(DEATH_TARGET_ANDROID)
+#		if defined(DEATH_TARGET_ANDROID)
 	String mappingsPath = fs::CombinePath(fs::GetDirectoryName(resolver.GetSourcePath()), "gamecontrollerdb.txt"_s);
-#	else
+#		else
 	String mappingsPath = fs::CombinePath(resolver.GetContentPath(), "gamecontrollerdb.txt"_s);
-#	endif
+#		endif
 	if (fs::IsReadableFile(mappingsPath)) {
 		theApplication().inputManager().addJoyMappingsFromFile(mappingsPath);
 	}
+#		endif
 #	endif
-#endif
 
-#if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_SWITCH) && !defined(DEATH_TARGET_WINDOWS_RT)
+#	if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_SWITCH) && !defined(DEATH_TARGET_WINDOWS_RT)
 	// Try to load gamepad mappings also from config directory
 	auto configDir = PreferencesCache::GetDirectory();
 	if (!configDir.empty()) {
@@ -265,30 +386,30 @@ void GameEventHandler::OnInit()
 			theApplication().inputManager().addJoyMappingsFromFile(mappingsPath2);
 		}
 	}
-#endif
+#	endif
 
 	resolver.CompileShaders();
 
-#if !defined(SHAREWARE_DEMO_ONLY)
+#	if !defined(SHAREWARE_DEMO_ONLY)
 	if (PreferencesCache::ResumeOnStart) {
 		LOGI("Resuming last state due to suspended termination");
 		PreferencesCache::ResumeOnStart = false;
 		PreferencesCache::Save();
 		if (HasResumableState()) {
 			InitializeBase();
-#	if defined(DEATH_TARGET_EMSCRIPTEN)
+#		if defined(DEATH_TARGET_EMSCRIPTEN)
 			// All required files are already included in Emscripten version, so nothing is verified
 			_flags |= Flags::IsVerified | Flags::IsPlayable;
-#	else
+#		else
 			RefreshCache();
-#	endif
+#		endif
 			ResumeSavedState();
 			return;
 		}
 	}
-#endif
+#	endif
 
-#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+#	if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
 	// If threading support is enabled, refresh cache during intro cinematics and don't allow skip until it's completed
 	Thread thread([](void* arg) {
 		Thread::SetCurrentName("Parallel initialization");
@@ -297,16 +418,16 @@ void GameEventHandler::OnInit()
 		ASSERT(handler != nullptr);
 
 		handler->InitializeBase();
-#	if defined(DEATH_TARGET_EMSCRIPTEN)
+#		if defined(DEATH_TARGET_EMSCRIPTEN)
 		// All required files are already included in Emscripten version, so nothing is verified
 		handler->_flags |= Flags::IsVerified | Flags::IsPlayable;
-#	else
+#		else
 		handler->RefreshCache();
 		handler->CheckUpdates();
-#	endif
+#		endif
 	}, this);
 
-#	if defined(WITH_MULTIPLAYER)
+#		if defined(WITH_MULTIPLAYER)
 	// TODO: Multiplayer
 	/*if (PreferencesCache::InitialState == "/server"_s) {
 		thread.Join();
@@ -334,7 +455,7 @@ void GameEventHandler::OnInit()
 			return;
 		}
 	}
-#	endif
+#		endif
 
 	SetStateHandler(std::make_unique<Cinematics>(this, "intro"_s, [thread](IRootController* root, bool endOfStream) mutable {
 		if ((root->GetFlags() & Flags::IsVerified) == Flags::IsVerified) {
@@ -357,19 +478,19 @@ void GameEventHandler::OnInit()
 
 		return true;
 	}));
-#else
+#	else
 	// Building without threading support is not recommended, so it can look ugly
 	InitializeBase();
 
-#	if defined(DEATH_TARGET_EMSCRIPTEN)
+#		if defined(DEATH_TARGET_EMSCRIPTEN)
 	// All required files are already included in Emscripten version, so nothing is verified
 	_flags |= Flags::IsVerified | Flags::IsPlayable;
-#	else
+#		else
 	RefreshCache();
 	CheckUpdates();
-#	endif
+#		endif
 
-#	if defined(WITH_MULTIPLAYER)
+#		if defined(WITH_MULTIPLAYER)
 	if (PreferencesCache::InitialState == "/server"_s) {
 		LOGI("Starting server on port %u...", MultiplayerDefaultPort);
 
@@ -394,16 +515,17 @@ void GameEventHandler::OnInit()
 			return;
 		}
 	}
-#	endif
+#		endif
 
 	SetStateHandler(std::make_unique<Cinematics>(this, "intro"_s, [](IRootController* root, bool endOfStream) {
 		root->GoToMainMenu(endOfStream);
 		return true;
 	}));
-#endif
+#	endif
 
 	Vector2i res = theApplication().resolution();
 	LOGI("Rendering resolution: %ix%i", res.X, res.Y);
+#endif
 }
 
 void GameEventHandler::OnFrameStart()
@@ -424,7 +546,61 @@ void GameEventHandler::OnFrameStart()
 void GameEventHandler::OnPostUpdate()
 {
 	_currentHandler->OnEndFrame();
+
+#if defined(RENDER_BENCHMARK)
+	if (_benchmarkLevel != nullptr && _currentHandler.get() == _benchmarkLevel) {
+		MoveBenchmarkCamera();
+	}
+#endif
+}
+
+#if defined(RENDER_BENCHMARK)
+void GameEventHandler::OnFrameEnd()
+{
+	if (_benchmarkLevel == nullptr) {
+		return;
+	}
+
+	if (_currentHandler.get() != _benchmarkLevel) {
+		// Level was ended or changed by the scripted path, measured frames are reported anyway
+		LOGW("Level was changed before the render benchmark finished");
+		_benchmarkLevel = nullptr;
+		PrintBenchmarkResults();
+		theApplication().quit();
+		return;
+	}
+
+	if (_benchmarkFrame >= BenchmarkWarmupFrames) {
+		// Timings and commands are from the current frame, pipeline statistics and OpenGL calls are from the previous one
+		const float* timings = theApplication().timings();
+		AddBenchmarkValue(BenchmarkMetric::FrameTime, theApplication().frameTimer().lastFrameDuration() * 1000.0f);
+		AddBenchmarkValue(BenchmarkMetric::UpdateTime, (timings[(std::int32_t)Application::Timings::FrameStart] +
+			timings[(std::int32_t)Application::Timings::Update] + timings[(std::int32_t)Application::Timings::PostUpdate]) * 1000.0f);
+		AddBenchmarkValue(BenchmarkMetric::VisitTime, timings[(std::int32_t)Application::Timings::Visit] * 1000.0f);
+		AddBenchmarkValue(BenchmarkMetric::DrawTime, timings[(std::int32_t)Application::Timings::Draw] * 1000.0f);
+
+		AddBenchmarkValue(BenchmarkMetric::Commands, (float)RenderStatistics::allCommands().commands);
+		AddBenchmarkValue(BenchmarkMetric::Culled, (float)RenderStatistics::culled());
+		const RenderStatistics::Pipeline& pipeline = RenderStatistics::pipeline();
+		AddBenchmarkValue(BenchmarkMetric::Batches, (float)pipeline.batches);
+		AddBenchmarkValue(BenchmarkMetric::StateChanges, (float)pipeline.stateChanges());
+		AddBenchmarkValue(BenchmarkMetric::UniformBytes, (float)pipeline.uniformBytes);
+
+		const NullGLCalls& glCalls = static_cast<NullGfxDevice&>(theApplication().gfxDevice()).lastFrameCalls();
+		AddBenchmarkValue(BenchmarkMetric::GLCalls, (float)glCalls.total);
+		AddBenchmarkValue(BenchmarkMetric::GLDrawCalls, (float)glCalls.draws);
+		AddBenchmarkValue(BenchmarkMetric::GLBindings, (float)glCalls.bindings);
+		AddBenchmarkValue(BenchmarkMetric::GLUploadedBytes, (float)glCalls.uploadedBytes);
+	}
+
+	_benchmarkFrame++;
+	if (_benchmarkFrame >= BenchmarkWarmupFrames + BenchmarkMeasuredFrames) {
+		_benchmarkLevel = nullptr;
+		PrintBenchmarkResults();
+		theApplication().quit();
+	}
 }
+#endif
 
 void GameEventHandler::OnResizeWindow(int width, int height)
 {
@@ -540,6 +716,11 @@ void GameEventHandler::InvokeAsync(std::function<void()>&& callback)
 
 void GameEventHandler::GoToMainMenu(bool afterIntro)
 {
+#if defined(DEDICATED_SERVER)
+	// Dedicated server has no main menu, so it's stopped instead
+	LOGI("Shutting down dedicated server");
+	theApplication().quit();
+#else
 	InvokeAsync([this, afterIntro]() {
 		ZoneScopedNC("GameEventHandler::GoToMainMenu", 0x888888);
 
@@ -552,10 +733,41 @@ void GameEventHandler::GoToMainMenu(bool afterIntro)
 			SetStateHandler(std::make_unique<Menu::MainMenu>(this, afterIntro));
 		}
 	});
+#endif
 }
 
 void GameEventHandler::ChangeLevel(LevelInitialization&& levelInit)
 {
+#if defined(DEDICATED_SERVER)
+	InvokeAsync([this, levelInit = std::move(levelInit)]() mutable {
+		ZoneScopedNC("GameEventHandler::ChangeLevel", 0x888888);
+
+		if (levelInit.LevelName.empty() || levelInit.LevelName.hasPrefix(':')) {
+			// Dedicated server never leaves to menu or credits, the episode is started again instead
+			std::optional<Episode> lastEpisode = ContentResolver::Get().GetEpisode(levelInit.LastEpisodeName);
+			if (!lastEpisode) {
+				LOGE("Cannot find episode \"%s\", shutting down dedicated server", levelInit.LastEpisodeName.data());
+				theApplication().quit();
+				return;
+			}
+			levelInit.EpisodeName = levelInit.LastEpisodeName;
+			levelInit.LevelName = lastEpisode->FirstLevel;
+		}
+
+		// All players are remote, they will be spawned again when their peers load the level
+		for (auto& playerCarryOver : levelInit.PlayerCarryOvers) {
+			playerCarryOver.Type = PlayerType::None;
+		}
+
+		auto levelHandler = std::make_unique<MultiLevelHandler>(this, _networkManager.get());
+		if (!levelHandler->Initialize(levelInit)) {
+			LOGE("Cannot load level \"%s/%s\", shutting down dedicated server", levelInit.EpisodeName.data(), levelInit.LevelName.data());
+			theApplication().quit();
+			return;
+		}
+		SetStateHandler(std::move(levelHandler));
+	});
+#else
 	InvokeAsync([this, levelInit = std::move(levelInit)]() mutable {
 		ZoneScopedNC("GameEventHandler::ChangeLevel", 0x888888);
 
@@ -628,6 +840,7 @@ void GameEventHandler::ChangeLevel(LevelInitialization&& levelInit)
 			SetStateHandler(std::move(newHandler));
 		}
 	});
+#endif
 }
 
 bool GameEventHandler::HasResumableState() const
@@ -753,7 +966,15 @@ bool GameEventHandler::CreateServer(LevelInitialization&& levelInit, std::uint16
 
 	InvokeAsync([this, levelInit = std::move(levelInit)]() mutable {
 		auto levelHandler = std::make_unique<MultiLevelHandler>(this, _networkManager.get());
+#if defined(DEDICATED_SERVER)
+		if (!levelHandler->Initialize(levelInit)) {
+			LOGE("Cannot load level \"%s/%s\", shutting down dedicated server", levelInit.EpisodeName.data(), levelInit.LevelName.data());
+			theApplication().quit();
+			return;
+		}
+#else
 		levelHandler->Initialize(levelInit);
+#endif
 		SetStateHandler(std::move(levelHandler));
 	});
 
@@ -912,9 +1133,11 @@ void GameEventHandler::SetStateHandler(std::unique_ptr<IStateHandler>&& handler)
 {
 	_currentHandler = std::move(handler);
 
+#if !defined(DEDICATED_SERVER)
 	Viewport::chain().clear();
 	Vector2i res = theApplication().resolution();
 	_currentHandler->OnInitializeViewport(res.X, res.Y);
+#endif
 }
 
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
@@ -1014,8 +1237,34 @@ RecreateCache:
 	String animationsPath = fs::CombinePath(resolver.GetCachePath(), "Animations"_s);
 	fs::RemoveDirectoryRecursive(animationsPath);
 
-	// Create .pak file
-	{
+	// Anims and data are converted to the same .pak file, so it's recreated if any of them changed
+	String manifestPath = fs::CombinePath(resolver.GetCachePath(), "Source.manifest"_s);
+	Compatibility::CacheManifest manifest;
+	manifest.Load(manifestPath);
+
+	String dataPath = fs::FindPathCaseInsensitive(fs::CombinePath(resolver.GetSourcePath(), "Data.j2d"_s));
+	bool hasData = fs::IsReadableFile(dataPath);
+	auto previousData = manifest.Extract(Compatibility::CacheSourceType::Data);
+
+	Compatibility::CacheManifest::Entry animsEntry;
+	animsEntry.Type = Compatibility::CacheSourceType::Data;
+	animsEntry.ConverterVersion = Compatibility::JJ2Anims::CacheVersion;
+	animsEntry.Outputs.push_back("Source.pak"_s);
+	Compatibility::CacheManifest::Entry dataEntry = animsEntry;
+
+	auto previousAnims = previousData.find(fs::GetFileName(animsPath));
+	bool isPakUpToDate = (Compatibility::CacheManifest::UpdateSourceState(animsPath, previousAnims != previousData.end() ? &previousAnims->second : nullptr, animsEntry) &&
+		previousAnims != previousData.end() && Compatibility::CacheManifest::IsUpToDate(&previousAnims->second, animsEntry, resolver.GetCachePath()));
+	if (hasData) {
+		auto previousDataEntry = previousData.find(fs::GetFileName(dataPath));
+		isPakUpToDate &= (Compatibility::CacheManifest::UpdateSourceState(dataPath, previousDataEntry != previousData.end() ? &previousDataEntry->second : nullptr, dataEntry) &&
+			previousDataEntry != previousData.end() && Compatibility::CacheManifest::IsUpToDate(&previousDataEntry->second, dataEntry, resolver.GetCachePath()));
+	}
+	isPakUpToDate &= (previousData.size() == (hasData ? 2 : 1));
+
+	if (isPakUpToDate) {
+		LOGI("Source.pak is already up-to-date");
+	} else {
 		std::int32_t t = 1;
 		std::unique_ptr<PakWriter> pakWriter = std::make_unique<PakWriter>(fs::CombinePath(resolver.GetCachePath(), "Source.pak"_s));
 		while (!pakWriter->IsValid()) {
@@ -1030,6 +1279,11 @@ RecreateCache:
 			pakWriter = std::make_unique<PakWriter>(fs::CombinePath(resolver.GetCachePath(), "Source.pak"_s));
 		}
 
+		// Compressed files are compressed on worker threads when the file is finalized
+		pakWriter->ParallelFor = [](std::int32_t count, Death::FunctionRef<void(std::int32_t, std::int32_t)> function) {
+			theServiceLocator().threadPool().ParallelFor(count, 1, function);
+		};
+
 		Compatibility::JJ2Version version = Compatibility::JJ2Anims::Convert(animsPath, *pakWriter);
 		if (version == Compatibility::JJ2Version::Unknown) {
 			LOGE("Provided Jazz Jackrabbit 2 version is not supported. Make sure supported Jazz Jackrabbit 2 version is present in \"%s\" directory.", resolver.GetSourcePath().data());
@@ -1038,11 +1292,17 @@ RecreateCache:
 		}
 
 		Compatibility::JJ2Data data;
-		if (data.Open(fs::CombinePath(resolver.GetSourcePath(), "Data.j2d"_s), false)) {
+		if (hasData && data.Open(dataPath, false)) {
 			data.Convert(*pakWriter, version);
 		}
 	}
 
+	manifest.Entries.emplace(fs::GetFileName(animsPath), std::move(animsEntry));
+	if (hasData) {
+		manifest.Entries.emplace(fs::GetFileName(dataPath), std::move(dataEntry));
+	}
+	manifest.Save(manifestPath);
+
 	RefreshCacheLevels();
 
 	LOGI("Cache was recreated");
@@ -1207,91 +1467,210 @@ void GameEventHandler::RefreshCacheLevels()
 		}
 	};
 
-	String episodesPath = fs::CombinePath(resolver.GetCachePath(), "Episodes"_s);
-	fs::RemoveDirectoryRecursive(episodesPath);
+	struct ConversionJob {
+		Compatibility::CacheSourceType Type;
+		String SourcePath;
+		String SourceName;
+		const Compatibility::CacheManifest::Entry* Previous;
+		Compatibility::CacheManifest::Entry Result;
+		bool IsConverted;
+	};
+
+	// Source files are converted independently on all threads, unchanged files are skipped
+	auto ConvertInParallel = [](SmallVectorImpl<ConversionJob>& jobs, StringView cachePath, Death::FunctionRef<void(ConversionJob&)> convert) {
+		theServiceLocator().threadPool().ParallelFor((std::int32_t)jobs.size(), 1, [&jobs, cachePath, convert](std::int32_t first, std::int32_t last) {
+			for (std::int32_t i = first; i < last; i++) {
+				ConversionJob& job = jobs[i];
+				if (Compatibility::CacheManifest::UpdateSourceState(job.SourcePath, job.Previous, job.Result) &&
+					Compatibility::CacheManifest::IsUpToDate(job.Previous, job.Result, cachePath)) {
+					job.Result.Outputs = job.Previous->Outputs;
+					job.Result.Dependencies = job.Previous->Dependencies;
+				} else {
+					convert(job);
+					job.IsConverted = true;
+				}
+			}
+		});
+	};
+
+	StringView cachePath = resolver.GetCachePath();
+	String manifestPath = fs::CombinePath(cachePath, "Source.manifest"_s);
+	Compatibility::CacheManifest manifest;
+	bool hasManifest = manifest.Load(manifestPath);
+	auto previousEpisodes = manifest.Extract(Compatibility::CacheSourceType::Episode);
+	auto previousLevels = manifest.Extract(Compatibility::CacheSourceType::Level);
+	auto previousTilesets = manifest.Extract(Compatibility::CacheSourceType::Tileset);
+
+	String episodesPath = fs::CombinePath(cachePath, "Episodes"_s);
+	String tilesetsPath = fs::CombinePath(cachePath, "Tilesets"_s);
+	if (!hasManifest) {
+		// Files converted by previous versions are not tracked, so they have to be removed
+		fs::RemoveDirectoryRecursive(episodesPath);
+		fs::RemoveDirectoryRecursive(tilesetsPath);
+	}
 	fs::CreateDirectories(episodesPath);
+	fs::CreateDirectories(tilesetsPath);
 
-	HashMap<String, bool> usedTilesets;
+	// Converted episodes depend also on presence of "The Christmas Chronicles"
+	std::uint32_t episodeConverterVersion = Compatibility::JJ2Anims::CacheVersion | (hasChristmasChronicles ? 0x10000 : 0);
+	std::uint32_t levelConverterVersion = ((std::uint32_t)Compatibility::JJ2Anims::CacheVersion << 16) | (std::uint16_t)EventType::Count;
 
+	SmallVector<ConversionJob, 0> jobs;
 	for (auto item : fs::Directory(fs::FindPathCaseInsensitive(resolver.GetSourcePath()), fs::EnumerationOptions::SkipDirectories)) {
 		auto extension = fs::GetExtension(item);
+		Compatibility::CacheSourceType type;
+		const HashMap<String, Compatibility::CacheManifest::Entry>* previousEntries;
 		if (extension == "j2e"_s || extension == "j2pe"_s) {
-			// Episode
+			type = Compatibility::CacheSourceType::Episode;
+			previousEntries = &previousEpisodes;
+		} else if (extension == "j2l"_s && fs::GetFileName(item).find("-MLLE-Data-"_s) == nullptr) {
+			type = Compatibility::CacheSourceType::Level;
+			previousEntries = &previousLevels;
+		} else {
+#if defined(DEATH_DEBUG)
+			/*if (extension == "j2s"_s) {
+				// Episode
+				Compatibility::JJ2Strings strings;
+				strings.Open(item);
+
+				String fullPath = fs::CombinePath({ resolver.GetCachePath(), "Translations"_s, strings.Name + ".h"_s });
+				fs::CreateDirectories(fs::GetDirectoryName(fullPath));
+				strings.Convert(fullPath, LevelTokenConversion);
+			}*/
+#endif
+			continue;
+		}
+
+		ConversionJob& job = jobs.emplace_back();
+		job.Type = type;
+		job.SourcePath = item;
+		job.SourceName = fs::GetFileName(item);
+		auto it = previousEntries->find(job.SourceName);
+		job.Previous = (it != previousEntries->end() ? &it->second : nullptr);
+		job.Result.Type = type;
+		job.Result.ConverterVersion = (type == Compatibility::CacheSourceType::Episode ? episodeConverterVersion : levelConverterVersion);
+		job.IsConverted = false;
+	}
+
+	LOGI("Converting levels and episodes...");
+	ConvertInParallel(jobs, cachePath, [&](ConversionJob& job) {
+		if (job.Type == Compatibility::CacheSourceType::Episode) {
 			Compatibility::JJ2Episode episode;
-			if (episode.Open(item)) {
-				if (episode.Name == "home"_s || (hasChristmasChronicles && episode.Name == "xmas98"_s)) {
-					continue;
-				}
+			if (!episode.Open(job.SourcePath) || episode.Name == "home"_s || (hasChristmasChronicles && episode.Name == "xmas98"_s)) {
+				return;
+			}
 
-				String fullPath = fs::CombinePath(episodesPath, String((episode.Name == "xmas98"_s ? "xmas99"_s : StringView(episode.Name)) + ".j2e"_s));
-				episode.Convert(fullPath, LevelTokenConversion, EpisodeNameConversion, EpisodePrevNext);
+			String relativePath = fs::CombinePath("Episodes"_s, String((episode.Name == "xmas98"_s ? "xmas99"_s : StringView(episode.Name)) + ".j2e"_s));
+			episode.Convert(fs::CombinePath(cachePath, relativePath), LevelTokenConversion, EpisodeNameConversion, EpisodePrevNext);
+			job.Result.Outputs.push_back(std::move(relativePath));
+		} else {
+			Compatibility::JJ2Level level;
+			if (!level.Open(job.SourcePath, false)) {
+				return;
 			}
-		} else if (extension == "j2l"_s) {
-			// Level
-			String levelName = fs::GetFileName(item);
-			if (levelName.find("-MLLE-Data-"_s) == nullptr) {
-				Compatibility::JJ2Level level;
-				if (level.Open(item, false)) {
-					String fullPath;
-					auto it = knownLevels.find(level.LevelName);
-					if (it != knownLevels.end()) {
-						if (it->second.second().empty()) {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(level.LevelName + ".j2l"_s) });
-						} else {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(it->second.second() + '_' + level.LevelName + ".j2l"_s) });
-						}
-					} else {
-						fullPath = fs::CombinePath({ episodesPath, "unknown"_s, String(level.LevelName + ".j2l"_s) });
-					}
 
-					fs::CreateDirectories(fs::GetDirectoryName(fullPath));
-					level.Convert(fullPath, eventConverter, LevelTokenConversion);
+			String relativePath;
+			auto it = knownLevels.find(level.LevelName);
+			if (it != knownLevels.end()) {
+				if (it->second.second().empty()) {
+					relativePath = fs::CombinePath({ "Episodes"_s, it->second.first(), String(level.LevelName + ".j2l"_s) });
+				} else {
+					relativePath = fs::CombinePath({ "Episodes"_s, it->second.first(), String(it->second.second() + '_' + level.LevelName + ".j2l"_s) });
+				}
+			} else {
+				relativePath = fs::CombinePath({ "Episodes"_s, "unknown"_s, String(level.LevelName + ".j2l"_s) });
+			}
 
-					usedTilesets.emplace(level.Tileset, true);
-					for (auto& extraTileset : level.ExtraTilesets) {
-						usedTilesets.emplace(extraTileset.Name, true);
-					}
+			String fullPath = fs::CombinePath(cachePath, relativePath);
+			fs::CreateDirectories(fs::GetDirectoryName(fullPath));
+			level.Convert(fullPath, eventConverter, LevelTokenConversion);
+			job.Result.Outputs.push_back(std::move(relativePath));
 
-					// Also copy level script file if exists
-					StringView foundDot = item.findLastOr('.', item.end());
-					String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
-					auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
-					if (fs::IsReadableFile(adjustedPath)) {
-						foundDot = fullPath.findLastOr('.', fullPath.end());
-						fs::Copy(adjustedPath, String(fullPath.prefix(foundDot.begin()) + ".j2as"_s));
-					}
-				}
+			job.Result.Dependencies.push_back(level.Tileset);
+			for (auto& extraTileset : level.ExtraTilesets) {
+				job.Result.Dependencies.push_back(extraTileset.Name);
 			}
 		}
-#if defined(DEATH_DEBUG)
-		/*else if (extension == "j2s"_s) {
-			// Episode
-			Compatibility::JJ2Strings strings;
-			strings.Open(item);
+	});
 
-			String fullPath = fs::CombinePath({ resolver.GetCachePath(), "Translations"_s, strings.Name + ".h"_s });
-			fs::CreateDirectories(fs::GetDirectoryName(fullPath));
-			strings.Convert(fullPath, LevelTokenConversion);
-		}*/
-#endif
+	HashMap<String, bool> usedTilesets;
+	for (auto& job : jobs) {
+		if (job.Type != Compatibility::CacheSourceType::Level || job.Result.Outputs.empty()) {
+			continue;
+		}
+
+		for (auto& tileset : job.Result.Dependencies) {
+			usedTilesets.emplace(tileset, true);
+		}
+
+		// Also copy level script file if exists, it's not tracked, so it's always copied
+		StringView sourcePath = job.SourcePath;
+		StringView foundDot = sourcePath.findLastOr('.', sourcePath.end());
+		String scriptPath = sourcePath.prefix(foundDot.begin()) + ".j2as"_s;
+		auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
+		if (fs::IsReadableFile(adjustedPath)) {
+			String fullPath = fs::CombinePath(cachePath, job.Result.Outputs[0]);
+			foundDot = fullPath.findLastOr('.', fullPath.end());
+			fs::Copy(adjustedPath, String(fullPath.prefix(foundDot.begin()) + ".j2as"_s));
+		}
 	}
 
 	// Convert only used tilesets
 	LOGI("Converting used tilesets...");
-	String tilesetsPath = fs::CombinePath(resolver.GetCachePath(), "Tilesets"_s);
-	fs::RemoveDirectoryRecursive(tilesetsPath);
-	fs::CreateDirectories(tilesetsPath);
-
+	SmallVector<ConversionJob, 0> tilesetJobs;
 	for (auto& pair : usedTilesets) {
 		String tilesetPath = fs::CombinePath(resolver.GetSourcePath(), String(pair.first + ".j2t"_s));
 		auto adjustedPath = fs::FindPathCaseInsensitive(tilesetPath);
 		if (fs::IsReadableFile(adjustedPath)) {
-			Compatibility::JJ2Tileset tileset;
-			if (tileset.Open(adjustedPath, false)) {
-				tileset.Convert(fs::CombinePath({ tilesetsPath, String(pair.first + ".j2t"_s) }));
+			ConversionJob& job = tilesetJobs.emplace_back();
+			job.Type = Compatibility::CacheSourceType::Tileset;
+			job.SourcePath = adjustedPath;
+			job.SourceName = String(pair.first + ".j2t"_s);
+			auto it = previousTilesets.find(job.SourceName);
+			job.Previous = (it != previousTilesets.end() ? &it->second : nullptr);
+			job.Result.Type = job.Type;
+			job.Result.ConverterVersion = Compatibility::JJ2Anims::CacheVersion;
+			job.IsConverted = false;
+		}
+	}
+
+	ConvertInParallel(tilesetJobs, cachePath, [cachePath](ConversionJob& job) {
+		Compatibility::JJ2Tileset tileset;
+		if (tileset.Open(job.SourcePath, false)) {
+			String relativePath = fs::CombinePath("Tilesets"_s, job.SourceName);
+			tileset.Convert(fs::CombinePath(cachePath, relativePath));
+			job.Result.Outputs.push_back(std::move(relativePath));
+		}
+	});
+
+	// Remove files converted from sources that no longer exist or that produce different files now
+	HashMap<String, bool> currentOutputs;
+	std::int32_t convertedCount = 0;
+	for (auto* jobList : { &jobs, &tilesetJobs }) {
+		for (auto& job : *jobList) {
+			for (auto& output : job.Result.Outputs) {
+				currentOutputs.emplace(output, true);
+			}
+			if (job.IsConverted) {
+				convertedCount++;
+			}
+			manifest.Entries.emplace(std::move(job.SourceName), std::move(job.Result));
+		}
+	}
+
+	for (auto* previousEntries : { &previousEpisodes, &previousLevels, &previousTilesets }) {
+		for (auto& [sourceName, entry] : *previousEntries) {
+			for (auto& output : entry.Outputs) {
+				if (currentOutputs.find(output) == currentOutputs.end()) {
+					fs::RemoveFile(fs::CombinePath(cachePath, output));
+				}
 			}
 		}
 	}
+
+	manifest.Save(manifestPath);
+
+	LOGI("Converted %i of %i files, others are already up-to-date", convertedCount, (std::int32_t)(jobs.size() + tilesetJobs.size()));
 }
 
 void GameEventHandler::CheckUpdates()
@@ -1603,6 +1982,76 @@ void GameEventHandler::SaveEpisodeContinue(const LevelInitialization& levelInit)
 	}
 }
 
+#if defined(DEDICATED_SERVER) || defined(RENDER_BENCHMARK)
+void GameEventHandler::ParseLevelPath(const StringView input, StringView& episodeName, StringView& levelName)
+{
+	StringView separator = input.findOr('/', input.end());
+	if (separator.begin() != input.end()) {
+		episodeName = input.prefix(separator.begin());
+		levelName = input.suffix(separator.end());
+	}
+}
+#endif
+
+#if defined(RENDER_BENCHMARK)
+void GameEventHandler::MoveBenchmarkCamera()
+{
+	Recti bounds = _benchmarkLevel->LevelBounds();
+	Vector2f halfView = _benchmarkLevel->GetViewSize().As<float>() * 0.5f;
+
+	float minX = bounds.X + halfView.X;
+	float maxX = std::max(minX, bounds.X + bounds.W - halfView.X);
+	float minY = bounds.Y + halfView.Y;
+	float maxY = std::max(minY, bounds.Y + bounds.H - halfView.Y);
+
+	// Camera goes through the level in rows one screen apart, every other row in the opposite direction,
+	// the path depends only on frame number, so all runs with the same resolution render the same frames
+	float rowLength = std::max(maxX - minX, 1.0f);
+	std::int32_t rowCount = (std::int32_t)((maxY - minY) / (halfView.Y * 2.0f)) + 1;
+	float rowStep = (rowCount > 1 ? (maxY - minY) / (rowCount - 1) : 0.0f);
+
+	float distance = _benchmarkFrame * BenchmarkCameraSpeed;
+	std::int32_t row = (std::int32_t)(distance / rowLength);
+	float offset = distance - row * rowLength;
+	row %= rowCount;
+
+	Vector2f pos;
+	pos.X = ((row & 1) == 0 ? minX + offset : maxX - offset);
+	pos.Y = minY + row * rowStep;
+	_benchmarkLevel->MoveCameraForBenchmark(pos);
+}
+
+void GameEventHandler::AddBenchmarkValue(BenchmarkMetric metric, float value)
+{
+	BenchmarkAccumulator& accumulator = _benchmarkMetrics[(std::int32_t)metric];
+	accumulator.Sum += value;
+	accumulator.Min = std::min(accumulator.Min, value);
+	accumulator.Max = std::max(accumulator.Max, value);
+}
+
+void GameEventHandler::PrintBenchmarkResults()
+{
+	static const char* MetricNames[] = {
+		"Frame time (ms)", "Update time (ms)", "Visit time (ms)", "Draw time (ms)",
+		"Render commands", "Culled nodes", "Batches", "State changes", "Uniform bytes",
+		"OpenGL calls", "OpenGL draw calls", "OpenGL bindings", "OpenGL uploaded bytes"
+	};
+	static_assert(countof(MetricNames) == (std::size_t)BenchmarkMetric::Count, "Every metric must have a name");
+
+	std::int32_t measuredFrames = _benchmarkFrame - BenchmarkWarmupFrames;
+	if (measuredFrames <= 0) {
+		LOGW("Render benchmark has no measured frames");
+		return;
+	}
+
+	LOGI("Render benchmark results of %i frames (average / min / max):", measuredFrames);
+	for (std::int32_t i = 0; i < (std::int32_t)BenchmarkMetric::Count; i++) {
+		const BenchmarkAccumulator& accumulator = _benchmarkMetrics[i];
+		LOGI("  %s: %.3f / %.3f / %.3f", MetricNames[i], accumulator.Sum / measuredFrames, accumulator.Min, accumulator.Max);
+	}
+}
+#endif
+
 bool GameEventHandler::TryParseAddressAndPort(const StringView input, String& address, std::uint16_t& port)
 {
 	auto portSep = input.findLast(':');
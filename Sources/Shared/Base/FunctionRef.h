@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Common.h"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Death {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	template<class> class FunctionRef;
+
+	/**
+		@brief Non-owning reference to a callable
+
+		Lightweight alternative to @ref std::function for passing callbacks to functions, it never allocates and it's
+		only two pointers in size. The referenced callable must outlive the @ref FunctionRef instance, so it should
+		be used only for function parameters and never stored.
+	*/
+	template<class R, class ...Args> class FunctionRef<R(Args...)>
+	{
+	public:
+		/** @brief Default constructor, creates an empty reference */
+		constexpr FunctionRef() noexcept : _callable(nullptr), _call(nullptr) {}
+
+		/** @brief Creates a reference to a callable, e.g. a lambda */
+		template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, FunctionRef>::value &&
+			std::is_convertible<decltype(std::declval<F&>()(std::declval<Args>()...)), R>::value>::type>
+		FunctionRef(F&& f) noexcept
+			: _callable(const_cast<void*>(static_cast<const void*>(std::addressof(f)))), _call(&Call<typename std::remove_reference<F>::type>) {}
+
+		/** @brief Calls the referenced callable */
+		R operator()(Args... args) const {
+			return _call(_callable, std::forward<Args>(args)...);
+		}
+
+		/** @brief Whether the reference is non-empty */
+		explicit operator bool() const noexcept {
+			return (_call != nullptr);
+		}
+
+	private:
+		template<class F> static R Call(void* callable, Args... args) {
+			return (*static_cast<F*>(callable))(std::forward<Args>(args)...);
+		}
+
+		void* _callable;
+		R(*_call)(void*, Args...);
+	};
+}
@@ -0,0 +1,227 @@
+#include "BufferedStream.h"
+
+#include <algorithm>
+
+namespace Death { namespace IO {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	BufferedStream::BufferedStream(Stream& inputStream, std::int32_t bufferSize)
+		: _inputStream(&inputStream), _begin(nullptr), _current(nullptr), _end(nullptr), _initialPosition(0),
+			_bufferSize(bufferSize), _isContentView(false)
+	{
+		_size = inputStream.GetSize();
+
+		auto content = inputStream.GetContentView();
+		if (!content.empty()) {
+			std::int64_t position = inputStream.GetPosition();
+			if (position >= 0 && position <= static_cast<std::int64_t>(content.size())) {
+				_begin = content.data();
+				_current = _begin + position;
+				_end = _begin + content.size();
+				_initialPosition = position;
+				_isContentView = true;
+				return;
+			}
+		}
+
+		_buffer = std::make_unique<std::uint8_t[]>(_bufferSize);
+		_begin = _buffer.get();
+		_current = _begin;
+		_end = _begin;
+	}
+
+	BufferedStream::~BufferedStream()
+	{
+		Close();
+	}
+
+	void BufferedStream::Close()
+	{
+		if (_inputStream == nullptr) {
+			return;
+		}
+
+		// Synchronize position of the input stream if it's seekable, it's not closed
+		std::int64_t offset = (_isContentView
+			? static_cast<std::int64_t>(_current - _begin) - _initialPosition
+			: -static_cast<std::int64_t>(_end - _current));
+		if (offset != 0 && _inputStream->GetSize() >= 0) {
+			_inputStream->Seek(offset, SeekOrigin::Current);
+		}
+
+		_inputStream = nullptr;
+		_begin = nullptr;
+		_current = nullptr;
+		_end = nullptr;
+		_size = ErrorInvalidStream;
+	}
+
+	std::int64_t BufferedStream::Seek(std::int64_t offset, SeekOrigin origin)
+	{
+		if (_inputStream == nullptr) {
+			return ErrorInvalidStream;
+		}
+
+		if (_isContentView) {
+			std::int64_t newPos;
+			switch (origin) {
+				case SeekOrigin::Begin: newPos = offset; break;
+				case SeekOrigin::Current: newPos = (_current - _begin) + offset; break;
+				case SeekOrigin::End: newPos = (_end - _begin) + offset; break;
+				default: return ErrorInvalidParameter;
+			}
+
+			if (newPos < 0 || newPos > (_end - _begin)) {
+				return ErrorInvalidParameter;
+			}
+			_current = _begin + newPos;
+			return newPos;
+		}
+
+		if (origin == SeekOrigin::Current && offset >= -(_current - _begin) && offset <= (_end - _current)) {
+			_current += offset;
+			return GetPosition();
+		}
+
+		// Target is outside of the window, so it has to be discarded
+		if (origin == SeekOrigin::Current) {
+			offset -= (_end - _current);
+		}
+		std::int64_t newPos = _inputStream->Seek(offset, origin);
+		if (newPos >= 0) {
+			_begin = _buffer.get();
+			_current = _begin;
+			_end = _begin;
+		}
+		return newPos;
+	}
+
+	std::int64_t BufferedStream::GetPosition() const
+	{
+		if (_inputStream == nullptr) {
+			return ErrorInvalidStream;
+		}
+		if (_isContentView) {
+			return (_current - _begin);
+		}
+
+		std::int64_t pos = _inputStream->GetPosition();
+		return (pos >= 0 ? pos - (_end - _current) : pos);
+	}
+
+	std::int32_t BufferedStream::Read(void* buffer, std::int32_t bytes)
+	{
+		DEATH_ASSERT(buffer != nullptr, 0, "buffer is nullptr");
+
+		if (bytes <= static_cast<std::int32_t>(_end - _current)) {
+			if (bytes <= 0) {
+				return 0;
+			}
+			std::memcpy(buffer, _current, bytes);
+			_current += bytes;
+			return bytes;
+		}
+
+		return ReadSlow(buffer, bytes);
+	}
+
+	std::int32_t BufferedStream::Write(const void* buffer, std::int32_t bytes)
+	{
+		// Not supported
+		return ErrorInvalidStream;
+	}
+
+	bool BufferedStream::IsValid()
+	{
+		return (_inputStream != nullptr && _inputStream->IsValid());
+	}
+
+	Containers::ArrayView<const std::uint8_t> BufferedStream::GetContentView() const
+	{
+		if (!_isContentView) {
+			return { };
+		}
+		return { _begin, static_cast<std::size_t>(_end - _begin) };
+	}
+
+	Containers::ArrayView<const std::uint8_t> BufferedStream::Peek(std::int32_t minBytes)
+	{
+		if (static_cast<std::int32_t>(_end - _current) < minBytes) {
+			Refill(minBytes);
+		}
+		return { _current, static_cast<std::size_t>(_end - _current) };
+	}
+
+	std::int32_t BufferedStream::ReadSlow(void* buffer, std::int32_t bytes)
+	{
+		std::uint8_t* typedBuffer = static_cast<std::uint8_t*>(buffer);
+		std::int32_t bytesReadTotal = static_cast<std::int32_t>(_end - _current);
+		if (bytesReadTotal > 0) {
+			std::memcpy(typedBuffer, _current, bytesReadTotal);
+			_current += bytesReadTotal;
+			typedBuffer += bytesReadTotal;
+			bytes -= bytesReadTotal;
+		}
+
+		if (_isContentView || _inputStream == nullptr) {
+			return bytesReadTotal;
+		}
+
+		if (bytes >= _bufferSize) {
+			// Large reads bypass the window
+			_begin = _buffer.get();
+			_current = _begin;
+			_end = _begin;
+
+			while (bytes > 0) {
+				std::int32_t bytesRead = _inputStream->Read(typedBuffer, bytes);
+				if (bytesRead <= 0) {
+					break;
+				}
+				bytesReadTotal += bytesRead;
+				typedBuffer += bytesRead;
+				bytes -= bytesRead;
+			}
+			return bytesReadTotal;
+		}
+
+		std::int32_t bytesRead = std::min(Refill(bytes), bytes);
+		if (bytesRead > 0) {
+			std::memcpy(typedBuffer, _current, bytesRead);
+			_current += bytesRead;
+			bytesReadTotal += bytesRead;
+		}
+		return bytesReadTotal;
+	}
+
+	std::int32_t BufferedStream::Refill(std::int32_t minBytes)
+	{
+		std::int32_t available = static_cast<std::int32_t>(_end - _current);
+		if (_isContentView || _inputStream == nullptr) {
+			return available;
+		}
+
+		// Move the remaining bytes to the beginning, so the window is always contiguous
+		std::uint8_t* buffer = _buffer.get();
+		if (available > 0 && _current != buffer) {
+			std::memmove(buffer, _current, available);
+		}
+		if (minBytes > _bufferSize) {
+			minBytes = _bufferSize;
+		}
+
+		while (available < minBytes) {
+			std::int32_t bytesRead = _inputStream->Read(buffer + available, _bufferSize - available);
+			if (bytesRead <= 0) {
+				break;
+			}
+			available += bytesRead;
+		}
+
+		_begin = buffer;
+		_current = buffer;
+		_end = buffer + available;
+		return available;
+	}
+
+}}
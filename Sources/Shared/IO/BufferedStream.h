@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Stream.h"
+
+#include <cstring>
+#include <memory>
+
+namespace Death { namespace IO {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	/**
+		@brief Read-only buffered view of another stream
+
+		Reads from the input stream are done in large blocks and small reads are served from an internal window,
+		so @ref ReadValue() is just a bounds check and a copy. If the whole content of the input stream is already
+		in memory (see @ref Stream::GetContentView()), it's accessed directly without any copying. Unread buffered
+		bytes are returned to the input stream on destruction by seeking back, if the input stream is seekable.
+	*/
+	class BufferedStream : public Stream
+	{
+	public:
+		/** @brief Default size of the internal window */
+		static constexpr std::int32_t DefaultBufferSize = 16384;
+
+		explicit BufferedStream(Stream& inputStream, std::int32_t bufferSize = DefaultBufferSize);
+		~BufferedStream();
+
+		BufferedStream(const BufferedStream&) = delete;
+		BufferedStream& operator=(const BufferedStream&) = delete;
+
+		void Close() override;
+		std::int64_t Seek(std::int64_t offset, SeekOrigin origin) override;
+		std::int64_t GetPosition() const override;
+		std::int32_t Read(void* buffer, std::int32_t bytes) override;
+		std::int32_t Write(const void* buffer, std::int32_t bytes) override;
+		bool IsValid() override;
+		Containers::ArrayView<const std::uint8_t> GetContentView() const override;
+
+		/** @brief Reads a value, it's inlined if the value is already in the window */
+		template<typename T, class = typename std::enable_if<std::is_trivially_constructible<T>::value>::type>
+		DEATH_ALWAYS_INLINE T ReadValue()
+		{
+			T value;
+			if DEATH_LIKELY(static_cast<std::size_t>(_end - _current) >= sizeof(T)) {
+				std::memcpy(&value, _current, sizeof(T));
+				_current += sizeof(T);
+			} else {
+				value = { };
+				ReadSlow(&value, sizeof(T));
+			}
+			return value;
+		}
+
+		/**
+			@brief Returns buffered bytes at the current position without consuming them
+
+			At least @p minBytes are returned unless the end of the stream was reached. If the content of the input
+			stream is in memory, the view covers the rest of the stream.
+		*/
+		Containers::ArrayView<const std::uint8_t> Peek(std::int32_t minBytes);
+		/** @brief Consumes bytes previously returned by @ref Peek() */
+		DEATH_ALWAYS_INLINE void Consume(std::int32_t bytes) {
+			_current += bytes;
+		}
+
+	private:
+		Stream* _inputStream;
+		std::unique_ptr<std::uint8_t[]> _buffer;
+		const std::uint8_t* _begin;
+		const std::uint8_t* _current;
+		const std::uint8_t* _end;
+		std::int64_t _initialPosition;
+		std::int32_t _bufferSize;
+		bool _isContentView;
+
+		std::int32_t ReadSlow(void* buffer, std::int32_t bytes);
+		std::int32_t Refill(std::int32_t minBytes);
+	};
+
+}}
@@ -98,6 +98,14 @@ namespace Death { namespace IO {
 		return true;
 	}
 
+	Containers::ArrayView<const std::uint8_t> MemoryStream::GetContentView() const
+	{
+		if (_mode == AccessMode::None) {
+			return { };
+		}
+		return { _buffer.data(), static_cast<std::size_t>(_size) };
+	}
+
 	void MemoryStream::ReserveCapacity(std::int64_t bytes)
 	{
 		if (_mode == AccessMode::Growable) {
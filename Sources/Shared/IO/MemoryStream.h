@@ -26,6 +26,7 @@ namespace Death { namespace IO {
 		std::int32_t Write(const void* buffer, std::int32_t bytes) override;
 
 		bool IsValid() override;
+		Containers::ArrayView<const std::uint8_t> GetContentView() const override;
 
 		void ReserveCapacity(std::int64_t bytes);
 		std::int32_t FetchFromStream(Stream& s, std::int32_t bytes);
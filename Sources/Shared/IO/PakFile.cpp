@@ -1,12 +1,22 @@
 #include "PakFile.h"
 #include "DeflateStream.h"
 #include "FileSystem.h"
+#include "MemoryStream.h"
 #include "../Containers/GrowableArray.h"
 #include "../Containers/StringConcatenable.h"
 
 #include <algorithm>
 
+#if defined(WITH_LZ4)
+#	include <lz4.h>
+#	include <lz4hc.h>
+#endif
+#if defined(WITH_ZSTD)
+#	include <zstd.h>
+#endif
+
 using namespace Death::Containers;
+using namespace Death::Containers::Literals;
 
 namespace Death { namespace IO {
 //###==##====#=====--==~--~=~- --- -- -  -  -   -
@@ -96,12 +106,44 @@ namespace Death { namespace IO {
 		return _underlyingStream.IsValid();
 	}
 
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+
+	class MappedBoundedStream : public MemoryStream
+	{
+	public:
+		MappedBoundedStream(std::shared_ptr<Array<char, FileSystem::MapDeleter>> mappedFile, std::uint64_t offset, std::uint32_t size);
+
+	private:
+		std::shared_ptr<Array<char, FileSystem::MapDeleter>> _mappedFile;
+	};
+
+	MappedBoundedStream::MappedBoundedStream(std::shared_ptr<Array<char, FileSystem::MapDeleter>> mappedFile, std::uint64_t offset, std::uint32_t size)
+		: MemoryStream(reinterpret_cast<const std::uint8_t*>(mappedFile->data() + offset), size), _mappedFile(std::move(mappedFile))
+	{
+	}
+
+#endif
+
+	class DecompressedStream : public MemoryStream
+	{
+	public:
+		DecompressedStream(std::unique_ptr<std::uint8_t[]> buffer, std::int64_t size);
+
+	private:
+		std::unique_ptr<std::uint8_t[]> _buffer;
+	};
+
+	DecompressedStream::DecompressedStream(std::unique_ptr<std::uint8_t[]> buffer, std::int64_t size)
+		: MemoryStream(static_cast<const std::uint8_t*>(buffer.get()), size), _buffer(std::move(buffer))
+	{
+	}
+
 #if defined(WITH_ZLIB)
 
 	class ZlibCompressedBoundedStream : public Stream
 	{
 	public:
-		ZlibCompressedBoundedStream(const String& path, std::uint64_t offset, std::uint32_t uncompressedSize, std::uint32_t compressedSize);
+		ZlibCompressedBoundedStream(std::unique_ptr<Stream> underlyingStream, std::uint32_t uncompressedSize, std::uint32_t compressedSize);
 
 		ZlibCompressedBoundedStream(const ZlibCompressedBoundedStream&) = delete;
 		ZlibCompressedBoundedStream& operator=(const ZlibCompressedBoundedStream&) = delete;
@@ -115,22 +157,21 @@ namespace Death { namespace IO {
 		bool IsValid() override;
 
 	private:
-		BoundedStream _underlyingStream;
+		std::unique_ptr<Stream> _underlyingStream;
 		DeflateStream _deflateStream;
 	};
 
-	ZlibCompressedBoundedStream::ZlibCompressedBoundedStream(const String& path, std::uint64_t offset, std::uint32_t uncompressedSize, std::uint32_t compressedSize)
-		: _underlyingStream(path, offset, compressedSize)
+	ZlibCompressedBoundedStream::ZlibCompressedBoundedStream(std::unique_ptr<Stream> underlyingStream, std::uint32_t uncompressedSize, std::uint32_t compressedSize)
+		: _underlyingStream(std::move(underlyingStream))
 	{
 		_size = uncompressedSize;
-		_underlyingStream.Seek(static_cast<std::int64_t>(offset), SeekOrigin::Begin);
-		_deflateStream.Open(_underlyingStream, static_cast<std::int32_t>(compressedSize));
+		_deflateStream.Open(*_underlyingStream, static_cast<std::int32_t>(compressedSize));
 	}
 
 	void ZlibCompressedBoundedStream::Close()
 	{
 		_deflateStream.Close();
-		_underlyingStream.Close();
+		_underlyingStream->Close();
 	}
 
 	std::int64_t ZlibCompressedBoundedStream::Seek(std::int64_t offset, SeekOrigin origin)
@@ -156,15 +197,54 @@ namespace Death { namespace IO {
 
 	bool ZlibCompressedBoundedStream::IsValid()
 	{
-		return _underlyingStream.IsValid() && _deflateStream.IsValid();
+		return _underlyingStream->IsValid() && _deflateStream.IsValid();
 	}
 
 #endif
 
+	namespace
+	{
+		constexpr std::uint64_t PathHashOffsetBasis = 0xCBF29CE484222325ull;
+		constexpr std::uint64_t PathHashPrime = 0x00000100000001B3ull;
+
+		// Converts the path to form used in the index, components are separated by single '/' without leading and trailing separators
+		std::int32_t NormalizePath(StringView path, char* buffer, std::int32_t bufferSize)
+		{
+			std::int32_t length = 0;
+			bool pendingSeparator = false;
+			for (char c : path) {
+				if (c == '/' || c == '\\') {
+					pendingSeparator = (length > 0);
+					continue;
+				}
+				if (length + 2 > bufferSize) {
+					return -1;
+				}
+				if (pendingSeparator) {
+					buffer[length++] = '/';
+					pendingSeparator = false;
+				}
+				buffer[length++] = c;
+			}
+			return length;
+		}
+	}
+
 	PakFile::PakFile(const StringView path)
 	{
-		std::unique_ptr<Stream> s = std::make_unique<FileStream>(path, FileAccessMode::Read);
-		DEATH_ASSERT(s->GetSize() > 24, , "Invalid .pak file");
+		std::unique_ptr<Stream> s;
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (auto mappedFile = FileSystem::OpenAsMemoryMapped(path, FileAccessMode::Read)) {
+			_mappedFile = std::make_shared<Array<char, FileSystem::MapDeleter>>(std::move(*mappedFile));
+			s = std::make_unique<MemoryStream>(reinterpret_cast<const std::uint8_t*>(_mappedFile->data()), static_cast<std::int64_t>(_mappedFile->size()));
+		} else
+#endif
+		{
+			// Fall back to reading the file through regular file streams if it can't be mapped
+			s = std::make_unique<FileStream>(path, FileAccessMode::Read);
+		}
+		std::int64_t fileSize = s->GetSize();
+		DEATH_ASSERT(fileSize > 24, , "Invalid .pak file");
 
 		// Header size is 18 bytes
 		bool isSeekable = s->Seek(-18, SeekOrigin::End) >= 0;
@@ -175,6 +255,7 @@ namespace Death { namespace IO {
 
 		std::uint16_t fileVersion = s->ReadValue<std::uint16_t>();
 		std::uint64_t rootIndexOffset = s->ReadValue<std::uint64_t>();
+		DEATH_ASSERT(fileVersion == Version || fileVersion == TreeIndexVersion, , "Unsupported .pak file version");
 
 		DEATH_ASSERT(rootIndexOffset < INT64_MAX, , "Malformed .pak file");
 		s->Seek(static_cast<std::int64_t>(rootIndexOffset), SeekOrigin::Begin);
@@ -193,7 +274,42 @@ namespace Death { namespace IO {
 			_mountPoint += FileSystem::PathSeparator;
 		}
 
-		ReadIndex(s, nullptr);
+		const std::uint8_t* indexData;
+		std::int64_t indexSize;
+		if (fileVersion == TreeIndexVersion) {
+			// Old files are converted to the flat index in memory
+			Array<Item> rootItems;
+			ReadTreeIndex(*s, rootItems);
+			MemoryStream ms;
+			WriteIndex(ms, rootItems);
+			indexSize = ms.GetSize();
+			_indexData = std::make_unique<std::uint64_t[]>(static_cast<std::size_t>((indexSize + 7) / 8));
+			std::memcpy(_indexData.get(), ms.GetBuffer(), static_cast<std::size_t>(indexSize));
+			indexData = reinterpret_cast<const std::uint8_t*>(_indexData.get());
+		} else {
+			// Flat index is aligned to 8 bytes and it spans to the header at the end of the file
+			std::int64_t indexOffset = (s->GetPosition() + 7) & ~std::int64_t(7);
+			indexSize = fileSize - 18 - indexOffset;
+			DEATH_ASSERT(indexSize >= IndexHeaderSize, , "Malformed .pak file");
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+			if (_mappedFile != nullptr) {
+				indexData = reinterpret_cast<const std::uint8_t*>(_mappedFile->data() + indexOffset);
+			} else
+#endif
+			{
+				_indexData = std::make_unique<std::uint64_t[]>(static_cast<std::size_t>((indexSize + 7) / 8));
+				s->Seek(indexOffset, SeekOrigin::Begin);
+				std::int32_t bytesRead = s->Read(_indexData.get(), static_cast<std::int32_t>(indexSize));
+				DEATH_ASSERT(bytesRead == indexSize, , "Malformed .pak file");
+				indexData = reinterpret_cast<const std::uint8_t*>(_indexData.get());
+			}
+		}
+
+		if (!LoadIndex(indexData, indexSize)) {
+			LOGE("Malformed .pak file \"%s\"", String::nullTerminatedView(path).data());
+			return;
+		}
+
 		_path = path;
 	}
 
@@ -212,58 +328,181 @@ namespace Death { namespace IO {
 		return !_path.empty();
 	}
 
-	void PakFile::ReadIndex(std::unique_ptr<Stream>& s, Item* parentItem)
+	bool PakFile::LoadIndex(const std::uint8_t* data, std::int64_t size)
 	{
-		std::uint32_t itemCount = s->ReadVariableUint32();
+		if (size < IndexHeaderSize) {
+			return false;
+		}
 
-		Array<Item>* items;
-		if (parentItem != nullptr) {
-			parentItem->ChildItems = Array<Item>(itemCount);
-			items = &parentItem->ChildItems;
-		} else {
-			_rootItems = Array<Item>(itemCount);
-			items = &_rootItems;
+		std::uint32_t header[IndexHeaderSize / sizeof(std::uint32_t)];
+		std::memcpy(header, data, IndexHeaderSize);
+		std::uint32_t itemCount = header[0];
+		std::uint32_t hashTableSize = header[1];
+		std::uint32_t pathsSize = header[2];
+
+		std::uint64_t requiredSize = IndexHeaderSize + std::uint64_t(itemCount) * sizeof(IndexItem) + std::uint64_t(hashTableSize) * sizeof(std::uint32_t) + pathsSize;
+		if (itemCount == 0 || hashTableSize < itemCount || (hashTableSize & (hashTableSize - 1)) != 0 || requiredSize > std::uint64_t(size)) {
+			return false;
+		}
+
+		const std::uint8_t* ptr = data + IndexHeaderSize;
+		_items = { reinterpret_cast<const IndexItem*>(ptr), itemCount };
+		ptr += std::size_t(itemCount) * sizeof(IndexItem);
+		_hashTable = { reinterpret_cast<const std::uint32_t*>(ptr), hashTableSize };
+		ptr += std::size_t(hashTableSize) * sizeof(std::uint32_t);
+		_paths = { reinterpret_cast<const char*>(ptr), pathsSize };
+
+		// The first item is always the root directory
+		if ((_items[0].Flags & ItemFlags::Directory) != ItemFlags::Directory) {
+			return false;
+		}
+		for (const IndexItem& item : _items) {
+			if (std::uint64_t(item.PathOffset) + item.PathLength > pathsSize || item.NameLength > item.PathLength ||
+				((item.Flags & ItemFlags::Directory) == ItemFlags::Directory && std::uint64_t(item.FirstChild) + item.ChildCount > itemCount)) {
+				return false;
+			}
+		}
+		for (std::uint32_t slot : _hashTable) {
+			if (slot > itemCount) {
+				return false;
+			}
 		}
 
+		return true;
+	}
+
+	void PakFile::ReadTreeIndex(Stream& s, Array<Item>& items)
+	{
+		std::uint32_t itemCount = s.ReadVariableUint32();
+		items = Array<Item>(itemCount);
+
 		for (std::uint32_t i = 0; i < itemCount; i++) {
-			Item& item = (*items)[i];
+			Item& item = items[i];
 
-			item.Flags = (ItemFlags)s->ReadVariableUint32();
+			item.Flags = (ItemFlags)s.ReadVariableUint32();
 
-			std::uint32_t nameLength = s->ReadVariableUint32();
+			std::uint32_t nameLength = s.ReadVariableUint32();
 			DEATH_ASSERT(nameLength == 0 || nameLength < INT32_MAX, , "Malformed .pak file");
 			item.Name = String(NoInit, nameLength);
-			s->Read(item.Name.data(), static_cast<std::int32_t>(nameLength));
+			s.Read(item.Name.data(), static_cast<std::int32_t>(nameLength));
 
-			item.Offset = s->ReadVariableUint64();
+			item.Offset = s.ReadVariableUint64();
+			item.UncompressedSize = 0;
+			item.Size = 0;
 
 			if ((item.Flags & ItemFlags::Directory) != ItemFlags::Directory) {
-				item.UncompressedSize = s->ReadVariableUint32();
+				item.UncompressedSize = s.ReadVariableUint32();
 
 				if ((item.Flags & ItemFlags::ZlibCompressed) == ItemFlags::ZlibCompressed) {
-					item.Size = s->ReadVariableUint32();
+					item.Size = s.ReadVariableUint32();
 				}
 			}
 		}
 
 		for (std::uint32_t i = 0; i < itemCount; i++) {
-			Item& item = (*items)[i];
+			Item& item = items[i];
 			if ((item.Flags & ItemFlags::Directory) == ItemFlags::Directory) {
-				s->Seek(static_cast<std::int64_t>(item.Offset), SeekOrigin::Begin);
-				ReadIndex(s, &item);
+				s.Seek(static_cast<std::int64_t>(item.Offset), SeekOrigin::Begin);
+				ReadTreeIndex(s, item.ChildItems);
 			}
 		}
 	}
 
+	void PakFile::WriteIndex(Stream& s, Array<Item>& rootItems)
+	{
+		struct QueuedDirectory {
+			Array<Item>* Items;
+			std::uint32_t ItemIndex;
+			String Path;
+		};
+
+		Array<IndexItem> items;
+		Array<char> paths;
+		Array<QueuedDirectory> queuedDirectories;
+
+		IndexItem& root = arrayAppend(items, IndexItem());
+		root.PathHash = HashPath({});
+		root.Flags = ItemFlags::Directory;
+		arrayAppend(queuedDirectories, QueuedDirectory { &rootItems, 0, {} });
+
+		// Breadth-first traversal, so children of each directory end up next to each other
+		for (std::size_t i = 0; i < queuedDirectories.size(); i++) {
+			Array<Item>& childItems = *queuedDirectories[i].Items;
+			std::uint32_t parentIndex = queuedDirectories[i].ItemIndex;
+			String parentPath = queuedDirectories[i].Path;
+
+			// Names need to be sorted, so directory enumeration returns them in stable order
+			std::sort(childItems.begin(), childItems.end(), [](const Item& a, const Item& b) {
+				return a.Name < b.Name;
+			});
+
+			items[parentIndex].FirstChild = static_cast<std::uint32_t>(items.size());
+			items[parentIndex].ChildCount = static_cast<std::uint32_t>(childItems.size());
+
+			for (Item& childItem : childItems) {
+				String path = (parentPath.empty() ? String(childItem.Name) : String(parentPath + "/"_s + childItem.Name));
+
+				IndexItem& item = arrayAppend(items, IndexItem());
+				item.PathHash = HashPath(path);
+				item.Flags = childItem.Flags;
+				item.PathOffset = static_cast<std::uint32_t>(paths.size());
+				item.PathLength = static_cast<std::uint32_t>(path.size());
+				item.NameLength = static_cast<std::uint32_t>(childItem.Name.size());
+				arrayAppend(paths, arrayView(path.data(), path.size()));
+
+				if ((childItem.Flags & ItemFlags::Directory) == ItemFlags::Directory) {
+					arrayAppend(queuedDirectories, QueuedDirectory { &childItem.ChildItems, static_cast<std::uint32_t>(items.size() - 1), std::move(path) });
+				} else {
+					item.Offset = childItem.Offset;
+					item.UncompressedSize = childItem.UncompressedSize;
+					item.Size = childItem.Size;
+				}
+			}
+		}
+
+		// Open addressing with linear probing, the table is kept at most half full
+		std::uint32_t hashTableSize = 16;
+		while (hashTableSize < items.size() * 2) {
+			hashTableSize <<= 1;
+		}
+		Array<std::uint32_t> hashTable(ValueInit, hashTableSize);
+		for (std::uint32_t i = 0; i < items.size(); i++) {
+			std::uint32_t slot = static_cast<std::uint32_t>(items[i].PathHash) & (hashTableSize - 1);
+			while (hashTable[slot] != 0) {
+				slot = (slot + 1) & (hashTableSize - 1);
+			}
+			hashTable[slot] = i + 1;
+		}
+
+		s.WriteValue<std::uint32_t>(static_cast<std::uint32_t>(items.size()));
+		s.WriteValue<std::uint32_t>(hashTableSize);
+		s.WriteValue<std::uint32_t>(static_cast<std::uint32_t>(paths.size()));
+		s.WriteValue<std::uint32_t>(0);
+		s.Write(items.data(), static_cast<std::int32_t>(items.size() * sizeof(IndexItem)));
+		s.Write(hashTable.data(), static_cast<std::int32_t>(hashTable.size() * sizeof(std::uint32_t)));
+		s.Write(paths.data(), static_cast<std::int32_t>(paths.size()));
+	}
+
+	std::uint64_t PakFile::HashPath(StringView path)
+	{
+		// 64-bit FNV-1a
+		std::uint64_t hash = PathHashOffsetBasis;
+		for (char c : path) {
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= PathHashPrime;
+		}
+		return hash;
+	}
+
 	bool PakFile::FileExists(const Containers::StringView path)
 	{
-		Item* foundItem = FindItem(path);
+		const IndexItem* foundItem = FindItem(path);
 		return (foundItem != nullptr && (foundItem->Flags & ItemFlags::Directory) != ItemFlags::Directory);
 	}
 
 	bool PakFile::DirectoryExists(const Containers::StringView path)
 	{
-		Item* foundItem = FindItem(path);
+		const IndexItem* foundItem = FindItem(path);
 		return (foundItem != nullptr && (foundItem->Flags & ItemFlags::Directory) == ItemFlags::Directory);
 	}
 
@@ -273,52 +512,113 @@ namespace Death { namespace IO {
 			return nullptr;
 		}
 
-		Item* foundItem = FindItem(path);
+		const IndexItem* foundItem = FindItem(path);
 		if (foundItem == nullptr || (foundItem->Flags & ItemFlags::Directory) == ItemFlags::Directory) {
 			return nullptr;
 		}
 
-#if defined(WITH_ZLIB)
-		if ((foundItem->Flags & ItemFlags::ZlibCompressed) == ItemFlags::ZlibCompressed) {
-			return std::make_unique<ZlibCompressedBoundedStream>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size);
+		ItemFlags compression = (foundItem->Flags & ItemFlags::CompressionMask);
+		std::uint32_t size = (compression != ItemFlags::None ? foundItem->Size : foundItem->UncompressedSize);
+
+		std::unique_ptr<Stream> s;
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (_mappedFile != nullptr) {
+			if (foundItem->Offset > _mappedFile->size() || size > _mappedFile->size() - foundItem->Offset) {
+				return nullptr;
+			}
+			// Uncompressed files are returned directly as views into the mapping
+			s = std::make_unique<MappedBoundedStream>(_mappedFile, foundItem->Offset, size);
+		} else
+#endif
+		{
+			s = std::make_unique<BoundedStream>(_path, foundItem->Offset, size);
 		}
+
+		switch (compression) {
+			case ItemFlags::None: {
+				return s;
+			}
+#if defined(WITH_ZLIB)
+			case ItemFlags::ZlibCompressed: {
+				return std::make_unique<ZlibCompressedBoundedStream>(std::move(s), foundItem->UncompressedSize, foundItem->Size);
+			}
 #endif
+#if defined(WITH_LZ4) || defined(WITH_ZSTD)
+			case ItemFlags::Lz4Compressed:
+			case ItemFlags::ZstdCompressed: {
+				// Block codecs decompress the whole file at once, compressed data are read without copying if possible
+				std::unique_ptr<std::uint8_t[]> compressedBuffer;
+				const std::uint8_t* compressedData = s->GetContentView().data();
+				if (compressedData == nullptr) {
+					compressedBuffer = std::make_unique<std::uint8_t[]>(size);
+					if (s->Read(compressedBuffer.get(), static_cast<std::int32_t>(size)) != static_cast<std::int32_t>(size)) {
+						return nullptr;
+					}
+					compressedData = compressedBuffer.get();
+				}
 
-		return std::make_unique<BoundedStream>(_path, foundItem->Offset, foundItem->UncompressedSize);
+				std::unique_ptr<std::uint8_t[]> buffer = std::make_unique<std::uint8_t[]>(foundItem->UncompressedSize);
+				bool success = false;
+#	if defined(WITH_LZ4)
+				if (compression == ItemFlags::Lz4Compressed) {
+					std::int32_t result = LZ4_decompress_safe(reinterpret_cast<const char*>(compressedData), reinterpret_cast<char*>(buffer.get()),
+						static_cast<std::int32_t>(size), static_cast<std::int32_t>(foundItem->UncompressedSize));
+					success = (result == static_cast<std::int32_t>(foundItem->UncompressedSize));
+				}
+#	endif
+#	if defined(WITH_ZSTD)
+				if (compression == ItemFlags::ZstdCompressed) {
+					std::size_t result = ZSTD_decompress(buffer.get(), foundItem->UncompressedSize, compressedData, size);
+					success = (result == foundItem->UncompressedSize);
+				}
+#	endif
+				if (!success) {
+					LOGE("Failed to decompress file \"%s\" from .pak file", String::nullTerminatedView(path).data());
+					return nullptr;
+				}
+				return std::make_unique<DecompressedStream>(std::move(buffer), foundItem->UncompressedSize);
+			}
+#endif
+			default: {
+				// Compression method is not supported
+				return nullptr;
+			}
+		}
 	}
 
-	PakFile::Item* PakFile::FindItem(StringView path)
+	const PakFile::IndexItem* PakFile::FindItem(StringView path) const
 	{
-		path = path.trimmedPrefix("/\\");
-
-		Array<Item>* items = &_rootItems;
-		while (true) {
-			auto separator = path.findAnyOr("/\\", path.end());
-			auto name = path.prefix(separator.begin());
-
-			if (name.empty()) {
-				// Skip all consecutive slashes
-				path = path.suffix(separator.end());
-				continue;
-			}
+		if (_items.empty()) {
+			return nullptr;
+		}
 
-			// Items are always sorted by PakWriter
-			Item* foundItem = std::lower_bound(items->begin(), items->end(), name, [](const PakFile::Item& a, const StringView& b) {
-				return a.Name < b;
-			});
+		char normalizedPath[FileSystem::MaxPathLength];
+		std::int32_t length = NormalizePath(path, normalizedPath, sizeof(normalizedPath));
+		if (length <= 0) {
+			return (length == 0 ? &_items[0] : nullptr);
+		}
 
-			if (foundItem == items->end() || foundItem->Name != name) {
-				return nullptr;
+		StringView normalized(normalizedPath, static_cast<std::size_t>(length));
+		std::uint64_t hash = HashPath(normalized);
+		std::uint32_t mask = static_cast<std::uint32_t>(_hashTable.size() - 1);
+		std::uint32_t slot = static_cast<std::uint32_t>(hash) & mask;
+		for (std::size_t i = 0; i < _hashTable.size(); i++) {
+			std::uint32_t itemIndex = _hashTable[slot];
+			if (itemIndex == 0) {
+				break;
 			}
-
-			if (separator == path.end()) {
-				// If there is no separator left
-				return foundItem;
+			const IndexItem& item = _items[itemIndex - 1];
+			if (item.PathHash == hash && _paths.slice(item.PathOffset, item.PathOffset + item.PathLength) == normalized) {
+				return &item;
 			}
-
-			path = path.suffix(separator.end());
-			items = &foundItem->ChildItems;
+			slot = (slot + 1) & mask;
 		}
+		return nullptr;
+	}
+
+	StringView PakFile::GetItemName(const IndexItem& item) const
+	{
+		return _paths.slice(item.PathOffset + item.PathLength - item.NameLength, item.PathOffset + item.PathLength);
 	}
 
 	class PakFile::Directory::Impl
@@ -338,20 +638,16 @@ namespace Death { namespace IO {
 		bool Open(PakFile& pakFile, const StringView path, FileSystem::EnumerationOptions options)
 		{
 			_options = options;
-			if (path.empty()) {
-				_childItems = pakFile._rootItems;
-			} else {
-				Item* parentItem = pakFile.FindItem(path);
-				if (parentItem == nullptr) {
-					_path[0] = '\0';
-					return false;
-				}
+			_pakFile = &pakFile;
 
-				_childItems = parentItem->ChildItems;
+			const IndexItem* parentItem = pakFile.FindItem(path);
+			if (parentItem == nullptr || (parentItem->Flags & ItemFlags::Directory) != ItemFlags::Directory) {
+				_path[0] = '\0';
+				return false;
 			}
 
+			_childItems = pakFile._items.slice(parentItem->FirstChild, parentItem->FirstChild + parentItem->ChildCount);
 			_index = 0;
-
 			if (!_childItems.empty()) {
 				std::size_t pathLength = path.size();
 				if (pathLength > 0) {
@@ -394,7 +690,7 @@ namespace Death { namespace IO {
 					return;
 				}
 
-				Item& item = _childItems[_index];
+				const IndexItem& item = _childItems[_index];
 				if (((_options & FileSystem::EnumerationOptions::SkipDirectories) == FileSystem::EnumerationOptions::SkipDirectories && (item.Flags & ItemFlags::Directory) == ItemFlags::Directory) ||
 					((_options & FileSystem::EnumerationOptions::SkipFiles) == FileSystem::EnumerationOptions::SkipFiles && (item.Flags & ItemFlags::Directory) != ItemFlags::Directory)) {
 					// Skip this file
@@ -405,14 +701,11 @@ namespace Death { namespace IO {
 				break;
 			}
 
-			auto& fileName = _childItems[_index].Name;
-#if defined(DEATH_TARGET_WINDOWS)
-			strncpy_s(_fileNamePart, sizeof(_path) - (_fileNamePart - _path), fileName.data(), fileName.size());
-#else
-			strncpy(_fileNamePart, fileName.data(), std::min(sizeof(_path) - (_fileNamePart - _path), fileName.size()) - 1);
-			_path[sizeof(_path) - 1] = '\0';
-#endif
-
+			// Names in the index aren't null-terminated
+			StringView fileName = _pakFile->GetItemName(_childItems[_index]);
+			std::size_t length = std::min(sizeof(_path) - (_fileNamePart - _path) - 1, fileName.size());
+			std::memcpy(_fileNamePart, fileName.data(), length);
+			_fileNamePart[length] = '\0';
 
 			_index++;
 		}
@@ -422,7 +715,8 @@ namespace Death { namespace IO {
 		FileSystem::EnumerationOptions _options;
 		char _path[FileSystem::MaxPathLength];
 		char* _fileNamePart;
-		Containers::ArrayView<Item> _childItems;
+		PakFile* _pakFile;
+		Containers::ArrayView<const IndexItem> _childItems;
 		std::size_t _index;
 	};
 
@@ -497,6 +791,13 @@ namespace Death { namespace IO {
 		return _path;
 	}
 
+	namespace
+	{
+		constexpr std::int32_t ZlibCompressionLevel = 9;
+		constexpr std::int32_t Lz4CompressionLevel = 12;
+		constexpr std::int32_t ZstdCompressionLevel = 19;
+	}
+
 	PakWriter::PakWriter(const StringView path)
 		: _finalized(false)
 	{
@@ -514,11 +815,34 @@ namespace Death { namespace IO {
 	}
 
 	bool PakWriter::AddFile(Stream& stream, StringView path, bool compress)
+	{
+		return AddFile(stream, path, compress ? Compression::Zlib : Compression::None);
+	}
+
+	bool PakWriter::AddFile(Stream& stream, StringView path, Compression compression)
 	{
 		DEATH_ASSERT(_outputStream->IsValid(), false, "Invalid output stream specified");
 		DEATH_ASSERT(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\', false, "Invalid file path to add");
 
-		PakFile::Item* parentItem = FindOrCreateParentItem(path);
+		// Fall back to other compression methods if the requested one is not available
+#if !defined(WITH_LZ4)
+		if (compression == Compression::Lz4) {
+			compression = Compression::Zlib;
+		}
+#endif
+#if !defined(WITH_ZSTD)
+		if (compression == Compression::Zstd) {
+			compression = Compression::Zlib;
+		}
+#endif
+#if !defined(WITH_ZLIB)
+		if (compression == Compression::Zlib) {
+			compression = Compression::None;
+		}
+#endif
+
+		Array<std::uint32_t> itemPath;
+		PakFile::Item* parentItem = FindOrCreateParentItem(path, &itemPath);
 		Array<PakFile::Item>* items;
 		if (parentItem != nullptr) {
 			items = &parentItem->ChildItems;
@@ -533,34 +857,38 @@ namespace Death { namespace IO {
 			}
 		}
 
-		PakFile::ItemFlags flags = PakFile::ItemFlags::None;
-		std::int64_t offset = _outputStream->GetPosition();
-		std::int64_t uncompressedSize, size;
-
-#if defined(WITH_ZLIB)
-		if (compress) {
-			DeflateWriter dw(*_outputStream);
-			uncompressedSize = stream.CopyTo(dw);
-			dw.Close();
-			size = _outputStream->GetPosition() - offset;
-			flags |= PakFile::ItemFlags::ZlibCompressed;
-		} else
-#endif
-		{
+		std::int64_t offset = 0;
+		std::int64_t uncompressedSize;
+		// Compressed files are kept in memory, so they can be compressed in parallel when the file is finalized
+		std::unique_ptr<MemoryStream> ms;
+		if (compression == Compression::None) {
+			offset = _outputStream->GetPosition();
 			uncompressedSize = stream.CopyTo(*_outputStream);
-			size = 0;
+		} else {
+			ms = std::make_unique<MemoryStream>(stream.GetSize() > 0 ? stream.GetSize() : 0);
+			uncompressedSize = stream.CopyTo(*ms);
 		}
 
 		DEATH_ASSERT(uncompressedSize > 0, false, "Failed to copy stream to .pak file");
 		// NOTE: Files inside .pak are limited to 4GBs only for now
-		DEATH_ASSERT(uncompressedSize < UINT32_MAX && size < UINT32_MAX, false, "File size in .pak file exceeded the allowed range");
+		DEATH_ASSERT(uncompressedSize < UINT32_MAX, false, "File size in .pak file exceeded the allowed range");
+
+		if (ms != nullptr) {
+			PendingFile& pendingFile = arrayAppend(_pendingFiles, PendingFile());
+			pendingFile.ItemPath = std::move(itemPath);
+			arrayAppend(pendingFile.ItemPath, static_cast<std::uint32_t>(items->size()));
+			pendingFile.Method = compression;
+			pendingFile.Data = Array<std::uint8_t>(NoInit, static_cast<std::size_t>(uncompressedSize));
+			std::memcpy(pendingFile.Data.data(), ms->GetBuffer(), static_cast<std::size_t>(uncompressedSize));
+			pendingFile.CompressedSize = 0;
+		}
 
 		PakFile::Item* newItem = &arrayAppend(*items, PakFile::Item());
 		newItem->Name = path;
-		newItem->Flags = flags;
+		newItem->Flags = PakFile::ItemFlags::None;
 		newItem->Offset = offset;
 		newItem->UncompressedSize = static_cast<std::uint32_t>(uncompressedSize);
-		newItem->Size = static_cast<std::uint32_t>(size);
+		newItem->Size = 0;
 
 		return true;
 	}
@@ -573,15 +901,7 @@ namespace Death { namespace IO {
 
 		_finalized = true;
 
-		Array<PakFile::Item*> queuedDirectories;
-
-		for (PakFile::Item& item : _rootItems) {
-			if ((item.Flags & PakFile::ItemFlags::Directory) == PakFile::ItemFlags::Directory) {
-				arrayAppend(queuedDirectories, &item);
-			}
-		}
-
-		if (queuedDirectories.empty()) {
+		if (_rootItems.empty()) {
 			// No files added - close the stream and try to delete the file
 			auto path = _outputStream->GetPath();
 			_outputStream = nullptr;
@@ -589,51 +909,42 @@ namespace Death { namespace IO {
 			return;
 		}
 
-		for (std::int32_t i = 0; i < queuedDirectories.size(); i++) {
-			PakFile::Item& item = *queuedDirectories[i];
-			for (PakFile::Item& child : item.ChildItems) {
-				if ((child.Flags & PakFile::ItemFlags::Directory) == PakFile::ItemFlags::Directory) {
-					arrayAppend(queuedDirectories, &child);
+		CompressPendingFiles();
+
+		// Files are written in the same order as they were added, so the output doesn't depend on scheduling
+		for (PendingFile& pendingFile : _pendingFiles) {
+			PakFile::Item* item = GetItem(pendingFile.ItemPath);
+			item->Offset = _outputStream->GetPosition();
+			if (pendingFile.CompressedSize > 0 && pendingFile.CompressedSize < pendingFile.Data.size()) {
+				switch (pendingFile.Method) {
+					case Compression::Zlib: item->Flags |= PakFile::ItemFlags::ZlibCompressed; break;
+					case Compression::Lz4: item->Flags |= PakFile::ItemFlags::Lz4Compressed; break;
+					case Compression::Zstd: item->Flags |= PakFile::ItemFlags::ZstdCompressed; break;
+					default: break;
 				}
+				item->Size = static_cast<std::uint32_t>(pendingFile.CompressedSize);
+				_outputStream->Write(pendingFile.CompressedData.data(), static_cast<std::int32_t>(pendingFile.CompressedSize));
+			} else {
+				// Compression didn't help, so the file is stored uncompressed
+				_outputStream->Write(pendingFile.Data.data(), static_cast<std::int32_t>(pendingFile.Data.size()));
 			}
 		}
-
-		std::size_t i = queuedDirectories.size() - 1;
-		while (true) {
-			PakFile::Item& item = *queuedDirectories[i];
-			item.Offset = _outputStream->GetPosition();
-
-			// Names need to be sorted, because binary search is used to find files
-			std::sort(item.ChildItems.begin(), item.ChildItems.end(), [](const PakFile::Item& a, const PakFile::Item& b) {
-				return a.Name < b.Name;
-			});
-
-			_outputStream->WriteVariableUint32(static_cast<std::uint32_t>(item.ChildItems.size()));
-			for (PakFile::Item& childItem : item.ChildItems) {
-				WriteItemDescription(childItem);
-			}
-
-			if DEATH_UNLIKELY(i == 0) {
-				break;
-			}
-			i--;
-		}
+		_pendingFiles = {};
 
 		std::int64_t rootIndexOffset = _outputStream->GetPosition();
 
 		_outputStream->WriteVariableUint32(static_cast<std::uint32_t>(MountPoint.size()));
 		_outputStream->Write(MountPoint.data(), static_cast<std::int32_t>(MountPoint.size()));
 
-		// Names need to be sorted, because binary search is used to find files
-		std::sort(_rootItems.begin(), _rootItems.end(), [](const PakFile::Item& a, const PakFile::Item& b) {
-			return a.Name < b.Name;
-		});
-
-		_outputStream->WriteVariableUint32(static_cast<std::uint32_t>(_rootItems.size()));
-		for (PakFile::Item& item : _rootItems) {
-			WriteItemDescription(item);
+		// Flat index is aligned to 8 bytes, so it can be used directly from memory-mapped file
+		static const char Padding[8] = { };
+		std::int32_t paddingSize = static_cast<std::int32_t>(-_outputStream->GetPosition() & 7);
+		if (paddingSize > 0) {
+			_outputStream->Write(Padding, paddingSize);
 		}
 
+		PakFile::WriteIndex(*_outputStream, _rootItems);
+
 		_outputStream->WriteValue<std::uint64_t>(PakFile::Signature);
 		_outputStream->WriteValue<std::uint16_t>(PakFile::Version);
 		_outputStream->WriteValue<std::uint64_t>(rootIndexOffset);
@@ -642,7 +953,70 @@ namespace Death { namespace IO {
 		_outputStream = nullptr;
 	}
 
-	PakFile::Item* PakWriter::FindOrCreateParentItem(StringView& path)
+	void PakWriter::CompressPendingFiles()
+	{
+		// Each file is compressed independently with fixed settings, so the result is always the same
+		auto compressRange = [&](std::int32_t first, std::int32_t last) {
+			for (std::int32_t i = first; i < last; i++) {
+				PendingFile& pendingFile = _pendingFiles[i];
+				std::size_t size = pendingFile.Data.size();
+				switch (pendingFile.Method) {
+#if defined(WITH_ZLIB)
+					case Compression::Zlib: {
+						pendingFile.CompressedData = Array<std::uint8_t>(NoInit, static_cast<std::size_t>(DeflateWriter::GetMaxDeflatedSize(size)));
+						MemoryStream ms(pendingFile.CompressedData.data(), static_cast<std::int64_t>(pendingFile.CompressedData.size()));
+						DeflateWriter dw(ms, ZlibCompressionLevel);
+						dw.Write(pendingFile.Data.data(), static_cast<std::int32_t>(size));
+						dw.Close();
+						pendingFile.CompressedSize = static_cast<std::size_t>(ms.GetPosition());
+						break;
+					}
+#endif
+#if defined(WITH_LZ4)
+					case Compression::Lz4: {
+						pendingFile.CompressedData = Array<std::uint8_t>(NoInit, static_cast<std::size_t>(LZ4_compressBound(static_cast<std::int32_t>(size))));
+						std::int32_t result = LZ4_compress_HC(reinterpret_cast<const char*>(pendingFile.Data.data()), reinterpret_cast<char*>(pendingFile.CompressedData.data()),
+							static_cast<std::int32_t>(size), static_cast<std::int32_t>(pendingFile.CompressedData.size()), Lz4CompressionLevel);
+						pendingFile.CompressedSize = static_cast<std::size_t>(std::max(result, 0));
+						break;
+					}
+#endif
+#if defined(WITH_ZSTD)
+					case Compression::Zstd: {
+						pendingFile.CompressedData = Array<std::uint8_t>(NoInit, ZSTD_compressBound(size));
+						std::size_t result = ZSTD_compress(pendingFile.CompressedData.data(), pendingFile.CompressedData.size(), pendingFile.Data.data(), size, ZstdCompressionLevel);
+						pendingFile.CompressedSize = (ZSTD_isError(result) ? 0 : result);
+						break;
+					}
+#endif
+					default: {
+						pendingFile.CompressedSize = 0;
+						break;
+					}
+				}
+			}
+		};
+
+		std::int32_t count = static_cast<std::int32_t>(_pendingFiles.size());
+		if (ParallelFor) {
+			ParallelFor(count, compressRange);
+		} else {
+			compressRange(0, count);
+		}
+	}
+
+	PakFile::Item* PakWriter::GetItem(ArrayView<const std::uint32_t> itemPath)
+	{
+		Array<PakFile::Item>* items = &_rootItems;
+		PakFile::Item* item = nullptr;
+		for (std::uint32_t index : itemPath) {
+			item = &(*items)[index];
+			items = &item->ChildItems;
+		}
+		return item;
+	}
+
+	PakFile::Item* PakWriter::FindOrCreateParentItem(StringView& path, Array<std::uint32_t>* itemPath)
 	{
 		path = path.trimmedPrefix("/\\");
 
@@ -670,28 +1044,14 @@ namespace Death { namespace IO {
 				foundItem->Flags = PakFile::ItemFlags::Directory;
 			}
 
+			if (itemPath != nullptr) {
+				arrayAppend(*itemPath, static_cast<std::uint32_t>(foundItem - items->data()));
+			}
+
 			path = path.suffix(separator.end());
 			parentItem = foundItem;
 			items = &foundItem->ChildItems;
 		}
 	}
 
-	void PakWriter::WriteItemDescription(PakFile::Item& item)
-	{
-		_outputStream->WriteVariableUint32((std::uint32_t)item.Flags);
-
-		_outputStream->WriteVariableUint32(static_cast<std::uint32_t>(item.Name.size()));
-		_outputStream->Write(item.Name.data(), static_cast<std::int32_t>(item.Name.size()));
-
-		_outputStream->WriteVariableUint64(item.Offset);
-
-		if ((item.Flags & PakFile::ItemFlags::Directory) != PakFile::ItemFlags::Directory) {
-			_outputStream->WriteVariableUint32(item.UncompressedSize);
-
-			if ((item.Flags & PakFile::ItemFlags::ZlibCompressed) == PakFile::ItemFlags::ZlibCompressed) {
-				_outputStream->WriteVariableUint32(item.Size);
-			}
-		}
-	}
-
 }}
\ No newline at end of file
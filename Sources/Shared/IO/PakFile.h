@@ -1,12 +1,14 @@
 #pragma once
 
 #include "../Common.h"
+#include "../Base/FunctionRef.h"
 #include "../Containers/Array.h"
 #include "../Containers/String.h"
 #include "FileStream.h"
 #include "FileSystem.h"
 
 #include <cstdio>		// For FILE
+#include <functional>
 #include <memory>
 
 namespace Death { namespace IO {
@@ -92,11 +94,16 @@ namespace Death { namespace IO {
 		enum class ItemFlags : std::uint32_t {
 			None = 0,
 			Directory = 0x01,
-			ZlibCompressed = 0x02
+			ZlibCompressed = 0x02,
+			Lz4Compressed = 0x04,
+			ZstdCompressed = 0x08,
+
+			CompressionMask = ZlibCompressed | Lz4Compressed | ZstdCompressed
 		};
 
 		DEFINE_PRIVATE_ENUM_OPERATORS(ItemFlags);
 
+		/** @brief Item of directory tree, used only while the index is being built */
 		struct Item {
 			Containers::String Name;
 			ItemFlags Flags;
@@ -107,22 +114,67 @@ namespace Death { namespace IO {
 			Containers::Array<Item> ChildItems;
 		};
 
+		/** @brief Item of flat index, children of each directory are stored contiguously and sorted by name */
+		struct IndexItem {
+			std::uint64_t PathHash;
+			std::uint64_t Offset;
+			std::uint32_t UncompressedSize;
+			std::uint32_t Size;
+			ItemFlags Flags;
+			std::uint32_t PathOffset;
+			std::uint32_t PathLength;
+			std::uint32_t NameLength;
+			std::uint32_t FirstChild;
+			std::uint32_t ChildCount;
+		};
+
+		static_assert(sizeof(IndexItem) == 48, "IndexItem must be tightly packed");
+
 		static constexpr std::uint64_t Signature = 0x208FA69FF0BFBBEF;
-		static constexpr std::uint16_t Version = 1;
+		static constexpr std::uint16_t Version = 3;
+		/** @brief Version of .pak files with hierarchical index, it's converted to flat index on load */
+		static constexpr std::uint16_t TreeIndexVersion = 1;
+		/** @brief Size of the header of flat index in bytes */
+		static constexpr std::uint32_t IndexHeaderSize = 16;
 
 		Containers::String _path;
 		Containers::String _mountPoint;
-		Containers::Array<Item> _rootItems;
-
-		void ReadIndex(std::unique_ptr<Stream>& s, Item* parentItem);
-
-		Item* FindItem(Containers::StringView path);
+		// Owned copy of the index, it's empty if the index is used directly from the mapped file
+		std::unique_ptr<std::uint64_t[]> _indexData;
+		Containers::ArrayView<const IndexItem> _items;
+		Containers::ArrayView<const std::uint32_t> _hashTable;
+		Containers::StringView _paths;
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		// Whole file is mapped only once, opened streams share the mapping, so they stay valid even if the file is unmounted
+		std::shared_ptr<Containers::Array<char, FileSystem::MapDeleter>> _mappedFile;
+#endif
+
+		bool LoadIndex(const std::uint8_t* data, std::int64_t size);
+		const IndexItem* FindItem(Containers::StringView path) const;
+		Containers::StringView GetItemName(const IndexItem& item) const;
+
+		static void ReadTreeIndex(Stream& s, Containers::Array<Item>& items);
+		static void WriteIndex(Stream& s, Containers::Array<Item>& rootItems);
+		static std::uint64_t HashPath(Containers::StringView path);
 	};
 
 	class PakWriter
 	{
 	public:
+		/** @brief Compression method of a file */
+		enum class Compression {
+			None,
+			/** @brief Deflate, good compatibility */
+			Zlib,
+			/** @brief LZ4, very fast decompression with lower compression ratio */
+			Lz4,
+			/** @brief Zstandard, better compression ratio than LZ4, but slower compression */
+			Zstd
+		};
+
 		Containers::String MountPoint;
+		/** @brief Function that calls the callback for all subranges of `[0, count)`, files are compressed in parallel if it's set */
+		std::function<void(std::int32_t, Death::FunctionRef<void(std::int32_t, std::int32_t)>)> ParallelFor;
 
 		explicit PakWriter(const Containers::StringView path);
 		~PakWriter();
@@ -133,15 +185,28 @@ namespace Death { namespace IO {
 		bool IsValid() const;
 
 		bool AddFile(Stream& stream, Containers::StringView path, bool compress = false);
+		/** @brief Adds a file, compressed files are kept in memory and written in the same order by @ref Finalize() */
+		bool AddFile(Stream& stream, Containers::StringView path, Compression compression);
 		void Finalize();
 
 	private:
+		struct PendingFile {
+			/** @brief Indices of the item and all its parents starting from the root, they don't change while items are added */
+			Containers::Array<std::uint32_t> ItemPath;
+			Compression Method;
+			Containers::Array<std::uint8_t> Data;
+			Containers::Array<std::uint8_t> CompressedData;
+			std::size_t CompressedSize;
+		};
+
 		std::unique_ptr<FileStream> _outputStream;
 		Containers::Array<PakFile::Item> _rootItems;
+		Containers::Array<PendingFile> _pendingFiles;
 		bool _finalized;
 
-		PakFile::Item* FindOrCreateParentItem(Containers::StringView& path);
-		void WriteItemDescription(PakFile::Item& item);
+		PakFile::Item* FindOrCreateParentItem(Containers::StringView& path, Containers::Array<std::uint32_t>* itemPath = nullptr);
+		PakFile::Item* GetItem(Containers::ArrayView<const std::uint32_t> itemPath);
+		void CompressPendingFiles();
 	};
 
 }}
\ No newline at end of file
@@ -12,6 +12,7 @@
 #endif
 
 #include "../Common.h"
+#include "../Containers/ArrayView.h"
 
 #include <cstdio>		// For FILE
 #include <memory>
@@ -72,6 +73,15 @@ namespace Death { namespace IO {
 
 		virtual void SetCloseOnDestruction(bool shouldCloseOnDestruction) { }
 
+		/**
+			@brief Returns the whole content of the stream if it's already in memory, otherwise an empty view
+
+			The view allows to access the content without copying it, it stays valid only until the stream is closed or destroyed.
+		*/
+		virtual Containers::ArrayView<const std::uint8_t> GetContentView() const {
+			return { };
+		}
+
 		/** @brief Reads the bytes from the current stream and writes them to the target stream */
 		std::int64_t CopyTo(Stream& targetStream);
 
@@ -495,6 +495,7 @@ namespace nCine
 		}
 #endif
 
+#if !defined(DEDICATED_SERVER)
 		theServiceLocator().registerGfxCapabilities(std::make_unique<GfxCapabilities>());
 		const auto& gfxCapabilities = theServiceLocator().gfxCapabilities();
 		GLDebug::init(gfxCapabilities);
@@ -522,12 +523,17 @@ namespace nCine
 		gfxDevice_->update();
 		FrameMark;
 		TracyGpuCollect;
+#endif
 
 		frameTimer_ = std::make_unique<FrameTimer>(appCfg_.frameTimerLogInterval, 0.2f);
 #if defined(DEATH_TARGET_WINDOWS)
 		_waitableTimer = ::CreateWaitableTimer(NULL, TRUE, NULL);
 #endif
 
+#if defined(DEDICATED_SERVER)
+		// Nothing is rendered on dedicated server, so only the root node is needed to update the scenegraph
+		rootNode_ = std::make_unique<SceneNode>();
+#else
 		LOGI("Creating rendering resources...");
 
 		// Create a minimal set of render resources before compiling the first shader
@@ -540,6 +546,7 @@ namespace nCine
 			screenViewport_ = std::make_unique<ScreenViewport>();
 			screenViewport_->setRootNode(rootNode_.get());
 		}
+#endif
 
 #if defined(WITH_IMGUI)
 		imguiDrawing_ = std::make_unique<ImGuiDrawing>(appCfg_.withScenegraph);
@@ -573,15 +580,22 @@ namespace nCine
 		imguiDrawing_->buildFonts();
 #endif
 
+#if !defined(DEDICATED_SERVER)
 		// Swapping frame now for a cleaner API trace capture when debugging
 		gfxDevice_->update();
 		FrameMark;
 		TracyGpuCollect;
+#endif
 	}
 
 	void Application::step()
 	{
+#if defined(DEDICATED_SERVER)
+		// Dedicated server is always running at fixed tick rate, see `MainApplication::runFixedTick()`
+		frameTimer_->addFrame(FrameTimer::FramesPerSecond / static_cast<float>(appCfg_.frameLimit));
+#else
 		frameTimer_->addFrame();
+#endif
 
 #if defined(WITH_IMGUI)
 		{
@@ -616,6 +630,29 @@ namespace nCine
 		}
 #endif
 
+#if defined(DEDICATED_SERVER)
+		{
+			ZoneScopedNC("Update", 0x81A861);
+#	if defined(NCINE_PROFILING)
+			profileStartTime_ = TimeStamp::now();
+#	endif
+			rootNode_->OnUpdate(frameTimer_->timeMult());
+#	if defined(NCINE_PROFILING)
+			timings_[(int)Timings::Update] = profileStartTime_.secondsSince();
+#	endif
+		}
+
+		{
+			ZoneScopedNC("OnPostUpdate", 0x81A861);
+#	if defined(NCINE_PROFILING)
+			profileStartTime_ = TimeStamp::now();
+#	endif
+			appEventHandler_->OnPostUpdate();
+#	if defined(NCINE_PROFILING)
+			timings_[(int)Timings::PostUpdate] = profileStartTime_.secondsSince();
+#	endif
+		}
+#else
 		if (appCfg_.withScenegraph) {
 			ZoneScopedNC("SceneGraph", 0x81A861);
 			{
@@ -694,6 +731,7 @@ namespace nCine
 		{
 			theServiceLocator().audioDevice().updatePlayers();
 		}
+#endif
 
 		{
 			ZoneScopedNC("OnFrameEnd", 0x81A861);
@@ -712,6 +750,10 @@ namespace nCine
 		}
 #endif
 
+#if defined(DEDICATED_SERVER)
+		// Frame limiting is handled by the fixed tick scheduler
+		FrameMark;
+#else
 		gfxDevice_->update();
 		FrameMark;
 		TracyGpuCollect;
@@ -739,6 +781,7 @@ namespace nCine
 #endif
 			FrameMarkEnd("Frame limiting");
 		}
+#endif
 	}
 
 	void Application::shutdownCommon()
@@ -757,7 +800,9 @@ namespace nCine
 #endif
 
 		rootNode_.reset();
+#if !defined(DEDICATED_SERVER)
 		RenderResources::dispose();
+#endif
 		frameTimer_.reset();
 		inputManager_.reset();
 		gfxDevice_.reset();
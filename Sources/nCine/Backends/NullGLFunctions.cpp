@@ -0,0 +1,1127 @@
+#if defined(DEDICATED_SERVER) || defined(WITH_NULL_GFX)
+
+#define NCINE_INCLUDE_OPENGL
+#include "../CommonHeaders.h"
+
+#include "NullGLFunctions.h"
+#include "../Base/HashMap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+// OpenGL entry points for builds that don't create any OpenGL context and don't link any OpenGL library. Dedicated server
+// only needs them to satisfy the linker, because actors and UI still own render commands. Null graphics device calls them
+// at runtime, so they keep enough state for the renderer to work as usual: buffers have real storage, so they can be mapped,
+// and shader sources are parsed at link time, so uniforms, uniform blocks and attributes can be introspected. Nothing
+// is rasterized, only calls are counted.
+
+namespace nCine
+{
+	namespace
+	{
+		struct NullShader
+		{
+			GLenum type;
+			std::string source;
+		};
+
+		struct NullUniform
+		{
+			std::string name;
+			GLenum type;
+			GLint size;
+			GLint blockIndex;
+			GLint offset;
+			GLint location;
+		};
+
+		struct NullUniformBlock
+		{
+			std::string name;
+			GLint dataSize;
+			SmallVector<GLint, 0> uniformIndices;
+		};
+
+		struct NullAttribute
+		{
+			std::string name;
+			GLenum type;
+			GLint location;
+		};
+
+		struct NullProgram
+		{
+			SmallVector<GLuint, 2> shaders;
+			SmallVector<NullUniform, 0> uniforms;
+			SmallVector<NullUniformBlock, 0> uniformBlocks;
+			SmallVector<NullAttribute, 0> attributes;
+		};
+
+		struct NullBuffer
+		{
+			std::unique_ptr<std::uint8_t[]> data;
+			GLsizeiptr size = 0;
+			GLintptr mapOffset = 0;
+			GLsizeiptr mapLength = 0;
+			GLbitfield mapAccess = 0;
+		};
+
+		/// Layout of a GLSL type in a `std140` uniform block
+		struct TypeLayout
+		{
+			GLenum type;
+			GLint size;
+			GLint align;
+		};
+
+		struct StructMember
+		{
+			std::string typeName;
+			std::string name;
+			GLint arraySize;
+		};
+
+		struct StructType
+		{
+			std::string name;
+			SmallVector<StructMember, 0> members;
+		};
+
+		struct Define
+		{
+			std::string name;
+			std::string value;
+		};
+
+		GLuint lastName = 0;
+		HashMap<GLuint, NullShader> shaders;
+		HashMap<GLuint, NullProgram> programs;
+		HashMap<GLuint, NullBuffer> buffers;
+		HashMap<GLenum, GLuint> boundBuffers;
+		HashMap<GLuint, GLuint> vertexArrayElementBuffers;
+		GLuint boundVertexArray = 0;
+		NullGLCalls calls;
+
+		inline void recordCall()
+		{
+			calls.total++;
+		}
+
+		inline void recordBinding()
+		{
+			calls.total++;
+			calls.bindings++;
+		}
+
+		inline void recordUniform()
+		{
+			calls.total++;
+			calls.uniforms++;
+		}
+
+		inline void recordDraw(GLsizei instanceCount)
+		{
+			calls.total++;
+			calls.draws++;
+			calls.instances += instanceCount;
+		}
+
+		void generateNames(GLsizei n, GLuint* names)
+		{
+			for (GLsizei i = 0; i < n; i++) {
+				names[i] = ++lastName;
+			}
+		}
+
+		void copyName(const std::string& source, GLsizei bufSize, GLsizei* length, GLchar* name)
+		{
+			GLsizei copied = 0;
+			if (name != nullptr && bufSize > 0) {
+				copied = std::min(static_cast<GLsizei>(source.size()), bufSize - 1);
+				std::memcpy(name, source.data(), copied);
+				name[copied] = '\0';
+			}
+			if (length != nullptr) {
+				*length = copied;
+			}
+		}
+
+		NullBuffer* boundBuffer(GLenum target)
+		{
+			auto it = boundBuffers.find(target);
+			if (it == boundBuffers.end()) {
+				return nullptr;
+			}
+			auto bufferIt = buffers.find(it->second);
+			return (bufferIt != buffers.end() ? &bufferIt->second : nullptr);
+		}
+
+		void bindBuffer(GLenum target, GLuint buffer)
+		{
+			boundBuffers[target] = buffer;
+			if (target == GL_ELEMENT_ARRAY_BUFFER) {
+				// Element array buffer binding is part of the vertex array object state
+				vertexArrayElementBuffers[boundVertexArray] = buffer;
+			}
+		}
+
+		void allocateStorage(GLenum target, GLsizeiptr size, const void* data)
+		{
+			NullBuffer* buffer = boundBuffer(target);
+			if (buffer == nullptr) {
+				return;
+			}
+			buffer->data = std::make_unique<std::uint8_t[]>(size > 0 ? size : 1);
+			buffer->size = size;
+			if (data != nullptr) {
+				std::memcpy(buffer->data.get(), data, size);
+				calls.uploadedBytes += size;
+			}
+		}
+
+		GLint pixelSize(GLenum format, GLenum type)
+		{
+			GLint components;
+			switch (format) {
+				case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: components = 1; break;
+				case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL: components = 2; break;
+				case GL_RGB: case GL_RGB_INTEGER: components = 3; break;
+				default: components = 4; break;
+			}
+			switch (type) {
+				case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+				case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+				case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_5_5_5_1: return 2;
+				case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_2_10_10_10_REV: return 4;
+				default: return components * 4;
+			}
+		}
+
+		const Define* findDefine(const SmallVector<Define, 0>& defines, const std::string& name)
+		{
+			for (const Define& define : defines) {
+				if (define.name == name) {
+					return &define;
+				}
+			}
+			return nullptr;
+		}
+
+		/// Removes comments and inactive conditional blocks, definitions are collected in the order they appear
+		std::string preprocess(const std::string& source, SmallVector<Define, 0>& defines)
+		{
+			std::string code;
+			code.reserve(source.size());
+			for (std::size_t i = 0; i < source.size(); i++) {
+				if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/') {
+					while (i < source.size() && source[i] != '\n') {
+						i++;
+					}
+					code.push_back('\n');
+				} else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*') {
+					i += 2;
+					while (i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/')) {
+						if (source[i] == '\n') {
+							code.push_back('\n');
+						}
+						i++;
+					}
+					i++;
+					code.push_back(' ');
+				} else {
+					code.push_back(source[i]);
+				}
+			}
+
+			struct Condition
+			{
+				bool parentActive;
+				bool taken;
+				bool active;
+			};
+
+			SmallVector<Condition, 8> conditions;
+			std::string result;
+			result.reserve(code.size());
+			std::size_t lineStart = 0;
+			while (lineStart < code.size()) {
+				std::size_t lineEnd = code.find('\n', lineStart);
+				if (lineEnd == std::string::npos) {
+					lineEnd = code.size();
+				}
+				const bool active = (conditions.empty() || conditions.back().active);
+
+				std::size_t p = code.find_first_not_of(" \t\r", lineStart);
+				if (p != std::string::npos && p < lineEnd && code[p] == '#') {
+					p = code.find_first_not_of(" \t", p + 1);
+					if (p == std::string::npos || p > lineEnd) {
+						p = lineEnd;
+					}
+					std::size_t directiveEnd = code.find_first_of(" \t\r\n", p);
+					if (directiveEnd == std::string::npos || directiveEnd > lineEnd) {
+						directiveEnd = lineEnd;
+					}
+					const std::string directive = code.substr(p, directiveEnd - p);
+
+					std::size_t argStart = code.find_first_not_of(" \t", directiveEnd);
+					if (argStart == std::string::npos || argStart > lineEnd) {
+						argStart = lineEnd;
+					}
+					std::size_t argEnd = code.find_first_of(" \t\r\n", argStart);
+					if (argEnd == std::string::npos || argEnd > lineEnd) {
+						argEnd = lineEnd;
+					}
+					const std::string argument = code.substr(argStart, argEnd - argStart);
+
+					if (directive == "ifdef" || directive == "ifndef") {
+						const bool isDefined = (findDefine(defines, argument) != nullptr);
+						const bool value = (directive == "ifdef" ? isDefined : !isDefined);
+						conditions.push_back({ active, value, active && value });
+					} else if (directive == "if") {
+						// Only numeric conditions are evaluated, anything else is considered as true
+						const bool value = (argument.empty() || !(argument[0] >= '0' && argument[0] <= '9') || std::strtol(argument.c_str(), nullptr, 10) != 0);
+						conditions.push_back({ active, value, active && value });
+					} else if (directive == "elif" && !conditions.empty()) {
+						Condition& condition = conditions.back();
+						condition.active = (condition.parentActive && !condition.taken);
+						condition.taken = true;
+					} else if (directive == "else" && !conditions.empty()) {
+						Condition& condition = conditions.back();
+						condition.active = (condition.parentActive && !condition.taken);
+						condition.taken = true;
+					} else if (directive == "endif" && !conditions.empty()) {
+						conditions.pop_back();
+					} else if (directive == "define" && active && !argument.empty()) {
+						if (findDefine(defines, argument) == nullptr) {
+							std::size_t valueStart = code.find_first_not_of(" \t", argEnd);
+							if (valueStart == std::string::npos || valueStart > lineEnd) {
+								valueStart = lineEnd;
+							}
+							defines.push_back({ argument, code.substr(valueStart, lineEnd - valueStart) });
+						}
+					} else if (directive == "undef" && active) {
+						for (std::size_t i = 0; i < defines.size(); i++) {
+							if (defines[i].name == argument) {
+								defines.erase(defines.begin() + i);
+								break;
+							}
+						}
+					}
+				} else if (active) {
+					result.append(code, lineStart, lineEnd - lineStart);
+					result.push_back('\n');
+				}
+
+				lineStart = lineEnd + 1;
+			}
+			return result;
+		}
+
+		void tokenize(const std::string& code, SmallVector<std::string, 0>& tokens)
+		{
+			std::size_t i = 0;
+			while (i < code.size()) {
+				const char c = code[i];
+				if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+					i++;
+				} else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.') {
+					std::size_t start = i;
+					while (i < code.size() && ((code[i] >= 'a' && code[i] <= 'z') || (code[i] >= 'A' && code[i] <= 'Z') ||
+						   (code[i] >= '0' && code[i] <= '9') || code[i] == '_' || code[i] == '.')) {
+						i++;
+					}
+					tokens.push_back(code.substr(start, i - start));
+				} else {
+					tokens.push_back(std::string(1, c));
+					i++;
+				}
+			}
+		}
+
+		GLint arraySize(const std::string& token, const SmallVector<Define, 0>& defines)
+		{
+			std::string value = token;
+			// Follow definitions like `#define BATCH_SIZE (585)`
+			for (int depth = 0; depth < 8; depth++) {
+				const Define* define = findDefine(defines, value);
+				if (define == nullptr) {
+					break;
+				}
+				value = define->value;
+			}
+			std::size_t start = value.find_first_not_of(" \t(");
+			return (start != std::string::npos ? static_cast<GLint>(std::strtol(value.c_str() + start, nullptr, 10)) : 0);
+		}
+
+		bool basicTypeLayout(const std::string& typeName, TypeLayout& layout)
+		{
+			static const struct {
+				const char* name;
+				TypeLayout layout;
+			} BasicTypes[] = {
+				{ "float", { GL_FLOAT, 4, 4 } }, { "vec2", { GL_FLOAT_VEC2, 8, 8 } }, { "vec3", { GL_FLOAT_VEC3, 12, 16 } }, { "vec4", { GL_FLOAT_VEC4, 16, 16 } },
+				{ "int", { GL_INT, 4, 4 } }, { "ivec2", { GL_INT_VEC2, 8, 8 } }, { "ivec3", { GL_INT_VEC3, 12, 16 } }, { "ivec4", { GL_INT_VEC4, 16, 16 } },
+				{ "uint", { GL_UNSIGNED_INT, 4, 4 } }, { "uvec2", { GL_UNSIGNED_INT_VEC2, 8, 8 } }, { "uvec3", { GL_UNSIGNED_INT_VEC3, 12, 16 } }, { "uvec4", { GL_UNSIGNED_INT_VEC4, 16, 16 } },
+				{ "bool", { GL_BOOL, 4, 4 } }, { "bvec2", { GL_BOOL_VEC2, 8, 8 } }, { "bvec3", { GL_BOOL_VEC3, 12, 16 } }, { "bvec4", { GL_BOOL_VEC4, 16, 16 } },
+				{ "mat2", { GL_FLOAT_MAT2, 32, 16 } }, { "mat3", { GL_FLOAT_MAT3, 48, 16 } }, { "mat4", { GL_FLOAT_MAT4, 64, 16 } },
+				{ "sampler2D", { GL_SAMPLER_2D, 0, 0 } }, { "sampler3D", { GL_SAMPLER_3D, 0, 0 } }, { "samplerCube", { GL_SAMPLER_CUBE, 0, 0 } },
+				{ "isampler2D", { GL_INT_SAMPLER_2D, 0, 0 } }, { "usampler2D", { GL_UNSIGNED_INT_SAMPLER_2D, 0, 0 } }, { "samplerBuffer", { GL_SAMPLER_BUFFER, 0, 0 } }
+			};
+
+			for (const auto& basicType : BasicTypes) {
+				if (typeName == basicType.name) {
+					layout = basicType.layout;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		inline GLint alignTo(GLint value, GLint align)
+		{
+			return (align > 0 ? (value + align - 1) / align * align : value);
+		}
+
+		const StructType* findStruct(const SmallVector<StructType, 0>& structs, const std::string& name)
+		{
+			for (const StructType& structType : structs) {
+				if (structType.name == name) {
+					return &structType;
+				}
+			}
+			return nullptr;
+		}
+
+		/// Computes `std140` layout of a struct, base alignment of a struct is always rounded up to the one of `vec4`
+		void structLayout(const SmallVector<StructType, 0>& structs, const StructType& structType, GLint& size, GLint& align)
+		{
+			GLint offset = 0;
+			align = 16;
+			for (const StructMember& member : structType.members) {
+				GLint memberSize, memberAlign;
+				TypeLayout layout;
+				if (basicTypeLayout(member.typeName, layout)) {
+					memberSize = layout.size;
+					memberAlign = layout.align;
+				} else if (const StructType* nested = findStruct(structs, member.typeName)) {
+					structLayout(structs, *nested, memberSize, memberAlign);
+				} else {
+					memberSize = 0;
+					memberAlign = 4;
+				}
+				if (member.arraySize > 0) {
+					memberAlign = alignTo(memberAlign, 16);
+					memberSize = alignTo(memberSize, memberAlign) * member.arraySize;
+				}
+				offset = alignTo(offset, memberAlign) + memberSize;
+			}
+			size = alignTo(offset, align);
+		}
+
+		/// Parses a member declaration like `vec4 color;`, `Instance[BATCH_SIZE] instances;` or `float values[4];`
+		std::size_t parseMember(const SmallVector<std::string, 0>& tokens, std::size_t i, const SmallVector<Define, 0>& defines, StructMember& member)
+		{
+			static const char* Qualifiers[] = { "highp", "mediump", "lowp", "flat", "smooth", "noperspective", "centroid", "const" };
+
+			bool isQualifier = true;
+			while (i < tokens.size() && isQualifier) {
+				isQualifier = false;
+				for (const char* qualifier : Qualifiers) {
+					if (tokens[i] == qualifier) {
+						isQualifier = true;
+						i++;
+						break;
+					}
+				}
+			}
+
+			member.arraySize = 0;
+			member.typeName = (i < tokens.size() ? tokens[i++] : std::string());
+			if (i + 2 < tokens.size() && tokens[i] == "[") {
+				member.arraySize = arraySize(tokens[i + 1], defines);
+				i += 3;
+			}
+			member.name = (i < tokens.size() ? tokens[i++] : std::string());
+			if (i + 2 < tokens.size() && tokens[i] == "[") {
+				member.arraySize = arraySize(tokens[i + 1], defines);
+				i += 3;
+			}
+			while (i < tokens.size() && tokens[i] != ";") {
+				i++;
+			}
+			return i + 1;
+		}
+
+		void addUniform(NullProgram& program, const std::string& name, GLenum type, GLint size, GLint blockIndex, GLint offset)
+		{
+			for (const NullUniform& uniform : program.uniforms) {
+				if (uniform.name == name && uniform.blockIndex == blockIndex) {
+					return;
+				}
+			}
+
+			GLint location = -1;
+			if (blockIndex == -1) {
+				location = 0;
+				for (const NullUniform& uniform : program.uniforms) {
+					if (uniform.blockIndex == -1) {
+						location++;
+					}
+				}
+			} else {
+				program.uniformBlocks[blockIndex].uniformIndices.push_back(static_cast<GLint>(program.uniforms.size()));
+			}
+			program.uniforms.push_back({ name, type, size, blockIndex, offset, location });
+		}
+
+		/// Adds uniforms of a block member, only the first element of an array of structs is reported
+		void addBlockMember(NullProgram& program, const SmallVector<StructType, 0>& structs, const std::string& prefix,
+							const StructMember& member, GLint blockIndex, GLint& offset)
+		{
+			TypeLayout layout;
+			if (basicTypeLayout(member.typeName, layout)) {
+				GLint align = layout.align;
+				GLint size = layout.size;
+				if (member.arraySize > 0) {
+					align = alignTo(align, 16);
+					size = alignTo(size, align) * member.arraySize;
+				}
+				offset = alignTo(offset, align);
+				addUniform(program, member.arraySize > 0 ? prefix + member.name + "[0]" : prefix + member.name,
+						   layout.type, member.arraySize > 0 ? member.arraySize : 1, blockIndex, offset);
+				offset += size;
+			} else if (const StructType* structType = findStruct(structs, member.typeName)) {
+				GLint size, align;
+				structLayout(structs, *structType, size, align);
+				offset = alignTo(offset, align);
+
+				GLint memberOffset = offset;
+				const std::string memberPrefix = (member.arraySize > 0 ? prefix + member.name + "[0]." : prefix + member.name + ".");
+				for (const StructMember& structMember : structType->members) {
+					addBlockMember(program, structs, memberPrefix, structMember, blockIndex, memberOffset);
+				}
+				offset += (member.arraySize > 0 ? size * member.arraySize : size);
+			}
+		}
+
+		/// Finds uniforms, uniform blocks and vertex attributes in a shader, declarations are expected only at global scope
+		void reflectShader(NullProgram& program, const NullShader& shader)
+		{
+			SmallVector<Define, 0> defines;
+			SmallVector<std::string, 0> tokens;
+			tokenize(preprocess(shader.source, defines), tokens);
+
+			SmallVector<StructType, 0> structs;
+			std::size_t i = 0;
+			while (i < tokens.size()) {
+				GLint location = -1;
+				if (tokens[i] == "layout" && i + 1 < tokens.size() && tokens[i + 1] == "(") {
+					i += 2;
+					while (i < tokens.size() && tokens[i] != ")") {
+						if (tokens[i] == "location" && i + 2 < tokens.size() && tokens[i + 1] == "=") {
+							location = static_cast<GLint>(std::strtol(tokens[i + 2].c_str(), nullptr, 10));
+						}
+						i++;
+					}
+					i++;
+				}
+				if (i >= tokens.size()) {
+					break;
+				}
+
+				if (tokens[i] == "struct" && i + 2 < tokens.size() && tokens[i + 2] == "{") {
+					StructType& structType = structs.emplace_back();
+					structType.name = tokens[i + 1];
+					i += 3;
+					while (i < tokens.size() && tokens[i] != "}") {
+						i = parseMember(tokens, i, defines, structType.members.emplace_back());
+					}
+					while (i < tokens.size() && tokens[i] != ";") {
+						i++;
+					}
+					i++;
+				} else if (tokens[i] == "uniform" && i + 2 < tokens.size() && tokens[i + 2] == "{") {
+					const GLint blockIndex = static_cast<GLint>(program.uniformBlocks.size());
+					NullUniformBlock& block = program.uniformBlocks.emplace_back();
+					block.name = tokens[i + 1];
+					i += 3;
+
+					SmallVector<StructMember, 0> members;
+					while (i < tokens.size() && tokens[i] != "}") {
+						i = parseMember(tokens, i, defines, members.emplace_back());
+					}
+					i++;
+					// Block members are prefixed with the block name if the block has an instance name
+					const std::string prefix = (i < tokens.size() && tokens[i] != ";" ? block.name + "." : std::string());
+					while (i < tokens.size() && tokens[i] != ";") {
+						i++;
+					}
+					i++;
+
+					GLint offset = 0;
+					for (const StructMember& member : members) {
+						addBlockMember(program, structs, prefix, member, blockIndex, offset);
+					}
+					program.uniformBlocks[blockIndex].dataSize = alignTo(offset, 16);
+				} else if (tokens[i] == "uniform") {
+					StructMember member;
+					i = parseMember(tokens, i + 1, defines, member);
+					TypeLayout layout;
+					if (basicTypeLayout(member.typeName, layout)) {
+						addUniform(program, member.name, layout.type, member.arraySize > 0 ? member.arraySize : 1, -1, -1);
+					}
+				} else if ((tokens[i] == "in" || tokens[i] == "attribute") && shader.type == GL_VERTEX_SHADER) {
+					StructMember member;
+					i = parseMember(tokens, i + 1, defines, member);
+					TypeLayout layout;
+					if (basicTypeLayout(member.typeName, layout)) {
+						program.attributes.push_back({ member.name, layout.type, location });
+					}
+				} else {
+					// Skip any other declaration or a whole function definition
+					std::int32_t depth = 0;
+					while (i < tokens.size()) {
+						if (tokens[i] == "{") {
+							depth++;
+						} else if (tokens[i] == "}") {
+							depth--;
+							if (depth == 0) {
+								i++;
+								break;
+							}
+						} else if (tokens[i] == ";" && depth == 0) {
+							i++;
+							break;
+						}
+						i++;
+					}
+				}
+			}
+		}
+
+		void linkProgram(NullProgram& program)
+		{
+			program.uniforms.clear();
+			program.uniformBlocks.clear();
+			program.attributes.clear();
+
+			for (GLuint shaderName : program.shaders) {
+				auto it = shaders.find(shaderName);
+				if (it != shaders.end()) {
+					reflectShader(program, it->second);
+				}
+			}
+
+			// Attributes without an explicit location are assigned to the first free ones
+			GLint nextLocation = 0;
+			for (NullAttribute& attribute : program.attributes) {
+				if (attribute.location >= 0) {
+					continue;
+				}
+				bool isUsed = true;
+				while (isUsed) {
+					isUsed = false;
+					for (const NullAttribute& other : program.attributes) {
+						if (other.location == nextLocation) {
+							isUsed = true;
+							nextLocation++;
+							break;
+						}
+					}
+				}
+				attribute.location = nextLocation++;
+			}
+		}
+
+		NullProgram* findProgram(GLuint program)
+		{
+			auto it = programs.find(program);
+			return (it != programs.end() ? &it->second : nullptr);
+		}
+	}
+
+	NullGLCalls NullGLCalls::retrieve()
+	{
+		NullGLCalls result = calls;
+		calls = NullGLCalls();
+		return result;
+	}
+}
+
+using namespace nCine;
+
+extern "C"
+{
+	void APIENTRY glActiveTexture(GLenum) { recordCall(); }
+	void APIENTRY glAttachShader(GLuint program, GLuint shader)
+	{
+		recordCall();
+		if (NullProgram* p = findProgram(program)) {
+			p->shaders.push_back(shader);
+		}
+	}
+	void APIENTRY glBindBuffer(GLenum target, GLuint buffer)
+	{
+		recordBinding();
+		bindBuffer(target, buffer);
+	}
+	void APIENTRY glBindBufferBase(GLenum target, GLuint, GLuint buffer)
+	{
+		recordBinding();
+		bindBuffer(target, buffer);
+	}
+	void APIENTRY glBindBufferRange(GLenum target, GLuint, GLuint buffer, GLintptr, GLsizeiptr)
+	{
+		recordBinding();
+		bindBuffer(target, buffer);
+	}
+	void APIENTRY glBindFramebuffer(GLenum, GLuint) { recordBinding(); }
+	void APIENTRY glBindRenderbuffer(GLenum, GLuint) { recordBinding(); }
+	void APIENTRY glBindTexture(GLenum, GLuint) { recordBinding(); }
+	void APIENTRY glBindVertexArray(GLuint array)
+	{
+		recordBinding();
+		boundVertexArray = array;
+		auto it = vertexArrayElementBuffers.find(array);
+		boundBuffers[GL_ELEMENT_ARRAY_BUFFER] = (it != vertexArrayElementBuffers.end() ? it->second : 0);
+	}
+	void APIENTRY glBlendFunc(GLenum, GLenum) { recordCall(); }
+	void APIENTRY glBlendFuncSeparate(GLenum, GLenum, GLenum, GLenum) { recordCall(); }
+	void APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum)
+	{
+		recordCall();
+		allocateStorage(target, size, data);
+	}
+	void APIENTRY glBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield)
+	{
+		recordCall();
+		allocateStorage(target, size, data);
+	}
+	void APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+	{
+		recordCall();
+		NullBuffer* buffer = boundBuffer(target);
+		if (buffer != nullptr && data != nullptr && offset + size <= buffer->size) {
+			std::memcpy(buffer->data.get() + offset, data, size);
+			calls.uploadedBytes += size;
+		}
+	}
+	GLenum APIENTRY glCheckFramebufferStatus(GLenum)
+	{
+		recordCall();
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+	void APIENTRY glClear(GLbitfield) { recordCall(); }
+	void APIENTRY glClearColor(GLclampf, GLclampf, GLclampf, GLclampf) { recordCall(); }
+	void APIENTRY glCompileShader(GLuint) { recordCall(); }
+	void APIENTRY glCompressedTexImage2D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei imageSize, const GLvoid* data)
+	{
+		recordCall();
+		if (data != nullptr) {
+			calls.uploadedBytes += imageSize;
+		}
+	}
+	void APIENTRY glCompressedTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei imageSize, const GLvoid* data)
+	{
+		recordCall();
+		if (data != nullptr) {
+			calls.uploadedBytes += imageSize;
+		}
+	}
+	GLuint APIENTRY glCreateProgram(void)
+	{
+		recordCall();
+		const GLuint name = ++lastName;
+		programs.emplace(name, NullProgram());
+		return name;
+	}
+	GLuint APIENTRY glCreateShader(GLenum type)
+	{
+		recordCall();
+		const GLuint name = ++lastName;
+		shaders[name].type = type;
+		return name;
+	}
+	void APIENTRY glCullFace(GLenum) { recordCall(); }
+	void APIENTRY glDebugMessageCallback(GLDEBUGPROC, const void*) { recordCall(); }
+	void APIENTRY glDebugMessageInsert(GLenum, GLenum, GLuint, GLenum, GLsizei, const GLchar*) { recordCall(); }
+	void APIENTRY glDeleteBuffers(GLsizei n, const GLuint* names)
+	{
+		recordCall();
+		for (GLsizei i = 0; i < n; i++) {
+			buffers.erase(names[i]);
+		}
+	}
+	void APIENTRY glDeleteFramebuffers(GLsizei, const GLuint*) { recordCall(); }
+	void APIENTRY glDeleteProgram(GLuint program)
+	{
+		recordCall();
+		programs.erase(program);
+	}
+	void APIENTRY glDeleteRenderbuffers(GLsizei, const GLuint*) { recordCall(); }
+	void APIENTRY glDeleteShader(GLuint shader)
+	{
+		recordCall();
+		shaders.erase(shader);
+	}
+	void APIENTRY glDeleteTextures(GLsizei, const GLuint*) { recordCall(); }
+	void APIENTRY glDeleteVertexArrays(GLsizei n, const GLuint* names)
+	{
+		recordCall();
+		for (GLsizei i = 0; i < n; i++) {
+			vertexArrayElementBuffers.erase(names[i]);
+		}
+	}
+	void APIENTRY glDepthMask(GLboolean) { recordCall(); }
+	void APIENTRY glDetachShader(GLuint program, GLuint shader)
+	{
+		recordCall();
+		if (NullProgram* p = findProgram(program)) {
+			for (std::size_t i = 0; i < p->shaders.size(); i++) {
+				if (p->shaders[i] == shader) {
+					p->shaders.erase(p->shaders.begin() + i);
+					break;
+				}
+			}
+		}
+	}
+	void APIENTRY glDisable(GLenum) { recordCall(); }
+	void APIENTRY glDrawArrays(GLenum, GLint, GLsizei) { recordDraw(0); }
+	void APIENTRY glDrawArraysInstanced(GLenum, GLint, GLsizei, GLsizei instanceCount) { recordDraw(instanceCount); }
+	void APIENTRY glDrawBuffers(GLsizei, const GLenum*) { recordCall(); }
+	void APIENTRY glDrawElements(GLenum, GLsizei, GLenum, const GLvoid*) { recordDraw(0); }
+	void APIENTRY glDrawElementsBaseVertex(GLenum, GLsizei, GLenum, const void*, GLint) { recordDraw(0); }
+	void APIENTRY glDrawElementsInstanced(GLenum, GLsizei, GLenum, const void*, GLsizei instanceCount) { recordDraw(instanceCount); }
+	void APIENTRY glDrawElementsInstancedBaseVertex(GLenum, GLsizei, GLenum, const void*, GLsizei instanceCount, GLint) { recordDraw(instanceCount); }
+	void APIENTRY glEnable(GLenum) { recordCall(); }
+	void APIENTRY glEnableVertexAttribArray(GLuint) { recordCall(); }
+	void APIENTRY glFlushMappedBufferRange(GLenum, GLintptr, GLsizeiptr length)
+	{
+		recordCall();
+		calls.uploadedBytes += length;
+	}
+	void APIENTRY glFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) { recordCall(); }
+	void APIENTRY glFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { recordCall(); }
+	void APIENTRY glGenBuffers(GLsizei n, GLuint* names)
+	{
+		recordCall();
+		generateNames(n, names);
+		for (GLsizei i = 0; i < n; i++) {
+			buffers.emplace(names[i], NullBuffer());
+		}
+	}
+	void APIENTRY glGenFramebuffers(GLsizei n, GLuint* names)
+	{
+		recordCall();
+		generateNames(n, names);
+	}
+	void APIENTRY glGenRenderbuffers(GLsizei n, GLuint* names)
+	{
+		recordCall();
+		generateNames(n, names);
+	}
+	void APIENTRY glGenTextures(GLsizei n, GLuint* names)
+	{
+		recordCall();
+		generateNames(n, names);
+	}
+	void APIENTRY glGenVertexArrays(GLsizei n, GLuint* names)
+	{
+		recordCall();
+		generateNames(n, names);
+	}
+	void APIENTRY glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		if (p != nullptr && index < p->attributes.size()) {
+			const NullAttribute& attribute = p->attributes[index];
+			copyName(attribute.name, bufSize, length, name);
+			*size = 1;
+			*type = attribute.type;
+		}
+	}
+	void APIENTRY glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		if (p != nullptr && index < p->uniforms.size()) {
+			const NullUniform& uniform = p->uniforms[index];
+			copyName(uniform.name, bufSize, length, name);
+			*size = uniform.size;
+			*type = uniform.type;
+		}
+	}
+	void APIENTRY glGetActiveUniformBlockName(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		if (p != nullptr && index < p->uniformBlocks.size()) {
+			copyName(p->uniformBlocks[index].name, bufSize, length, name);
+		}
+	}
+	void APIENTRY glGetActiveUniformBlockiv(GLuint program, GLuint index, GLenum pname, GLint* params)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		if (p == nullptr || index >= p->uniformBlocks.size()) {
+			return;
+		}
+		const NullUniformBlock& block = p->uniformBlocks[index];
+		switch (pname) {
+			case GL_UNIFORM_BLOCK_DATA_SIZE: *params = block.dataSize; break;
+			case GL_UNIFORM_BLOCK_NAME_LENGTH: *params = static_cast<GLint>(block.name.size() + 1); break;
+			case GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS: *params = static_cast<GLint>(block.uniformIndices.size()); break;
+			case GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES:
+				for (std::size_t i = 0; i < block.uniformIndices.size(); i++) {
+					params[i] = block.uniformIndices[i];
+				}
+				break;
+			default: *params = 0; break;
+		}
+	}
+	void APIENTRY glGetActiveUniformName(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		if (p != nullptr && index < p->uniforms.size()) {
+			copyName(p->uniforms[index].name, bufSize, length, name);
+		}
+	}
+	void APIENTRY glGetActiveUniformsiv(GLuint program, GLsizei count, const GLuint* indices, GLenum pname, GLint* params)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		for (GLsizei i = 0; i < count; i++) {
+			if (p == nullptr || indices[i] >= p->uniforms.size()) {
+				params[i] = 0;
+				continue;
+			}
+			const NullUniform& uniform = p->uniforms[indices[i]];
+			switch (pname) {
+				case GL_UNIFORM_BLOCK_INDEX: params[i] = uniform.blockIndex; break;
+				case GL_UNIFORM_TYPE: params[i] = static_cast<GLint>(uniform.type); break;
+				case GL_UNIFORM_SIZE: params[i] = uniform.size; break;
+				case GL_UNIFORM_OFFSET: params[i] = uniform.offset; break;
+				case GL_UNIFORM_NAME_LENGTH: params[i] = static_cast<GLint>(uniform.name.size() + 1); break;
+				default: params[i] = 0; break;
+			}
+		}
+	}
+	GLint APIENTRY glGetAttribLocation(GLuint program, const GLchar* name)
+	{
+		recordCall();
+		if (NullProgram* p = findProgram(program)) {
+			for (const NullAttribute& attribute : p->attributes) {
+				if (attribute.name == name) {
+					return attribute.location;
+				}
+			}
+		}
+		return -1;
+	}
+	GLenum APIENTRY glGetError(void)
+	{
+		recordCall();
+		return GL_NO_ERROR;
+	}
+	void APIENTRY glGetIntegerv(GLenum pname, GLint* data)
+	{
+		recordCall();
+		switch (pname) {
+			case GL_MAX_TEXTURE_SIZE: *data = 8192; break;
+			case GL_MAX_TEXTURE_IMAGE_UNITS: *data = 16; break;
+			case GL_MAX_UNIFORM_BLOCK_SIZE: *data = 64 * 1024; break;
+			case GL_MAX_UNIFORM_BUFFER_BINDINGS: *data = 36; break;
+			case GL_MAX_VERTEX_UNIFORM_BLOCKS: *data = 12; break;
+			case GL_MAX_FRAGMENT_UNIFORM_BLOCKS: *data = 12; break;
+			case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+			case GL_MAX_VERTEX_ATTRIB_STRIDE: *data = 2048; break;
+			case GL_MAX_COLOR_ATTACHMENTS: *data = 8; break;
+			case GL_MAX_LABEL_LENGTH: *data = 256; break;
+			default: *data = 0; break;
+		}
+	}
+	void APIENTRY glGetObjectLabel(GLenum, GLuint, GLsizei bufSize, GLsizei* length, GLchar* label)
+	{
+		recordCall();
+		copyName(std::string(), bufSize, length, label);
+	}
+	void APIENTRY glGetProgramBinary(GLuint, GLsizei, GLsizei* length, GLenum*, void*)
+	{
+		recordCall();
+		if (length != nullptr) {
+			*length = 0;
+		}
+	}
+	void APIENTRY glGetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+	{
+		recordCall();
+		copyName(std::string(), bufSize, length, infoLog);
+	}
+	void APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+	{
+		recordCall();
+		NullProgram* p = findProgram(program);
+		switch (pname) {
+			case GL_LINK_STATUS:
+			case GL_VALIDATE_STATUS: *params = GL_TRUE; break;
+			case GL_ACTIVE_UNIFORMS: *params = (p != nullptr ? static_cast<GLint>(p->uniforms.size()) : 0); break;
+			case GL_ACTIVE_UNIFORM_BLOCKS: *params = (p != nullptr ? static_cast<GLint>(p->uniformBlocks.size()) : 0); break;
+			case GL_ACTIVE_ATTRIBUTES: *params = (p != nullptr ? static_cast<GLint>(p->attributes.size()) : 0); break;
+			default: *params = 0; break;
+		}
+	}
+	void APIENTRY glGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+	{
+		recordCall();
+		copyName(std::string(), bufSize, length, infoLog);
+	}
+	void APIENTRY glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+	{
+		recordCall();
+		switch (pname) {
+			case GL_COMPILE_STATUS: *params = GL_TRUE; break;
+			case GL_SHADER_TYPE: {
+				auto it = shaders.find(shader);
+				*params = (it != shaders.end() ? static_cast<GLint>(it->second.type) : 0);
+				break;
+			}
+			default: *params = 0; break;
+		}
+	}
+	const GLubyte* APIENTRY glGetString(GLenum name)
+	{
+		recordCall();
+		switch (name) {
+			case GL_VENDOR: return reinterpret_cast<const GLubyte*>("nCine");
+			case GL_RENDERER: return reinterpret_cast<const GLubyte*>("Null");
+			case GL_VERSION: return reinterpret_cast<const GLubyte*>("3.3.0 Null");
+			case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("3.30 Null");
+			default: return reinterpret_cast<const GLubyte*>("");
+		}
+	}
+	const GLubyte* APIENTRY glGetStringi(GLenum, GLuint)
+	{
+		recordCall();
+		return reinterpret_cast<const GLubyte*>("");
+	}
+	void APIENTRY glGetTexImage(GLenum, GLint, GLenum, GLenum, GLvoid*) { recordCall(); }
+	GLint APIENTRY glGetUniformLocation(GLuint program, const GLchar* name)
+	{
+		recordCall();
+		if (NullProgram* p = findProgram(program)) {
+			for (const NullUniform& uniform : p->uniforms) {
+				if (uniform.blockIndex == -1 && uniform.name == name) {
+					return uniform.location;
+				}
+			}
+		}
+		return -1;
+	}
+	void APIENTRY glInvalidateFramebuffer(GLenum, GLsizei, const GLenum*) { recordCall(); }
+	void APIENTRY glLinkProgram(GLuint program)
+	{
+		recordCall();
+		if (NullProgram* p = findProgram(program)) {
+			linkProgram(*p);
+		}
+	}
+	void* APIENTRY glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+	{
+		recordCall();
+		NullBuffer* buffer = boundBuffer(target);
+		if (buffer == nullptr || buffer->data == nullptr || offset + length > buffer->size) {
+			return nullptr;
+		}
+		buffer->mapOffset = offset;
+		buffer->mapLength = length;
+		buffer->mapAccess = access;
+		return buffer->data.get() + offset;
+	}
+	void APIENTRY glObjectLabel(GLenum, GLuint, GLsizei, const GLchar*) { recordCall(); }
+	void APIENTRY glPopDebugGroup(void) { recordCall(); }
+	void APIENTRY glProgramBinary(GLuint, GLenum, const void*, GLsizei) { recordCall(); }
+	void APIENTRY glProgramParameteri(GLuint, GLenum, GLint) { recordCall(); }
+	void APIENTRY glPushDebugGroup(GLenum, GLuint, GLsizei, const GLchar*) { recordCall(); }
+	void APIENTRY glRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) { recordCall(); }
+	void APIENTRY glScissor(GLint, GLint, GLsizei, GLsizei) { recordCall(); }
+	void APIENTRY glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+	{
+		recordCall();
+		auto it = shaders.find(shader);
+		if (it == shaders.end()) {
+			return;
+		}
+		std::string& source = it->second.source;
+		source.clear();
+		for (GLsizei i = 0; i < count; i++) {
+			if (string[i] == nullptr) {
+				continue;
+			}
+			if (length != nullptr && length[i] >= 0) {
+				source.append(string[i], length[i]);
+			} else {
+				source.append(string[i]);
+			}
+		}
+	}
+	void APIENTRY glTexBuffer(GLenum, GLenum, GLuint) { recordCall(); }
+	void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum format, GLenum type, const GLvoid* pixels)
+	{
+		recordCall();
+		if (pixels != nullptr) {
+			calls.uploadedBytes += static_cast<unsigned long>(width) * height * pixelSize(format, type);
+		}
+	}
+	void APIENTRY glTexParameterf(GLenum, GLenum, GLfloat) { recordCall(); }
+	void APIENTRY glTexParameteri(GLenum, GLenum, GLint) { recordCall(); }
+	void APIENTRY glTexStorage2D(GLenum, GLsizei, GLenum, GLsizei, GLsizei) { recordCall(); }
+	void APIENTRY glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+	{
+		recordCall();
+		if (pixels != nullptr) {
+			calls.uploadedBytes += static_cast<unsigned long>(width) * height * pixelSize(format, type);
+		}
+	}
+	void APIENTRY glUniform1fv(GLint, GLsizei, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniform1iv(GLint, GLsizei, const GLint*) { recordUniform(); }
+	void APIENTRY glUniform2fv(GLint, GLsizei, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniform2iv(GLint, GLsizei, const GLint*) { recordUniform(); }
+	void APIENTRY glUniform3fv(GLint, GLsizei, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniform3iv(GLint, GLsizei, const GLint*) { recordUniform(); }
+	void APIENTRY glUniform4fv(GLint, GLsizei, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniform4iv(GLint, GLsizei, const GLint*) { recordUniform(); }
+	void APIENTRY glUniformBlockBinding(GLuint, GLuint, GLuint) { recordCall(); }
+	void APIENTRY glUniformMatrix2fv(GLint, GLsizei, GLboolean, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat*) { recordUniform(); }
+	void APIENTRY glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) { recordUniform(); }
+	GLboolean APIENTRY glUnmapBuffer(GLenum target)
+	{
+		recordCall();
+		NullBuffer* buffer = boundBuffer(target);
+		if (buffer != nullptr) {
+			// Without explicit flushing the whole mapped range is considered as written
+			if ((buffer->mapAccess & GL_MAP_WRITE_BIT) != 0 && (buffer->mapAccess & GL_MAP_FLUSH_EXPLICIT_BIT) == 0) {
+				calls.uploadedBytes += buffer->mapLength;
+			}
+			buffer->mapLength = 0;
+			buffer->mapAccess = 0;
+		}
+		return GL_TRUE;
+	}
+	void APIENTRY glUseProgram(GLuint) { recordBinding(); }
+	void APIENTRY glValidateProgram(GLuint) { recordCall(); }
+	void APIENTRY glVertexAttribDivisor(GLuint, GLuint) { recordCall(); }
+	void APIENTRY glVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) { recordCall(); }
+	void APIENTRY glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { recordCall(); }
+	void APIENTRY glViewport(GLint, GLint, GLsizei, GLsizei) { recordCall(); }
+}
+
+#endif
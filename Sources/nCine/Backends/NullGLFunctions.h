@@ -0,0 +1,32 @@
+#pragma once
+
+#if defined(DEDICATED_SERVER) || defined(WITH_NULL_GFX)
+
+namespace nCine
+{
+	/// Counters of OpenGL calls accepted by the null OpenGL functions
+	class NullGLCalls
+	{
+	public:
+		/// Number of all calls
+		unsigned int total;
+		/// Number of draw calls
+		unsigned int draws;
+		/// Number of instances submitted by instanced draw calls
+		unsigned int instances;
+		/// Number of object bindings (programs, buffers, textures, vertex arrays and framebuffers)
+		unsigned int bindings;
+		/// Number of uniform value updates
+		unsigned int uniforms;
+		/// Number of bytes uploaded to buffers and textures
+		unsigned long uploadedBytes;
+
+		NullGLCalls()
+			: total(0), draws(0), instances(0), bindings(0), uniforms(0), uploadedBytes(0) {}
+
+		/// Returns calls recorded since the last retrieval and starts counting again
+		static NullGLCalls retrieve();
+	};
+}
+
+#endif
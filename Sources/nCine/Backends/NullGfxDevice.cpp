@@ -0,0 +1,74 @@
+#if defined(WITH_NULL_GFX)
+
+#include "NullGfxDevice.h"
+#include "../Application.h"
+
+namespace nCine
+{
+	NullGfxDevice::NullGfxDevice(const WindowMode& windowMode, const GLContextInfo& glContextInfo, const DisplayMode& displayMode)
+		: IGfxDevice(windowMode, glContextInfo, displayMode)
+	{
+		if (width_ <= 0 || height_ <= 0) {
+			width_ = 1280;
+			height_ = 720;
+		}
+		drawableWidth_ = width_;
+		drawableHeight_ = height_;
+
+		updateMonitors();
+		initGLViewport();
+	}
+
+	void NullGfxDevice::setResolution(bool fullscreen, int width, int height)
+	{
+		isFullscreen_ = fullscreen;
+		if (width > 0 && height > 0) {
+			setResolutionInternal(width, height);
+		}
+	}
+
+	void NullGfxDevice::update()
+	{
+		// Nothing is presented, so the end of a frame is only used to collect recorded calls
+		lastFrameCalls_ = NullGLCalls::retrieve();
+	}
+
+	void NullGfxDevice::setWindowSize(int width, int height)
+	{
+		if (width == 0 || height == 0 || (width == width_ && height == height_)) {
+			return;
+		}
+		setResolutionInternal(width, height);
+	}
+
+	const IGfxDevice::VideoMode& NullGfxDevice::currentVideoMode(unsigned int monitorIndex) const
+	{
+		currentVideoMode_ = monitors_[0].videoModes[0];
+		return currentVideoMode_;
+	}
+
+	void NullGfxDevice::setResolutionInternal(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+		drawableWidth_ = width;
+		drawableHeight_ = height;
+		theApplication().resizeScreenViewport(drawableWidth_, drawableHeight_);
+	}
+
+	void NullGfxDevice::updateMonitors()
+	{
+		// A single virtual monitor that supports only the initial resolution
+		numMonitors_ = 1;
+		monitors_[0].name = "Null";
+		monitors_[0].position = Vector2i(0, 0);
+		monitors_[0].scale = Vector2f(1.0f, 1.0f);
+		monitors_[0].numVideoModes = 1;
+		monitors_[0].videoModes[0] = currentVideoMode_;
+		monitors_[0].videoModes[0].width = width_;
+		monitors_[0].videoModes[0].height = height_;
+		monitors_[0].videoModes[0].refreshRate = 60.0f;
+	}
+}
+
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#if defined(WITH_NULL_GFX)
+
+#include "../Graphics/IGfxDevice.h"
+#include "../Graphics/DisplayMode.h"
+#include "NullGLFunctions.h"
+
+namespace nCine
+{
+	/// The graphics device without any window that accepts all OpenGL calls without rendering anything
+	/*! It's used to measure CPU cost of the rendering pipeline on machines without GPU. */
+	class NullGfxDevice : public IGfxDevice
+	{
+	public:
+		NullGfxDevice(const WindowMode& windowMode, const GLContextInfo& glContextInfo, const DisplayMode& displayMode);
+
+		inline void setSwapInterval(int interval) override { }
+
+		void setResolution(bool fullscreen, int width = 0, int height = 0) override;
+
+		void update() override;
+
+		inline void setWindowPosition(int x, int y) override { }
+		void setWindowSize(int width, int height) override;
+
+		inline void setWindowTitle(const StringView& windowTitle) override { }
+		inline void setWindowIcon(const StringView& windowIconFilename) override { }
+
+		const VideoMode& currentVideoMode(unsigned int monitorIndex) const override;
+
+		/// Returns OpenGL calls recorded during the last frame
+		inline const NullGLCalls& lastFrameCalls() const {
+			return lastFrameCalls_;
+		}
+
+	protected:
+		void setResolutionInternal(int width, int height) override;
+
+		void updateMonitors() override;
+
+	private:
+		NullGLCalls lastFrameCalls_;
+
+		/// Deleted copy constructor
+		NullGfxDevice(const NullGfxDevice&) = delete;
+		/// Deleted assignment operator
+		NullGfxDevice& operator=(const NullGfxDevice&) = delete;
+	};
+}
+
+#endif
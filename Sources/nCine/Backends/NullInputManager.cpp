@@ -0,0 +1,15 @@
+#if defined(WITH_NULL_GFX)
+
+#include "NullInputManager.h"
+
+namespace nCine
+{
+	const int IInputManager::MaxNumJoysticks = 0;
+
+	const JoystickGuid NullInputManager::joyGuid(int joyId) const
+	{
+		return JoystickGuid();
+	}
+}
+
+#endif
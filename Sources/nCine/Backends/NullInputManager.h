@@ -0,0 +1,105 @@
+#pragma once
+
+#if defined(WITH_NULL_GFX)
+
+#include "../Input/IInputManager.h"
+
+namespace nCine
+{
+	/// Mouse state of the null input manager, no button is ever pressed
+	class NullMouseState : public MouseState
+	{
+	public:
+		inline bool isLeftButtonDown() const override {
+			return false;
+		}
+		inline bool isMiddleButtonDown() const override {
+			return false;
+		}
+		inline bool isRightButtonDown() const override {
+			return false;
+		}
+		inline bool isFourthButtonDown() const override {
+			return false;
+		}
+		inline bool isFifthButtonDown() const override {
+			return false;
+		}
+	};
+
+	/// Keyboard state of the null input manager, no key is ever pressed
+	class NullKeyboardState : public KeyboardState
+	{
+	public:
+		inline bool isKeyDown(KeySym key) const override {
+			return false;
+		}
+	};
+
+	/// Joystick state of the null input manager
+	class NullJoystickState : public JoystickState
+	{
+	public:
+		inline bool isButtonPressed(int buttonId) const override {
+			return false;
+		}
+		inline unsigned char hatState(int hatId) const override {
+			return HatState::Centered;
+		}
+		inline float axisValue(int axisId) const override {
+			return 0.0f;
+		}
+	};
+
+	/// The input manager of the null graphics device, it never reports any input and any joystick
+	class NullInputManager : public IInputManager
+	{
+	public:
+		NullInputManager() {}
+
+		inline const MouseState& mouseState() const override {
+			return mouseState_;
+		}
+		inline const KeyboardState& keyboardState() const override {
+			return keyboardState_;
+		}
+
+		inline bool isJoyPresent(int joyId) const override {
+			return false;
+		}
+		inline const char* joyName(int joyId) const override {
+			return nullptr;
+		}
+		const JoystickGuid joyGuid(int joyId) const override;
+		inline int joyNumButtons(int joyId) const override {
+			return -1;
+		}
+		inline int joyNumHats(int joyId) const override {
+			return -1;
+		}
+		inline int joyNumAxes(int joyId) const override {
+			return -1;
+		}
+		inline const JoystickState& joystickState(int joyId) const override {
+			return nullJoystickState_;
+		}
+		inline bool joystickRumble(int joyId, float lowFrequency, float highFrequency, uint32_t durationMs) override {
+			return false;
+		}
+		inline bool joystickRumbleTriggers(int joyId, float left, float right, uint32_t durationMs) override {
+			return false;
+		}
+
+	private:
+		NullMouseState mouseState_;
+		NullKeyboardState keyboardState_;
+		NullJoystickState nullJoystickState_;
+
+		/// Deleted copy constructor
+		NullInputManager(const NullInputManager&) = delete;
+		/// Deleted assignment operator
+		NullInputManager& operator=(const NullInputManager&) = delete;
+	};
+}
+
+#endif
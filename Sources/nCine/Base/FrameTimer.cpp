@@ -56,6 +56,16 @@ namespace nCine
 		}
 	}
 
+	void FrameTimer::addFrame(float fixedTimeMult)
+	{
+		addFrame();
+
+		// Every frame is simulated with the same time step, regardless of how long it really took
+		timeMults_[0] = fixedTimeMult;
+		timeMults_[1] = fixedTimeMult;
+		timeMults_[2] = fixedTimeMult;
+	}
+
 	void FrameTimer::suspend()
 	{
 		suspensionStart_ = TimeStamp::now();
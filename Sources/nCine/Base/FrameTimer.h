@@ -16,6 +16,8 @@ namespace nCine
 
 		/// Adds a frame to the counter and calculates the interval since the previous one
 		void addFrame();
+		/// Adds a frame to the counter, but uses the specified factor instead of the measured interval
+		void addFrame(float fixedTimeMult);
 
 		/// Starts counting the suspension time
 		void suspend();
@@ -60,31 +60,46 @@ namespace nCine
 			return *m_handle.promise().m_value;
 		}
 
-		// Manualy wait for finish
+		// Manualy wait for finish, finished inner tasks resume their outer tasks automatically
 		bool one_step()
 		{
+			if (!m_handle) {
+				return false;
+			}
+
 			auto curr = m_handle;
-			while (curr) {
-				if (!curr.promise().m_inner_handler) {
-					while (!curr.done()) {
-						curr.resume();
-						if (!curr.done()) {
-							return true;
-						}
-						if (curr.promise().m_outer_handler) {
-							curr = curr.promise().m_outer_handler;
-							curr.promise().m_inner_handler = nullptr;
-						} else {
-							return false;
-						}
-					}
-					break;
-				}
+			while (curr.promise().m_inner_handler) {
 				curr = curr.promise().m_inner_handler;
 			}
-			return !curr.done();
+			if (!curr.done()) {
+				curr.resume();
+			}
+			return !m_handle.done();
 		}
 
+		struct final_awaiter
+		{
+			bool await_ready() noexcept
+			{
+				return false;
+			}
+
+			std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+			{
+				// Continue with the outer task if it's waiting for this one
+				auto outer = handle.promise().m_outer_handler;
+				if (outer) {
+					outer.promise().m_inner_handler = nullptr;
+					return outer;
+				}
+				return std::noop_coroutine();
+			}
+
+			void await_resume() noexcept
+			{
+			}
+		};
+
 		struct task_promise
 		{
 			std::optional<T> m_value { };
@@ -103,7 +118,7 @@ namespace nCine
 
 			auto final_suspend() noexcept
 			{
-				return std::suspend_always { };
+				return final_awaiter { };
 			}
 
 			void return_value(T t)
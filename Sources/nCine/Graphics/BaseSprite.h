@@ -6,7 +6,6 @@
 namespace nCine
 {
 	class Texture;
-	class GLUniformBlockCache;
 
 	/// The base class for sprites
 	/*! \note Users cannot create instances of this class */
@@ -65,8 +64,6 @@ namespace nCine
 		/// A flag indicating if the sprite texture is vertically flipped
 		bool flippedY_;
 
-		GLUniformBlockCache* instanceBlock_;
-
 		/// Protected constructor accessible only by derived sprite classes
 		BaseSprite(SceneNode* parent, Texture* texture, float xx, float yy);
 		/// Protected constructor accessible only by derived sprite classes
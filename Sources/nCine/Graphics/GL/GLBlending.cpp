@@ -1,4 +1,5 @@
 #include "GLBlending.h"
+#include "../RenderStatistics.h"
 
 namespace nCine
 {
@@ -9,6 +10,9 @@ namespace nCine
 		if (state_.enabled == false) {
 			glEnable(GL_BLEND);
 			state_.enabled = true;
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addBlendingChange();
+#endif
 		}
 	}
 
@@ -17,6 +21,9 @@ namespace nCine
 		if (state_.enabled == true) {
 			glDisable(GL_BLEND);
 			state_.enabled = false;
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addBlendingChange();
+#endif
 		}
 	}
 
@@ -25,6 +32,9 @@ namespace nCine
 		if (sfactor != state_.srcRgb || dfactor != state_.dstRgb ||
 			sfactor != state_.srcAlpha || dfactor != state_.dstAlpha) {
 			glBlendFunc(sfactor, dfactor);
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addBlendingChange();
+#endif
 			state_.srcRgb = sfactor;
 			state_.dstRgb = dfactor;
 			state_.srcAlpha = sfactor;
@@ -37,6 +47,9 @@ namespace nCine
 		if (srcRgb != state_.srcRgb || dstRgb != state_.dstRgb ||
 			srcAlpha != state_.srcAlpha || dstAlpha != state_.dstAlpha) {
 			glBlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addBlendingChange();
+#endif
 			state_.srcRgb = srcRgb;
 			state_.dstRgb = dstRgb;
 			state_.srcAlpha = srcAlpha;
@@ -1,5 +1,6 @@
 #include "GLBufferObject.h"
 #include "GLDebug.h"
+#include "../RenderStatistics.h"
 #include "../../../Common.h"
 #include "../../tracy_opengl.h"
 
@@ -57,6 +58,11 @@ namespace nCine
 		glBufferData(target_, size, data, usage);
 		GL_LOG_ERRORS();
 		size_ = size;
+#if defined(NCINE_PROFILING)
+		if (data != nullptr) {
+			RenderStatistics::addUploadedBytes(static_cast<unsigned long>(size));
+		}
+#endif
 	}
 
 	void GLBufferObject::bufferSubData(GLintptr offset, GLsizeiptr size, const GLvoid* data)
@@ -65,6 +71,9 @@ namespace nCine
 		bind();
 		glBufferSubData(target_, offset, size, data);
 		GL_LOG_ERRORS();
+#if defined(NCINE_PROFILING)
+		RenderStatistics::addUploadedBytes(static_cast<unsigned long>(size));
+#endif
 	}
 
 #if !defined(WITH_OPENGLES) && !(defined(DEATH_TARGET_APPLE) && defined(DEATH_TARGET_ARM))
@@ -130,6 +139,9 @@ namespace nCine
 		bind();
 		glFlushMappedBufferRange(target_, offset, length);
 		GL_LOG_ERRORS();
+#if defined(NCINE_PROFILING)
+		RenderStatistics::addUploadedBytes(static_cast<unsigned long>(length));
+#endif
 	}
 
 	GLboolean GLBufferObject::unmap()
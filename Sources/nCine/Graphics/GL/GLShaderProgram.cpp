@@ -3,6 +3,7 @@
 #include "GLDebug.h"
 #include "../BinaryShaderCache.h"
 #include "../RenderResources.h"
+#include "../RenderStatistics.h"
 #include "../RenderVaoPool.h"
 #include "../IGfxCapabilities.h"
 #include "../../ServiceLocator.h"
@@ -144,6 +145,9 @@ namespace nCine
 
 			glUseProgram(glHandle_);
 			boundProgram_ = glHandle_;
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addProgramChange();
+#endif
 		}
 	}
 
@@ -230,6 +234,7 @@ namespace nCine
 
 			RenderResources::removeCameraUniformData(this);
 			RenderResources::unregisterBatchedShader(this);
+			RenderResources::unregisterInstancedShader(this);
 
 			glHandle_ = glCreateProgram();
 		}
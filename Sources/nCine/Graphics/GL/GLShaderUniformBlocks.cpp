@@ -1,6 +1,7 @@
 #include "GLShaderUniformBlocks.h"
 #include "GLShaderProgram.h"
 #include "../RenderResources.h"
+#include "../RenderStatistics.h"
 #include "../../ServiceLocator.h"
 #include "../../../Common.h"
 
@@ -114,6 +115,9 @@ namespace nCine
 						} else {
 							std::memcpy(uboParams_.mapBase + uboParams_.offset, dataPointer_, totalUsedSize);
 						}
+#if defined(NCINE_PROFILING)
+						RenderStatistics::addUniformUpdate(static_cast<unsigned long>(totalUsedSize));
+#endif
 					}
 				}
 			}
@@ -1,5 +1,6 @@
 #include "GLTexture.h"
 #include "GLDebug.h"
+#include "../RenderStatistics.h"
 #include "../../tracy_opengl.h"
 
 namespace nCine
@@ -130,6 +131,9 @@ namespace nCine
 			glBindTexture(target, glHandle);
 			GL_LOG_ERRORS();
 			boundTextures_[textureUnit][target] = glHandle;
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addTextureChange();
+#endif
 			return true;
 		}
 		return false;
@@ -1,5 +1,6 @@
 #include "GLUniformCache.h"
 #include "GLUniform.h"
+#include "../RenderStatistics.h"
 #include "../../../Common.h"
 
 #include <cstring> // for memcpy()
@@ -264,6 +265,9 @@ namespace nCine
 		}
 
 		isDirty_ = false;
+#if defined(NCINE_PROFILING)
+		RenderStatistics::addUniformUpdate(uniform_->memorySize());
+#endif
 		return true;
 	}
 
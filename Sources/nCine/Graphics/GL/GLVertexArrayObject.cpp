@@ -1,5 +1,6 @@
 #include "GLVertexArrayObject.h"
 #include "GLDebug.h"
+#include "../RenderStatistics.h"
 
 namespace nCine
 {
@@ -28,6 +29,9 @@ namespace nCine
 			glBindVertexArray(glHandle_);
 			GL_LOG_ERRORS();
 			boundVAO_ = glHandle_;
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addVaoChange();
+#endif
 			return true;
 		}
 		return false;
@@ -7,7 +7,7 @@
 namespace nCine
 {
 	GLVertexFormat::Attribute::Attribute()
-		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0)
+		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0), divisor_(0)
 	{
 	}
 
@@ -27,7 +27,8 @@ namespace nCine
 					other.normalized_ == normalized_ &&
 					other.stride_ == stride_ &&
 					other.pointer_ == pointer_ &&
-					other.baseOffset_ == baseOffset_));
+					other.baseOffset_ == baseOffset_ &&
+					other.divisor_ == divisor_));
 	}
 
 	bool GLVertexFormat::Attribute::operator!=(const Attribute& other) const
@@ -46,6 +47,7 @@ namespace nCine
 		stride_ = 0;
 		pointer_ = nullptr;
 		baseOffset_ = 0;
+		divisor_ = 0;
 	}
 
 	void GLVertexFormat::Attribute::setVboParameters(GLsizei stride, const GLvoid* pointer)
@@ -63,19 +65,23 @@ namespace nCine
 		pointer_ = pointer;
 	}
 
-	void GLVertexFormat::define()
+	void GLVertexFormat::define(const GLVertexFormat& previousFormat) const
 	{
 		for (unsigned int i = 0; i < MaxAttributes; i++) {
 			if (attributes_[i].enabled_) {
 				attributes_[i].vbo_->bind();
 				glEnableVertexAttribArray(attributes_[i].index_);
 
+				const GLvoid* pointer = attributes_[i].pointer_;
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(DEATH_TARGET_EMSCRIPTEN)
-				const GLubyte* initialPointer = reinterpret_cast<const GLubyte*>(attributes_[i].pointer_);
-				const GLvoid* pointer = reinterpret_cast<const GLvoid*>(initialPointer + attributes_[i].baseOffset_);
+				const bool applyBaseOffset = true;
 #else
-				const GLvoid* pointer = attributes_[i].pointer_;
+				// The first vertex of a draw call doesn't apply to per-instance attributes, so they are always offset explicitly
+				const bool applyBaseOffset = (attributes_[i].divisor_ > 0);
 #endif
+				if (applyBaseOffset) {
+					pointer = reinterpret_cast<const GLvoid*>(reinterpret_cast<const GLubyte*>(pointer) + attributes_[i].baseOffset_);
+				}
 
 				switch (attributes_[i].type_) {
 					case GL_BYTE:
@@ -94,6 +100,13 @@ namespace nCine
 						glVertexAttribPointer(attributes_[i].index_, attributes_[i].size_, attributes_[i].type_, attributes_[i].normalized_, attributes_[i].stride_, pointer);
 						break;
 				}
+				// Divisors are part of the VAO state, so they are set only if they differ from the previous definition
+				const GLuint previousDivisor = (previousFormat.attributes_[i].enabled_ ? previousFormat.attributes_[i].divisor_ : 0);
+				if (attributes_[i].divisor_ != previousDivisor) {
+					glVertexAttribDivisor(attributes_[i].index_, attributes_[i].divisor_);
+				}
+			} else if (previousFormat.attributes_[i].enabled_ && previousFormat.attributes_[i].divisor_ != 0) {
+				glVertexAttribDivisor(previousFormat.attributes_[i].index_, 0);
 			}
 		}
 
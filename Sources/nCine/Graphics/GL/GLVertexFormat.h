@@ -54,6 +54,9 @@ namespace nCine
 			inline unsigned int baseOffset() const {
 				return baseOffset_;
 			}
+			inline GLuint divisor() const {
+				return divisor_;
+			}
 
 			void setVboParameters(GLsizei stride, const GLvoid* pointer);
 			inline void setVbo(const GLBufferObject* vbo) {
@@ -72,6 +75,10 @@ namespace nCine
 			inline void setNormalized(bool normalized) {
 				normalized_ = normalized;
 			}
+			/// Sets the number of instances that share the same attribute value, zero for per-vertex attributes
+			inline void setDivisor(GLuint divisor) {
+				divisor_ = divisor;
+			}
 
 		private:
 			bool enabled_;
@@ -82,8 +89,9 @@ namespace nCine
 			GLboolean normalized_;
 			GLsizei stride_;
 			const GLvoid* pointer_;
-			/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
+			/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0 and to offset per-instance attributes
 			unsigned int baseOffset_;
+			GLuint divisor_;
 
 			friend class GLVertexFormat;
 		};
@@ -102,7 +110,8 @@ namespace nCine
 		inline void setIbo(const GLBufferObject* ibo) {
 			ibo_ = ibo;
 		}
-		void define();
+		/// Defines the vertex format in the bound VAO, `previousFormat` is the one the VAO was defined with before
+		void define(const GLVertexFormat& previousFormat) const;
 		void reset();
 
 		inline Attribute& operator[](unsigned int index) {
@@ -50,6 +50,14 @@ namespace nCine
 		inline void setNumElementsPerVertex(unsigned int numElements) {
 			numElementsPerVertex_ = numElements;
 		}
+		/// Returns true if the vertex data contain per-instance attributes and vertices are generated by the shader
+		inline bool hasInstanceData() const {
+			return hasInstanceData_;
+		}
+		/// Sets if the vertex data contain per-instance attributes and vertices are generated by the shader
+		inline void setHasInstanceData(bool hasInstanceData) {
+			hasInstanceData_ = hasInstanceData;
+		}
 		/// Creates a custom VBO that is unique to this `Geometry` object
 		void createCustomVbo(unsigned int numFloats, GLenum usage);
 		/// Retrieves a pointer that can be used to write vertex data from a custom VBO owned by this object
@@ -127,6 +135,7 @@ namespace nCine
 
 		bool hasDirtyVertices_;
 		bool hasDirtyIndices_;
+		bool hasInstanceData_;
 
 		void bind();
 		void draw(GLsizei numInstances);
@@ -1269,6 +1269,7 @@ namespace nCine
 	{
 		const RenderStatistics::VaoPool& vaoPool = RenderStatistics::vaoPool();
 		const RenderStatistics::CommandPool& commandPool = RenderStatistics::commandPool();
+		const RenderStatistics::Pipeline& pipeline = RenderStatistics::pipeline();
 		const RenderStatistics::Textures& textures = RenderStatistics::textures();
 		const RenderStatistics::CustomBuffers& customVbos = RenderStatistics::customVBOs();
 		const RenderStatistics::CustomBuffers& customIbos = RenderStatistics::customIBOs();
@@ -1294,6 +1295,9 @@ namespace nCine
 
 			ImGui::Text("%u/%u VAOs (%u reuses, %u bindings)", vaoPool.size, vaoPool.capacity, vaoPool.reuses, vaoPool.bindings);
 			ImGui::Text("%u/%u RenderCommands in the pool (%u retrievals)", commandPool.usedSize, commandPool.usedSize + commandPool.freeSize, commandPool.retrievals);
+			ImGui::Text("%u batches, %u state changes (%u programs, %u textures, %u VAOs, %u blending)", pipeline.batches, pipeline.stateChanges(),
+				pipeline.programChanges, pipeline.textureChanges, pipeline.vaoChanges, pipeline.blendingChanges);
+			ImGui::Text("%.2f Kb in %u uniform updates, %.2f Kb uploaded", pipeline.uniformBytes / 1024.0f, pipeline.uniformUpdates, pipeline.uploadedBytes / 1024.0f);
 			ImGui::Text("%.2f Kb in %u Texture(s)", textures.dataSize / 1024.0f, textures.count);
 			ImGui::Text("%.2f Kb in %u custom VBO(s)", customVbos.dataSize / 1024.0f, customVbos.count);
 			ImGui::Text("%.2f Kb in %u custom IBO(s)", customIbos.dataSize / 1024.0f, customIbos.count);
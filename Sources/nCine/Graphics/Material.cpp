@@ -16,7 +16,8 @@ namespace nCine
 
 	Material::Material(GLShaderProgram* program, GLTexture* texture)
 		: isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), sortKey_(0), sortKeyProgramHandle_(0),
+			isSortKeyDirty_(true), uniformsHostBufferSize_(0)
 	{
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			textures_[i] = nullptr;
@@ -30,8 +31,11 @@ namespace nCine
 
 	void Material::setBlendingFactors(GLenum srcBlendingFactor, GLenum destBlendingFactor)
 	{
-		srcBlendingFactor_ = srcBlendingFactor;
-		destBlendingFactor_ = destBlendingFactor;
+		if (srcBlendingFactor_ != srcBlendingFactor || destBlendingFactor_ != destBlendingFactor) {
+			srcBlendingFactor_ = srcBlendingFactor;
+			destBlendingFactor_ = destBlendingFactor;
+			isSortKeyDirty_ = true;
+		}
 	}
 
 	bool Material::setShaderProgramType(ShaderProgramType shaderProgramType)
@@ -54,6 +58,7 @@ namespace nCine
 
 		shaderProgramType_ = ShaderProgramType::CUSTOM;
 		shaderProgram_ = program;
+		isSortKeyDirty_ = true;
 		// The camera uniforms are handled separately as they have a different update frequency
 		shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 		shaderUniformBlocks_.setProgram(shaderProgram_);
@@ -116,7 +121,10 @@ namespace nCine
 	{
 		bool result = false;
 		if (unit < GLTexture::MaxTextureUnits) {
-			textures_[unit] = texture;
+			if (textures_[unit] != texture) {
+				textures_[unit] = texture;
+				isSortKeyDirty_ = true;
+			}
 			result = true;
 		}
 		return result;
@@ -183,6 +191,11 @@ namespace nCine
 
 	uint32_t Material::sortKey()
 	{
+		const GLuint programHandle = shaderProgram_->glHandle();
+		if (!isSortKeyDirty_ && sortKeyProgramHandle_ == programHandle) {
+			return sortKey_;
+		}
+
 		constexpr uint32_t Seed = 1697381921;
 		// Align to 64 bits for `fasthash64()` to properly work on Emscripten without alignment faults
 		static SortHashData hashData alignas(8);
@@ -190,10 +203,13 @@ namespace nCine
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			hashData.textures[i] = (textures_[i] != nullptr) ? textures_[i]->glHandle() : 0;
 		}
-		hashData.shaderProgram = shaderProgram_->glHandle();
+		hashData.shaderProgram = programHandle;
 		hashData.srcBlendingFactor = glBlendingFactorToInt(srcBlendingFactor_);
 		hashData.destBlendingFactor = glBlendingFactorToInt(destBlendingFactor_);
 
-		return fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKey_ = fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKeyProgramHandle_ = programHandle;
+		isSortKeyDirty_ = false;
+		return sortKey_;
 	}
 }
@@ -48,6 +48,8 @@ namespace nCine
 			//BATCHED_MESH_SPRITES_GRAY,
 			/// Shader program for a batch of MeshSprite classes with solid colors and no texture
 			BATCHED_MESH_SPRITES_NO_TEXTURE,
+			/// Shader program for instanced Sprite classes with per-instance attributes
+			INSTANCED_SPRITES,
 			/// Shader program for a batch of TextNode classes with color font texture
 			//BATCHED_TEXTNODES_ALPHA,
 			/// Shader program for a batch of TextNode classes with grayscale font texture
@@ -77,6 +79,10 @@ namespace nCine
 		static constexpr char TexCoordsAttributeName[] = "aTexCoords";
 		static constexpr char MeshIndexAttributeName[] = "aMeshIndex";
 		static constexpr char ColorAttributeName[] = "aColor";
+		static constexpr char InstanceTransformAttributeName[] = "aInstanceTransform";
+		static constexpr char InstancePositionAttributeName[] = "aInstancePosition";
+		static constexpr char InstanceColorAttributeName[] = "aInstanceColor";
+		static constexpr char InstanceTexRectAttributeName[] = "aInstanceTexRect";
 
 		/// Default constructor
 		Material();
@@ -163,6 +169,12 @@ namespace nCine
 		GLShaderUniformBlocks shaderUniformBlocks_;
 		const GLTexture* textures_[GLTexture::MaxTextureUnits];
 
+		/// Cached sort key, it's recalculated only if textures, shader program or blending factors change
+		uint32_t sortKey_;
+		/// Shader program handle used to calculate the cached sort key, the handle changes if the program is reloaded
+		GLuint sortKeyProgramHandle_;
+		bool isSortKeyDirty_;
+
 		/// The size of the memory buffer containing uniform values
 		unsigned int uniformsHostBufferSize_;
 		/// Memory buffer with uniform values to be sent to the GPU
@@ -2,6 +2,8 @@
 #include "RenderCommand.h"
 #include "RenderCommandPool.h"
 #include "RenderResources.h"
+#include "RenderStatistics.h"
+#include "Camera.h"
 #include "GL/GLShaderProgram.h"
 #include "../Application.h"
 #include "../ServiceLocator.h"
@@ -56,8 +58,22 @@ namespace nCine
 
 			// Split point if last command or split condition
 			if (i == srcQueue.size() - 1 || shouldSplit) {
+				const GLShaderProgram* instancedShader = RenderResources::instancedShader(prevCommand->material().shaderProgram());
 				const GLShaderProgram* batchedShader = RenderResources::batchedShader(prevCommand->material().shaderProgram());
-				if (batchedShader && (endSplit - lastSplit) >= minBatchSize) {
+				if (instancedShader && (endSplit - lastSplit) >= minBatchSize) {
+					// Instances are limited only by the space in the common VBO, not by the size of an uniform block
+					while (lastSplit < endSplit) {
+						SmallVectorImpl<RenderCommand*>::const_iterator start = srcQueue.begin() + lastSplit;
+						SmallVectorImpl<RenderCommand*>::const_iterator end = srcQueue.begin() + endSplit;
+
+						RenderCommand* instancedCommand = collectInstances(start, end, start);
+						destQueue.push_back(instancedCommand);
+#if defined(NCINE_PROFILING)
+						RenderStatistics::addBatch();
+#endif
+						lastSplit = (unsigned int)(start - srcQueue.begin());
+					}
+				} else if (batchedShader && (endSplit - lastSplit) >= minBatchSize) {
 					// Split point for the maximum batch size
 					while (lastSplit < endSplit) {
 						unsigned int currentMaxBatchSize = maxBatchSize;
@@ -80,6 +96,9 @@ namespace nCine
 						// Handling early splits while collecting (not enough UBO free space)
 						RenderCommand* batchCommand = collectCommands(start, end, start);
 						destQueue.push_back(batchCommand);
+#if defined(NCINE_PROFILING)
+						RenderStatistics::addBatch();
+#endif
 						lastSplit = (unsigned int)(start - srcQueue.begin());
 					}
 				}
@@ -277,6 +296,7 @@ namespace nCine
 		while (it != nextStart) {
 			RenderCommand* command = *it;
 			command->commitNodeTransformation();
+			command->commitInstanceData();
 
 			const GLUniformBlockCache* singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
 			const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
@@ -372,6 +392,91 @@ namespace nCine
 		return batchCommand;
 	}
 
+	RenderCommand* RenderBatcher::collectInstances(
+		SmallVectorImpl<RenderCommand*>::const_iterator start,
+		SmallVectorImpl<RenderCommand*>::const_iterator end,
+		SmallVectorImpl<RenderCommand*>::const_iterator& nextStart)
+	{
+		ASSERT(end > start);
+
+		RenderCommand* refCommand = *start;
+		GLShaderProgram* instancedShader = RenderResources::instancedShader(refCommand->material().shaderProgram());
+		// The following check should never fail as it is already checked by the calling function
+		FATAL_ASSERT_MSG(instancedShader != nullptr, "Unsupported shader for instance");
+		bool commandAdded = false;
+		RenderCommand* instancedCommand = RenderResources::renderCommandPool().retrieveOrAdd(instancedShader, commandAdded);
+		if (commandAdded) {
+			instancedCommand->material().reserveUniformsDataMemory();
+		}
+#if defined(NCINE_PROFILING)
+		instancedCommand->setType(refCommand->type());
+#endif
+
+		// Setting sampler uniforms for GL_TEXTURE* units
+		const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
+		for (const GLUniformCache& uniformCache : allUniforms) {
+			if (uniformCache.uniform()->type() == GL_SAMPLER_2D) {
+				GLUniformCache* instancedUniformCache = instancedCommand->material().uniform(uniformCache.uniform()->name());
+				if (instancedUniformCache == nullptr) {
+					continue;
+				}
+				const int refValue = uniformCache.intValue(0);
+				// Also checking if the command has just been added, as the memory at the
+				// uniforms data pointer is not cleared and might contain the reference value
+				if (instancedUniformCache->intValue(0) != refValue || commandAdded) {
+					instancedUniformCache->setIntValue(refValue);
+				}
+			}
+		}
+
+		// Don't request more bytes than a common VBO can hold
+		constexpr unsigned int NumFloatsInstance = sizeof(RenderResources::VertexFormatInstancedSprite) / sizeof(GLfloat);
+		const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::Array).maxSize;
+		const long maxInstances = (long)(maxVertexDataSize / sizeof(RenderResources::VertexFormatInstancedSprite));
+		nextStart = (end - start > maxInstances ? start + maxInstances : end);
+		const unsigned int numInstances = (unsigned int)(nextStart - start);
+
+		// The depth is computed here directly, the model matrix and instance values are not committed to the instance block
+		const Camera::ProjectionValues cameraValues = RenderResources::currentCamera()->projectionValues();
+
+		// Records are written directly into the mapped common VBO, there is no intermediate copy
+		GLfloat* destData = instancedCommand->geometry().acquireVertexPointer(numInstances * NumFloatsInstance, NumFloatsInstance);
+		auto* destInstance = reinterpret_cast<RenderResources::VertexFormatInstancedSprite*>(destData);
+		for (SmallVectorImpl<RenderCommand*>::const_iterator it = start; it != nextStart; ++it) {
+			const RenderCommand* command = *it;
+			const Matrix4x4f& modelMatrix = command->transformation();
+			const RenderCommand::InstanceData& instanceData = command->instanceData();
+
+			destInstance->transform[0] = modelMatrix[0][0] * instanceData.spriteSize[0];
+			destInstance->transform[1] = modelMatrix[0][1] * instanceData.spriteSize[0];
+			destInstance->transform[2] = modelMatrix[1][0] * instanceData.spriteSize[1];
+			destInstance->transform[3] = modelMatrix[1][1] * instanceData.spriteSize[1];
+			destInstance->position[0] = modelMatrix[3][0];
+			destInstance->position[1] = modelMatrix[3][1];
+			destInstance->position[2] = RenderCommand::calculateDepth(command->layer(), cameraValues.nearClip, cameraValues.farClip);
+			memcpy(destInstance->color, instanceData.color, sizeof(destInstance->color));
+			memcpy(destInstance->texRect, instanceData.texRect, sizeof(destInstance->texRect));
+			destInstance++;
+		}
+		instancedCommand->geometry().releaseVertexPointer();
+
+		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
+			instancedCommand->material().setTexture(i, refCommand->material().texture(i));
+		}
+		instancedCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
+		instancedCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
+		instancedCommand->setBatchSize((int)numInstances);
+		instancedCommand->setLayer(refCommand->layer());
+		instancedCommand->setVisitOrder(refCommand->visitOrder());
+
+		instancedCommand->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+		instancedCommand->geometry().setNumElementsPerVertex(NumFloatsInstance);
+		instancedCommand->geometry().setHasInstanceData(true);
+		instancedCommand->setNumInstances((int)numInstances);
+
+		return instancedCommand;
+	}
+
 	unsigned char* RenderBatcher::acquireMemory(unsigned int bytes)
 	{
 		FATAL_ASSERT(bytes <= UboMaxSize);
@@ -9,7 +9,7 @@
 namespace nCine
 {
 	RenderCommand::RenderCommand(CommandTypes profilingType)
-		: materialSortKey_(0), layer_(0), numInstances_(0), batchSize_(0), transformationCommitted_(false), modelMatrix_(Matrix4x4f::Identity)
+		: materialSortKey_(0), idSortKey_(0), layer_(0), visitOrder_(0), numInstances_(0), batchSize_(0), transformationCommitted_(false), instanceDataCommitted_(true), modelMatrix_(Matrix4x4f::Identity), instanceData_{}
 #if defined(NCINE_PROFILING)
 			, profilingType_(profilingType)
 #endif
@@ -45,9 +45,12 @@ namespace nCine
 		}
 
 		unsigned int offset = 0;
+		if (geometry_.hasInstanceData_) {
+			offset = geometry_.vboParams().offset;
+		}
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(DEATH_TARGET_EMSCRIPTEN)
 		// Simulating missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
-		if (geometry_.numIndices_ > 0) {
+		else if (geometry_.numIndices_ > 0) {
 			offset = geometry_.vboParams().offset + (geometry_.firstVertex_ * geometry_.numElementsPerVertex_ * sizeof(GLfloat));
 		}
 #endif
@@ -69,6 +72,46 @@ namespace nCine
 		transformationCommitted_ = false;
 	}
 
+	void RenderCommand::setInstanceColor(float r, float g, float b, float a)
+	{
+		instanceData_.color[0] = r;
+		instanceData_.color[1] = g;
+		instanceData_.color[2] = b;
+		instanceData_.color[3] = a;
+		instanceDataCommitted_ = false;
+	}
+
+	void RenderCommand::setInstanceColor(const float* color)
+	{
+		setInstanceColor(color[0], color[1], color[2], color[3]);
+	}
+
+	void RenderCommand::setInstanceTexRect(float scaleX, float biasX, float scaleY, float biasY)
+	{
+		instanceData_.texRect[0] = scaleX;
+		instanceData_.texRect[1] = biasX;
+		instanceData_.texRect[2] = scaleY;
+		instanceData_.texRect[3] = biasY;
+		instanceDataCommitted_ = false;
+	}
+
+	void RenderCommand::setInstanceTexRect(const float* texRect)
+	{
+		setInstanceTexRect(texRect[0], texRect[1], texRect[2], texRect[3]);
+	}
+
+	void RenderCommand::setInstanceSpriteSize(float width, float height)
+	{
+		instanceData_.spriteSize[0] = width;
+		instanceData_.spriteSize[1] = height;
+		instanceDataCommitted_ = false;
+	}
+
+	void RenderCommand::setInstanceSpriteSize(const float* size)
+	{
+		setInstanceSpriteSize(size[0], size[1]);
+	}
+
 	void RenderCommand::commitNodeTransformation()
 	{
 		if (transformationCommitted_) {
@@ -94,6 +137,28 @@ namespace nCine
 		transformationCommitted_ = true;
 	}
 
+	void RenderCommand::commitInstanceData()
+	{
+		if (instanceDataCommitted_) {
+			return;
+		}
+
+		GLUniformBlockCache* instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
+		if (instanceBlock != nullptr) {
+			if (GLUniformCache* colorUniform = instanceBlock->uniform(Material::ColorUniformName)) {
+				colorUniform->setFloatVector(instanceData_.color);
+			}
+			if (GLUniformCache* texRectUniform = instanceBlock->uniform(Material::TexRectUniformName)) {
+				texRectUniform->setFloatVector(instanceData_.texRect);
+			}
+			if (GLUniformCache* spriteSizeUniform = instanceBlock->uniform(Material::SpriteSizeUniformName)) {
+				spriteSizeUniform->setFloatVector(instanceData_.spriteSize);
+			}
+		}
+
+		instanceDataCommitted_ = true;
+	}
+
 	void RenderCommand::commitCameraTransformation()
 	{
 		ZoneScopedC(0x81A861);
@@ -122,8 +187,9 @@ namespace nCine
 		geometry_.commitVertices();
 		geometry_.commitIndices();
 
-		// The model matrix should always be updated before committing uniform blocks
+		// The model matrix and instance values should always be updated before committing uniform blocks
 		commitNodeTransformation();
+		commitInstanceData();
 
 		// Commits all the uniform blocks of command's shader program
 		material_.commitUniformBlocks();
@@ -28,6 +28,15 @@ namespace nCine
 			Count
 		};
 
+		/// Per-instance values of a sprite quad
+		/*! Instanced batches read them directly, they are committed to the instance uniform block only if the command is drawn on its own or in an uniform batch. */
+		struct InstanceData
+		{
+			GLfloat color[4];
+			GLfloat texRect[4];
+			GLfloat spriteSize[2];
+		};
+
 		explicit RenderCommand(CommandTypes profilingType);
 		RenderCommand();
 
@@ -112,6 +121,16 @@ namespace nCine
 			return modelMatrix_;
 		}
 		void setTransformation(const Matrix4x4f& modelMatrix);
+
+		inline const InstanceData& instanceData() const {
+			return instanceData_;
+		}
+		void setInstanceColor(float r, float g, float b, float a);
+		void setInstanceColor(const float* color);
+		void setInstanceTexRect(float scaleX, float biasX, float scaleY, float biasY);
+		void setInstanceTexRect(const float* texRect);
+		void setInstanceSpriteSize(float width, float height);
+		void setInstanceSpriteSize(const float* size);
 		inline const Material& material() const {
 			return material_;
 		}
@@ -127,6 +146,8 @@ namespace nCine
 
 		/// Commits the model matrix uniform block
 		void commitNodeTransformation();
+		/// Commits the per-instance values to the instance uniform block
+		void commitInstanceData();
 
 		/// Commits the projection and view matrix uniforms
 		void commitCameraTransformation();
@@ -153,6 +174,7 @@ namespace nCine
 		int batchSize_;
 
 		bool transformationCommitted_;
+		bool instanceDataCommitted_;
 
 #if defined(NCINE_PROFILING)
 		CommandTypes profilingType_;
@@ -160,6 +182,7 @@ namespace nCine
 
 		Recti scissorRect_;
 		Matrix4x4f modelMatrix_;
+		InstanceData instanceData_;
 		Material material_;
 		Geometry geometry_;
 
@@ -10,6 +10,8 @@
 #include "../Base/Algorithms.h"
 #include "../tracy_opengl.h"
 
+#include <cstring>
+
 namespace nCine
 {
 #if defined(DEATH_DEBUG)
@@ -47,6 +49,18 @@ namespace nCine
 
 	namespace
 	{
+		/// Queues shorter than this are sorted with a comparison sort
+		constexpr unsigned int MinRadixSortSize = 128;
+		/// Number of 8-bit digits of the id sort key (least significant) and the material sort key
+		constexpr unsigned int NumRadixDigits = 12;
+
+		inline unsigned int radixDigit(uint64_t materialSortKey, uint32_t idSortKey, unsigned int digit)
+		{
+			return (digit < 4
+				? (idSortKey >> (digit * 8)) & 0xFF
+				: static_cast<unsigned int>(materialSortKey >> ((digit - 4) * 8)) & 0xFF);
+		}
+
 		bool descendingOrder(const RenderCommand* a, const RenderCommand* b)
 		{
 			return (a->materialSortKey() != b->materialSortKey())
@@ -84,9 +98,12 @@ namespace nCine
 	{
 		const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
 
-		// Sorting the queues with the relevant orders
-		sort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
-		sort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+		{
+			ZoneScopedNC("Sorting", 0x81A861);
+			// Sorting the queues with the relevant orders
+			sortQueue(opaqueQueue_, true);
+			sortQueue(transparentQueue_, false);
+		}
 
 		SmallVectorImpl<RenderCommand*>* opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 		SmallVectorImpl<RenderCommand*>* transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
@@ -201,6 +218,78 @@ namespace nCine
 		GLScissorTest::disable();
 	}
 
+	void RenderQueue::sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending)
+	{
+		const unsigned int count = (unsigned int)queue.size();
+		if (count < 2) {
+			return;
+		}
+
+		// Keys are inverted for descending order, so the radix sort is always ascending
+		const uint64_t materialMask = (descending ? UINT64_MAX : 0);
+		const uint32_t idMask = (descending ? UINT32_MAX : 0);
+
+		sortEntries_.resize_for_overwrite(count);
+		bool isSorted = true;
+		for (unsigned int i = 0; i < count; i++) {
+			SortEntry& entry = sortEntries_[i];
+			entry.materialSortKey = queue[i]->materialSortKey() ^ materialMask;
+			entry.idSortKey = queue[i]->idSortKey() ^ idMask;
+			entry.command = queue[i];
+
+			if (i > 0 && isSorted) {
+				const SortEntry& prev = sortEntries_[i - 1];
+				isSorted = (prev.materialSortKey < entry.materialSortKey ||
+					(prev.materialSortKey == entry.materialSortKey && prev.idSortKey <= entry.idSortKey));
+			}
+		}
+
+		// The scenegraph is usually visited in the same order every frame, so the queue is often already sorted
+		if (isSorted) {
+			return;
+		}
+
+		if (count < MinRadixSortSize) {
+			sort(queue.begin(), queue.end(), descending ? descendingOrder : ascendingOrder);
+			return;
+		}
+
+		// All histograms are gathered in a single pass, digits with the same value for all entries are skipped later
+		uint32_t histograms[NumRadixDigits][256];
+		std::memset(histograms, 0, sizeof(histograms));
+		for (const SortEntry& entry : sortEntries_) {
+			for (unsigned int digit = 0; digit < NumRadixDigits; digit++) {
+				histograms[digit][radixDigit(entry.materialSortKey, entry.idSortKey, digit)]++;
+			}
+		}
+
+		sortTempEntries_.resize_for_overwrite(count);
+		SortEntry* src = sortEntries_.data();
+		SortEntry* dst = sortTempEntries_.data();
+		for (unsigned int digit = 0; digit < NumRadixDigits; digit++) {
+			uint32_t* histogram = histograms[digit];
+			if (histogram[radixDigit(src[0].materialSortKey, src[0].idSortKey, digit)] == count) {
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (unsigned int i = 0; i < 256; i++) {
+				const uint32_t bucketSize = histogram[i];
+				histogram[i] = offset;
+				offset += bucketSize;
+			}
+			for (unsigned int i = 0; i < count; i++) {
+				const unsigned int value = radixDigit(src[i].materialSortKey, src[i].idSortKey, digit);
+				dst[histogram[value]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		for (unsigned int i = 0; i < count; i++) {
+			queue[i] = src[i].command;
+		}
+	}
+
 	void RenderQueue::clear()
 	{
 		opaqueQueue_.clear();
@@ -30,6 +30,14 @@ namespace nCine
 		void clear();
 
 	private:
+		/// Render command with its sort keys, used by the radix sort
+		struct SortEntry
+		{
+			uint64_t materialSortKey;
+			uint32_t idSortKey;
+			RenderCommand* command;
+		};
+
 		/// Array of opaque render command pointers
 		SmallVector<RenderCommand*, 0> opaqueQueue_;
 		/// Array of opaque batched render command pointers
@@ -38,6 +46,12 @@ namespace nCine
 		SmallVector<RenderCommand*, 0> transparentQueue_;
 		/// Array of transparent batched render command pointers
 		SmallVector<RenderCommand*, 0> transparentBatchedQueue_;
+		/// Sort entries and the scratch array used by the radix sort, they are kept to avoid allocations every frame
+		SmallVector<SortEntry, 0> sortEntries_;
+		SmallVector<SortEntry, 0> sortTempEntries_;
+
+		/// Sorts the queue by material sort key and then by id sort key
+		void sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending);
 	};
 
 }
@@ -46,6 +46,7 @@ namespace nCine
 
 	std::unique_ptr<GLShaderProgram> RenderResources::defaultShaderPrograms_[DefaultShaderProgramsCount];
 	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::batchedShaders_(32);
+	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::instancedShaders_(32);
 
 	unsigned char RenderResources::cameraUniformsBuffer_[UniformsBufferSize];
 	HashMap<GLShaderProgram*, RenderResources::CameraUniformData> RenderResources::cameraUniformDataMap_(32);
@@ -80,6 +81,27 @@ namespace nCine
 		return (batchedShaders_.erase(shader) > 0);
 	}
 
+	GLShaderProgram* RenderResources::instancedShader(const GLShaderProgram* shader)
+	{
+		auto it = instancedShaders_.find(shader);
+		return (it != instancedShaders_.end() ? it->second : nullptr);
+	}
+
+	bool RenderResources::registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader)
+	{
+		FATAL_ASSERT(shader != nullptr);
+		FATAL_ASSERT(instancedShader != nullptr);
+		FATAL_ASSERT(shader != instancedShader);
+
+		return instancedShaders_.emplace(shader, instancedShader).second;
+	}
+
+	bool RenderResources::unregisterInstancedShader(const GLShaderProgram* shader)
+	{
+		ASSERT(shader != nullptr);
+		return (instancedShaders_.erase(shader) > 0);
+	}
+
 	RenderResources::CameraUniformData* RenderResources::findCameraUniformData(GLShaderProgram* shaderProgram)
 	{
 		auto it = cameraUniformDataMap_.find(shaderProgram);
@@ -107,6 +129,30 @@ namespace nCine
 			return;
 		}
 
+		GLVertexFormat::Attribute* instanceTransformAttribute = shaderProgram.attribute(Material::InstanceTransformAttributeName);
+		if (instanceTransformAttribute != nullptr) {
+			GLVertexFormat::Attribute* instancePositionAttribute = shaderProgram.attribute(Material::InstancePositionAttributeName);
+			GLVertexFormat::Attribute* instanceColorAttribute = shaderProgram.attribute(Material::InstanceColorAttributeName);
+			GLVertexFormat::Attribute* instanceTexRectAttribute = shaderProgram.attribute(Material::InstanceTexRectAttributeName);
+			if (instanceTransformAttribute->stride() == 0) {
+				instanceTransformAttribute->setVboParameters(sizeof(VertexFormatInstancedSprite), reinterpret_cast<void*>(offsetof(VertexFormatInstancedSprite, transform)));
+				instanceTransformAttribute->setDivisor(1);
+			}
+			if (instancePositionAttribute != nullptr && instancePositionAttribute->stride() == 0) {
+				instancePositionAttribute->setVboParameters(sizeof(VertexFormatInstancedSprite), reinterpret_cast<void*>(offsetof(VertexFormatInstancedSprite, position)));
+				instancePositionAttribute->setDivisor(1);
+			}
+			if (instanceColorAttribute != nullptr && instanceColorAttribute->stride() == 0) {
+				instanceColorAttribute->setVboParameters(sizeof(VertexFormatInstancedSprite), reinterpret_cast<void*>(offsetof(VertexFormatInstancedSprite, color)));
+				instanceColorAttribute->setDivisor(1);
+			}
+			if (instanceTexRectAttribute != nullptr && instanceTexRectAttribute->stride() == 0) {
+				instanceTexRectAttribute->setVboParameters(sizeof(VertexFormatInstancedSprite), reinterpret_cast<void*>(offsetof(VertexFormatInstancedSprite, texRect)));
+				instanceTexRectAttribute->setDivisor(1);
+			}
+			return;
+		}
+
 		GLVertexFormat::Attribute* positionAttribute = shaderProgram.attribute(Material::PositionAttributeName);
 		GLVertexFormat::Attribute* texCoordsAttribute = shaderProgram.attribute(Material::TexCoordsAttributeName);
 		GLVertexFormat::Attribute* meshIndexAttribute = shaderProgram.attribute(Material::MeshIndexAttributeName);
@@ -228,6 +274,7 @@ namespace nCine
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES)], ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], ShaderStrings::batched_meshsprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], ShaderStrings::instanced_sprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_alpha_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
 #else
@@ -245,6 +292,7 @@ namespace nCine
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES)], "batched_meshsprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], "batched_meshsprites_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], "batched_meshsprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], "instanced_sprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], "batched_textnodes_vs.glsl", "textnode_alpha_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
 #endif
@@ -394,5 +442,7 @@ namespace nCine
 		batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_ALPHA)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_RED)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)].get());
+
+		instancedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)].get());
 	}
 }
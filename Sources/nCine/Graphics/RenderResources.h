@@ -53,6 +53,17 @@ namespace nCine
 			int drawindex;
 		};
 
+		/// A vertex format structure for per-instance attributes of instanced sprites
+		struct VertexFormatInstancedSprite
+		{
+			/// Columns of the 2D transformation, scaled by the sprite size
+			GLfloat transform[4];
+			/// Translation and depth
+			GLfloat position[3];
+			GLfloat color[4];
+			GLfloat texRect[4];
+		};
+
 		struct CameraUniformData
 		{
 			CameraUniformData()
@@ -86,6 +97,10 @@ namespace nCine
 		static bool registerBatchedShader(const GLShaderProgram* shader, GLShaderProgram* batchedShader);
 		static bool unregisterBatchedShader(const GLShaderProgram* shader);
 
+		static GLShaderProgram* instancedShader(const GLShaderProgram* shader);
+		static bool registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader);
+		static bool unregisterInstancedShader(const GLShaderProgram* shader);
+
 		static inline unsigned char* cameraUniformsBuffer() {
 			return cameraUniformsBuffer_;
 		}
@@ -116,6 +131,7 @@ namespace nCine
 		static constexpr unsigned int DefaultShaderProgramsCount = static_cast<unsigned int>(Material::ShaderProgramType::CUSTOM);
 		static std::unique_ptr<GLShaderProgram> defaultShaderPrograms_[DefaultShaderProgramsCount];
 		static HashMap<const GLShaderProgram*, GLShaderProgram*> batchedShaders_;
+		static HashMap<const GLShaderProgram*, GLShaderProgram*> instancedShaders_;
 
 		static constexpr unsigned int UniformsBufferSize = 128; // two 4x4 float matrices
 		static unsigned char cameraUniformsBuffer_[UniformsBufferSize];
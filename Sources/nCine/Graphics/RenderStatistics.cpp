@@ -15,11 +15,16 @@ namespace nCine
 	unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
 	RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 	RenderStatistics::CommandPool RenderStatistics::commandPool_;
+	RenderStatistics::Pipeline RenderStatistics::pipeline_[2];
 
 	void RenderStatistics::reset()
 	{
 		TracyPlot("Vertices", static_cast<int64_t>(allCommands_.vertices));
 		TracyPlot("Render Commands", static_cast<int64_t>(allCommands_.commands));
+		TracyPlot("Batches", static_cast<int64_t>(pipeline_[index_].batches));
+		TracyPlot("State Changes", static_cast<int64_t>(pipeline_[index_].stateChanges()));
+		TracyPlot("Uniform Bytes", static_cast<int64_t>(pipeline_[index_].uniformBytes));
+		TracyPlot("Uploaded Bytes", static_cast<int64_t>(pipeline_[index_].uploadedBytes));
 
 		for (unsigned int i = 0; i < (unsigned int)RenderCommand::CommandTypes::Count; i++) {
 			typedCommands_[i].reset();
@@ -33,6 +38,7 @@ namespace nCine
 		// Ping pong index for last and current frame
 		index_ = (index_ + 1) % 2;
 		culledNodes_[index_] = 0;
+		pipeline_[index_].reset();
 
 		vaoPool_.reset();
 		commandPool_.reset();
@@ -138,6 +138,44 @@ namespace nCine
 			friend RenderStatistics;
 		};
 
+		/// Per-frame counters of batches, render state changes and data sent to the GPU
+		class Pipeline
+		{
+		public:
+			unsigned int batches;
+			unsigned int programChanges;
+			unsigned int textureChanges;
+			unsigned int vaoChanges;
+			unsigned int blendingChanges;
+			unsigned int uniformUpdates;
+			unsigned long uniformBytes;
+			unsigned long uploadedBytes;
+
+			Pipeline()
+				: batches(0), programChanges(0), textureChanges(0), vaoChanges(0), blendingChanges(0),
+					uniformUpdates(0), uniformBytes(0), uploadedBytes(0) {}
+
+			/// Returns the total number of state changes
+			inline unsigned int stateChanges() const {
+				return programChanges + textureChanges + vaoChanges + blendingChanges;
+			}
+
+		private:
+			void reset()
+			{
+				batches = 0;
+				programChanges = 0;
+				textureChanges = 0;
+				vaoChanges = 0;
+				blendingChanges = 0;
+				uniformUpdates = 0;
+				uniformBytes = 0;
+				uploadedBytes = 0;
+			}
+
+			friend RenderStatistics;
+		};
+
 		/// Returns the aggregated command statistics for all types
 		static inline const Commands& allCommands() {
 			return allCommands_;
@@ -182,6 +220,11 @@ namespace nCine
 			return commandPool_;
 		}
 
+		/// Returns batches, state changes and uploads of the last frame
+		static inline const Pipeline& pipeline() {
+			return pipeline_[(index_ + 1) % 2];
+		}
+
 	private:
 		static Commands allCommands_;
 		static Commands typedCommands_[(int)RenderCommand::CommandTypes::Count];
@@ -193,6 +236,7 @@ namespace nCine
 		static unsigned int culledNodes_[2];
 		static VaoPool vaoPool_;
 		static CommandPool commandPool_;
+		static Pipeline pipeline_[2];
 
 		static void reset();
 		static void gatherStatistics(const RenderCommand& command);
@@ -249,6 +293,29 @@ namespace nCine
 		static inline void addCommandPoolRetrieval() {
 			commandPool_.retrievals++;
 		}
+		static inline void addBatch() {
+			pipeline_[index_].batches++;
+		}
+		static inline void addProgramChange() {
+			pipeline_[index_].programChanges++;
+		}
+		static inline void addTextureChange() {
+			pipeline_[index_].textureChanges++;
+		}
+		static inline void addVaoChange() {
+			pipeline_[index_].vaoChanges++;
+		}
+		static inline void addBlendingChange() {
+			pipeline_[index_].blendingChanges++;
+		}
+		static inline void addUniformUpdate(unsigned long datasize)
+		{
+			pipeline_[index_].uniformUpdates++;
+			pipeline_[index_].uniformBytes += datasize;
+		}
+		static inline void addUploadedBytes(unsigned long datasize) {
+			pipeline_[index_].uploadedBytes += datasize;
+		}
 
 		friend class ScreenViewport;
 		friend class RenderQueue;
@@ -258,6 +325,14 @@ namespace nCine
 		friend class DrawableNode;
 		friend class RenderVaoPool;
 		friend class RenderCommandPool;
+		friend class RenderBatcher;
+		friend class GLShaderProgram;
+		friend class GLShaderUniformBlocks;
+		friend class GLUniformCache;
+		friend class GLTexture;
+		friend class GLVertexArrayObject;
+		friend class GLBlending;
+		friend class GLBufferObject;
 	};
 }
 
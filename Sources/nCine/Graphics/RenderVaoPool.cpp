@@ -90,8 +90,8 @@ namespace nCine
 			// Binding a VAO changes the current bound element array buffer
 			const GLuint oldIboHandle = vaoPool_[index].format.ibo() ? vaoPool_[index].format.ibo()->glHandle() : 0;
 			GLBufferObject::setBoundHandle(GL_ELEMENT_ARRAY_BUFFER, oldIboHandle);
+			vertexFormat.define(vaoPool_[index].format);
 			vaoPool_[index].format = vertexFormat;
-			vaoPool_[index].format.define();
 			vaoPool_[index].lastBindTime = TimeStamp::now();
 #if defined(NCINE_PROFILING)
 			RenderStatistics::addVaoPoolBinding();
@@ -147,6 +147,7 @@ namespace nCine
 	Shader::~Shader()
 	{
 		RenderResources::unregisterBatchedShader(glShaderProgram_.get());
+		RenderResources::unregisterInstancedShader(glShaderProgram_.get());
 	}
 
 	bool Shader::loadFromMemory(const char* shaderName, Introspection introspection, const char* vertex, const char* fragment, int batchSize)
@@ -417,6 +418,11 @@ namespace nCine
 		RenderResources::registerBatchedShader(glShaderProgram_.get(), batchedShader.glShaderProgram_.get());
 	}
 
+	void Shader::registerInstancedShader(Shader& instancedShader)
+	{
+		RenderResources::registerInstancedShader(glShaderProgram_.get(), instancedShader.glShaderProgram_.get());
+	}
+
 	bool Shader::loadDefaultShader(DefaultVertex vertex, int batchSize)
 	{
 #if !defined(WITH_EMBEDDED_SHADERS)
@@ -449,6 +455,9 @@ namespace nCine
 			case DefaultVertex::BATCHED_MESHSPRITES_NOTEXTURE:
 				vertexShader = "batched_meshsprites_notexture_vs.glsl"_s;
 				break;
+			case DefaultVertex::INSTANCED_SPRITES:
+				vertexShader = "instanced_sprites_vs.glsl"_s;
+				break;
 			//case DefaultVertex::BATCHED_TEXTNODES:
 			//	vertexShader = "batched_textnodes_vs.glsl";
 			//	break;
@@ -493,6 +502,9 @@ namespace nCine
 			case DefaultVertex::BATCHED_MESHSPRITES_NOTEXTURE:
 				vertexShader = ShaderStrings::batched_meshsprites_notexture_vs + 1;
 				break;
+			case DefaultVertex::INSTANCED_SPRITES:
+				vertexShader = ShaderStrings::instanced_sprites_vs + 1;
+				break;
 			//case DefaultVertex::BATCHED_TEXTNODES:
 			//	vertexShader = ShaderStrings::batched_textnodes_vs + 1;
 			//	break;
@@ -33,7 +33,8 @@ namespace nCine
 			BATCHED_SPRITES_NOTEXTURE,
 			BATCHED_MESHSPRITES,
 			BATCHED_MESHSPRITES_NOTEXTURE,
-			//BATCHED_TEXTNODES
+			//BATCHED_TEXTNODES,
+			INSTANCED_SPRITES
 		};
 
 		enum class DefaultFragment {
@@ -107,6 +108,9 @@ namespace nCine
 
 		/// Registers a shaders to be used for batches of render commands
 		void registerBatchedShader(Shader& batchedShader);
+		/// Registers a shader to be used for instanced drawing of sprites
+		/*! Instance values of the commands must be set with the `RenderCommand::setInstance*()` methods. */
+		void registerInstancedShader(Shader& instancedShader);
 
 		GLShaderProgram* getHandle() {
 			return glShaderProgram_.get();
@@ -22,11 +22,17 @@ namespace nCine
 			return;
 		}
 
-		auto buffer = std::make_unique<char[]>(fileSize);
-		fileHandle_->Read(buffer.get(), fileSize);
+		// Decode directly from memory if the file is already there (e.g., mapped from .pak file)
+		std::unique_ptr<char[]> buffer;
+		const void* fileData = fileHandle_->GetContentView().data();
+		if (fileData == nullptr) {
+			buffer = std::make_unique<char[]>(fileSize);
+			fileHandle_->Read(buffer.get(), fileSize);
+			fileData = buffer.get();
+		}
 
 		qoi_desc desc = { };
-		void* data = qoi_decode(buffer.get(), fileSize, &desc, 4);
+		void* data = qoi_decode(fileData, fileSize, &desc, 4);
 		if (data == nullptr) {
 			return;
 		}
@@ -13,6 +13,11 @@ namespace nCine
 	IInputManager::Cursor IInputManager::cursor_ = IInputManager::Cursor::Arrow;
 	JoyMapping IInputManager::joyMapping_;
 
+#if defined(DEDICATED_SERVER)
+	// Dedicated server has no input backend, so joysticks are never reported
+	const int IInputManager::MaxNumJoysticks = 0;
+#endif
+
 	JoystickGuid::JoystickGuid()
 	{
 		std::memset(data, 0, sizeof(data));
@@ -13,6 +13,15 @@
 #elif defined(WITH_QT5)
 #	include "Backends/Qt5GfxDevice.h"
 #	include "Backends/Qt5InputManager.h"
+#elif defined(WITH_NULL_GFX)
+#	include "Backends/NullGfxDevice.h"
+#	include "Backends/NullInputManager.h"
+#endif
+
+#if defined(DEDICATED_SERVER)
+#	include "Base/Clock.h"
+#	include "Base/Timer.h"
+#	include <csignal>
 #endif
 
 #if defined(DEATH_TARGET_EMSCRIPTEN)
@@ -193,6 +202,17 @@ bool __hasVirtualTerminal;
 
 namespace nCine
 {
+#if defined(DEDICATED_SERVER)
+	// Only a lock-free flag can be safely written from a signal handler, it's polled by runFixedTick()
+	static volatile std::sig_atomic_t terminationRequested = 0;
+
+	static void OnTerminationSignal(int signum)
+	{
+		// Dedicated server has no window, so it can be stopped only by a signal
+		terminationRequested = 1;
+	}
+#endif
+
 	Application& theApplication()
 	{
 		static MainApplication instance;
@@ -283,10 +303,17 @@ namespace nCine
 #	endif
 #endif
 
+#if defined(DEDICATED_SERVER)
+		std::signal(SIGINT, OnTerminationSignal);
+		std::signal(SIGTERM, OnTerminationSignal);
+#endif
+
 		MainApplication& app = static_cast<MainApplication&>(theApplication());
 		app.init(createAppEventHandler, argc, argv);
 
-#if !defined(DEATH_TARGET_EMSCRIPTEN)
+#if defined(DEDICATED_SERVER)
+		app.runFixedTick();
+#elif !defined(DEATH_TARGET_EMSCRIPTEN)
 		while (!app.shouldQuit_) {
 			app.run();
 		}
@@ -342,6 +369,13 @@ namespace nCine
 			return;
 		}
 
+#if defined(DEDICATED_SERVER)
+		// Dedicated server has no graphics device and no input manager, it's limited only by its tick rate
+		if (appCfg_.frameLimit == 0) {
+			appCfg_.frameLimit = DefaultTickRate;
+		}
+		LOGI("Running dedicated server at %u ticks per second", appCfg_.frameLimit);
+#else
 		// Graphics device should always be created before the input manager!
 		IGfxDevice::GLContextInfo glContextInfo(appCfg_);
 		const DisplayMode::VSync vSyncMode = (appCfg_.withVSync ? DisplayMode::VSync::Enabled : DisplayMode::VSync::Disabled);
@@ -358,6 +392,9 @@ namespace nCine
 		FATAL_ASSERT_MSG(qt5Widget_, "The Qt5 widget has not been assigned");
 		gfxDevice_ = std::make_unique<Qt5GfxDevice>(windowMode, glContextInfo, displayMode, *qt5Widget_);
 		inputManager_ = std::make_unique<Qt5InputManager>(*qt5Widget_);
+#elif defined(WITH_NULL_GFX)
+		gfxDevice_ = std::make_unique<NullGfxDevice>(windowMode, glContextInfo, displayMode);
+		inputManager_ = std::make_unique<NullInputManager>();
 #endif
 		gfxDevice_->setWindowTitle(appCfg_.windowTitle.data());
 		if (!appCfg_.windowIconFilename.empty()) {
@@ -366,6 +403,7 @@ namespace nCine
 				gfxDevice_->setWindowIcon(windowIconFilePath);
 			}
 		}
+#endif
 
 #if defined(NCINE_PROFILING)
 		timings_[(int)Timings::PreInit] = profileStartTime_.secondsSince();
@@ -376,6 +414,38 @@ namespace nCine
 #endif
 	}
 
+#if defined(DEDICATED_SERVER)
+	void MainApplication::runFixedTick()
+	{
+		Clock& c = clock();
+		const std::uint64_t frequency = c.frequency();
+		const std::uint64_t ticksPerStep = frequency / appCfg_.frameLimit;
+		std::uint64_t nextStep = c.now();
+
+		while (!shouldQuit_) {
+			if (terminationRequested != 0) {
+				shouldQuit_ = true;
+				break;
+			}
+
+			step();
+
+			nextStep += ticksPerStep;
+			const std::uint64_t now = c.now();
+			if (now < nextStep) {
+				// Sleep instead of busy waiting, the remainder is not lost because the next deadline is absolute
+				const std::uint32_t remainingMs = static_cast<std::uint32_t>((nextStep - now) * 1000 / frequency);
+				if (remainingMs > 0) {
+					Timer::sleep(remainingMs);
+				}
+			} else if (now - nextStep > ticksPerStep * MaxLaggingTicks) {
+				// The simulation cannot keep up, drop missed steps instead of trying to catch up
+				LOGW("Server is overloaded, skipping %u ticks", static_cast<std::uint32_t>((now - nextStep) / ticksPerStep));
+				nextStep = now;
+			}
+		}
+	}
+#else
 	void MainApplication::run()
 	{
 #if !defined(WITH_QT5)
@@ -398,6 +468,7 @@ namespace nCine
 			step();
 		}
 	}
+#endif
 
 #if defined(WITH_SDL)
 	void MainApplication::processEvents()
@@ -465,6 +536,11 @@ namespace nCine
 		}
 		GlfwInputManager::updateJoystickStates();
 	}
+#elif defined(WITH_NULL_GFX)
+	void MainApplication::processEvents()
+	{
+		// Null graphics device has no window, so there are no events to process
+	}
 #endif
 
 #if defined(DEATH_TARGET_EMSCRIPTEN)
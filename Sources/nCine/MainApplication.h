@@ -32,10 +32,20 @@ namespace nCine
 
 		/// Must be called at the beginning to initialize the application
 		void init(std::unique_ptr<IAppEventHandler>(*createAppEventHandler)(), int argc, NativeArgument* argv);
+#if defined(DEDICATED_SERVER)
+		/// Default number of simulation steps per second if frame limit is not specified
+		static constexpr std::uint32_t DefaultTickRate = 60;
+		/// Maximum number of steps the scheduler can fall behind before the missed steps are dropped
+		static constexpr std::uint32_t MaxLaggingTicks = 5;
+
+		/// Runs the simulation at fixed tick rate until the application quits
+		void runFixedTick();
+#else
 		/// Must be called continuously to keep the application running
 		void run();
 		/// Processes events inside the game loop
 		void processEvents();
+#endif
 #if defined(DEATH_TARGET_EMSCRIPTEN)
 		static void emscriptenStep();
 #endif
@@ -0,0 +1,20 @@
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+in vec4 aInstanceTransform;
+in vec3 aInstancePosition;
+in vec4 aInstanceColor;
+in vec4 aInstanceTexRect;
+
+out vec2 vTexCoords;
+out vec4 vColor;
+
+void main()
+{
+	vec2 aPosition = vec2(1.0 - float(gl_VertexID >> 1), float(gl_VertexID % 2));
+	vec2 position = aPosition.x * aInstanceTransform.xy + aPosition.y * aInstanceTransform.zw + aInstancePosition.xy;
+
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(position, aInstancePosition.z, 1.0);
+	vTexCoords = vec2(aPosition.x * aInstanceTexRect.x + aInstanceTexRect.y, aPosition.y * aInstanceTexRect.z + aInstanceTexRect.w);
+	vColor = aInstanceColor;
+}
@@ -2,8 +2,12 @@
 
 #include "IThreadCommand.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
+#include <Base/FunctionRef.h>
+
 namespace nCine
 {
 	/// Thread pool interface class
@@ -14,6 +18,11 @@ namespace nCine
 
 		/// Enqueues a command request for a worker thread
 		virtual void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) = 0;
+		/// Returns number of worker threads, commands are never executed if there are none
+		virtual std::size_t GetThreadCount() const = 0;
+		/// Calls the function for all subranges of `[0, count)` of at most `grainSize` items and waits until all of them are processed
+		/*! The calling thread takes part in processing too, the order in which subranges are processed is not specified */
+		virtual void ParallelFor(std::int32_t count, std::int32_t grainSize, Death::FunctionRef<void(std::int32_t, std::int32_t)> function) = 0;
 	};
 
 	inline IThreadPool::~IThreadPool() { }
@@ -23,5 +32,11 @@ namespace nCine
 	{
 	public:
 		void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) override { }
+		std::size_t GetThreadCount() const override { return 0; }
+		void ParallelFor(std::int32_t count, std::int32_t grainSize, Death::FunctionRef<void(std::int32_t, std::int32_t)> function) override {
+			if (count > 0) {
+				function(0, count);
+			}
+		}
 	};
 }
\ No newline at end of file
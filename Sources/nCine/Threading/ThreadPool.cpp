@@ -3,76 +3,436 @@
 #include "ThreadPool.h"
 #include "../../Common.h"
 
+#include <algorithm>
+
 namespace nCine
 {
+	namespace
+	{
+		DEATH_THREAD_LOCAL void* currentContext = nullptr;
+	}
+
+	void JobCounter::Lock()
+	{
+		while (!lock_.cmpExchange(1, 0, Atomic32::MemoryModel::ACQUIRE)) {
+			Thread::YieldExecution();
+		}
+	}
+
+	void JobCounter::Unlock()
+	{
+		lock_.store(0, Atomic32::MemoryModel::RELEASE);
+	}
+
+	ThreadPool::WorkQueue::WorkQueue()
+		: items(std::make_unique<Atomic32[]>(QueueCapacity))
+	{
+	}
+
+	bool ThreadPool::WorkQueue::Push(std::int32_t jobIndex)
+	{
+		std::int64_t b = bottom.load(Atomic64::MemoryModel::RELAXED);
+		std::int64_t t = top.load(Atomic64::MemoryModel::ACQUIRE);
+		if (b - t >= QueueCapacity) {
+			return false;
+		}
+
+		items[b & (QueueCapacity - 1)].store(jobIndex, Atomic32::MemoryModel::RELEASE);
+		// Sequentially consistent, so sleeping workers can't miss the job (see WorkerFunction())
+		bottom.store(b + 1);
+		return true;
+	}
+
+	std::int32_t ThreadPool::WorkQueue::Pop()
+	{
+		// Read-modify-write acts as a full barrier between publishing the new bottom and reading the top
+		std::int64_t b = bottom.fetchSub(1) - 1;
+		std::int64_t t = top.load();
+		if (t > b) {
+			bottom.store(b + 1, Atomic64::MemoryModel::RELAXED);
+			return -1;
+		}
+
+		std::int32_t jobIndex = items[b & (QueueCapacity - 1)].load(Atomic32::MemoryModel::RELAXED);
+		if (t == b) {
+			// The last item, race against thieves
+			if (!top.cmpExchange(t + 1, t)) {
+				jobIndex = -1;
+			}
+			bottom.store(b + 1, Atomic64::MemoryModel::RELAXED);
+		}
+		return jobIndex;
+	}
+
+	std::int32_t ThreadPool::WorkQueue::Steal()
+	{
+		std::int64_t t = top.load(Atomic64::MemoryModel::ACQUIRE);
+		std::int64_t b = bottom.fetchAdd(0);
+		if (t >= b) {
+			return -1;
+		}
+
+		std::int32_t jobIndex = items[t & (QueueCapacity - 1)].load(Atomic32::MemoryModel::ACQUIRE);
+		if (!top.cmpExchange(t + 1, t)) {
+			return -1;
+		}
+		return jobIndex;
+	}
+
+	bool ThreadPool::WorkQueue::IsEmpty()
+	{
+		return (bottom.load() <= top.load());
+	}
+
 	ThreadPool::ThreadPool()
 		: ThreadPool(Thread::GetProcessorCount())
 	{
 	}
 
 	ThreadPool::ThreadPool(std::size_t numThreads)
-		: threads_(numThreads), numThreads_(numThreads)
+		: numThreads_(numThreads), numContexts_(std::int32_t(numThreads + 2)), commandsHead_(0)
 	{
-		threadStruct_.queue = &queue_;
-		threadStruct_.queueMutex = &queueMutex_;
-		threadStruct_.queueCV = &queueCV_;
-		threadStruct_.shouldQuit = false;
+		// Workers have the first contexts, then the thread that created the pool and the shared one for other threads
+		contexts_ = std::make_unique<Context[]>(numContexts_);
+		jobs_ = std::make_unique<Job[]>(std::size_t(numContexts_) * JobsPerThread);
+		for (std::int32_t i = 0; i < numContexts_; i++) {
+			contexts_[i].pool = this;
+			contexts_[i].index = i;
+			contexts_[i].nextJob = 0;
+			contexts_[i].nextVictim = (i + 1) % numContexts_;
+		}
 
-		quitMutex_.Lock();
+		currentContext = &contexts_[numThreads_];
 
+		threads_.reserve(numThreads_);
 		for (std::size_t i = 0; i < numThreads_; i++) {
-			threads_.emplace_back(WorkerFunction, &threadStruct_);
+			threads_.emplace_back(WorkerFunction, &contexts_[i]);
 		}
 	}
 
 	ThreadPool::~ThreadPool()
 	{
-		threadStruct_.shouldQuit = true;
-		queueCV_.Broadcast();
+		sleepMutex_.Lock();
+		shouldQuit_.store(1);
+		sleepCV_.Broadcast();
+		sleepMutex_.Unlock();
 
 		for (std::size_t i = 0; i < numThreads_; i++) {
 			threads_[i].Join();
 		}
+
+		// Jobs that weren't executed yet are dropped
+		for (std::int32_t i = 0; i < numContexts_; i++) {
+			std::int32_t jobIndex;
+			while ((jobIndex = contexts_[i].queue.Pop()) >= 0) {
+				Job& job = jobs_[jobIndex];
+				job.Invoke(job, false);
+				job.InUse.store(0, Atomic32::MemoryModel::RELEASE);
+			}
+		}
+
+		if (currentContext == &contexts_[numThreads_]) {
+			currentContext = nullptr;
+		}
 	}
 
 	void ThreadPool::EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand)
 	{
 		ASSERT(threadCommand);
 
-		queueMutex_.Lock();
-		queue_.push_back(std::move(threadCommand));
-		queueCV_.Broadcast();
-		queueMutex_.Unlock();
+		if (numThreads_ == 0) {
+			threadCommand->Execute();
+			return;
+		}
+
+		commandMutex_.Lock();
+		commands_.push_back(std::move(threadCommand));
+		pendingCommands_.fetchAdd(1);
+		commandMutex_.Unlock();
+
+		if (sleepingCount_.load() > 0) {
+			sleepMutex_.Lock();
+			sleepCV_.Signal();
+			sleepMutex_.Unlock();
+		}
+	}
+
+	void ThreadPool::ParallelFor(std::int32_t count, std::int32_t grainSize, Death::FunctionRef<void(std::int32_t, std::int32_t)> function)
+	{
+		if (count <= 0) {
+			return;
+		}
+
+		grainSize = std::max(grainSize, 1);
+		std::int32_t chunkCount = (count + grainSize - 1) / grainSize;
+		std::int32_t jobCount = std::min(std::int32_t(numThreads_), chunkCount - 1);
+		if (jobCount <= 0) {
+			function(0, count);
+			return;
+		}
+
+		struct ParallelForState {
+			Death::FunctionRef<void(std::int32_t, std::int32_t)> Function;
+			Atomic32 NextChunk;
+			std::int32_t ChunkCount;
+			std::int32_t GrainSize;
+			std::int32_t Count;
+
+			void Process() {
+				while (true) {
+					std::int32_t chunk = NextChunk.fetchAdd(1, Atomic32::MemoryModel::RELAXED);
+					if (chunk >= ChunkCount) {
+						break;
+					}
+					std::int32_t first = chunk * GrainSize;
+					Function(first, std::min(first + GrainSize, Count));
+				}
+			}
+		};
+
+		ParallelForState state;
+		state.Function = function;
+		state.ChunkCount = chunkCount;
+		state.GrainSize = grainSize;
+		state.Count = count;
+
+		JobCounter counter;
+		for (std::int32_t i = 0; i < jobCount; i++) {
+			Run([&state]() {
+				state.Process();
+			}, &counter);
+		}
+
+		state.Process();
+		Wait(counter);
+	}
+
+	void ThreadPool::Wait(JobCounter& counter)
+	{
+		Context* context = GetCurrentContext();
+		while (!counter.IsDone()) {
+			std::int32_t jobIndex = FindJob(context);
+			if (jobIndex >= 0) {
+				ExecuteJob(jobIndex);
+			} else {
+				Thread::YieldExecution();
+			}
+		}
+	}
+
+	ThreadPool::Context* ThreadPool::GetCurrentContext()
+	{
+		Context* context = static_cast<Context*>(currentContext);
+		return (context != nullptr && context->pool == this ? context : nullptr);
+	}
+
+	std::int32_t ThreadPool::AcquireJob()
+	{
+		Context* context = GetCurrentContext();
+		bool isExternal = (context == nullptr);
+		if (isExternal) {
+			context = &contexts_[numContexts_ - 1];
+			externalMutex_.Lock();
+		}
+
+		// Only the owning thread allocates from its own range, so the slot doesn't need to be acquired atomically
+		std::int32_t jobIndex = -1;
+		std::int32_t first = context->index * JobsPerThread;
+		for (std::int32_t i = 0; i < JobsPerThread; i++) {
+			std::int32_t candidate = first + ((context->nextJob + i) & (JobsPerThread - 1));
+			if (jobs_[candidate].InUse.load(Atomic32::MemoryModel::ACQUIRE) == 0) {
+				jobs_[candidate].InUse.store(1, Atomic32::MemoryModel::RELAXED);
+				context->nextJob = candidate - first + 1;
+				jobIndex = candidate;
+				break;
+			}
+		}
+
+		if (isExternal) {
+			externalMutex_.Unlock();
+		}
+		return jobIndex;
+	}
+
+	bool ThreadPool::AddContinuation(JobCounter& dependency, std::int32_t jobIndex)
+	{
+		dependency.Lock();
+		bool isPending = (dependency.count_.load() > 0);
+		if (isPending) {
+			dependency.continuations_.push_back(jobIndex);
+		}
+		dependency.Unlock();
+		return isPending;
+	}
+
+	void ThreadPool::Submit(std::int32_t jobIndex)
+	{
+		Context* context = GetCurrentContext();
+		bool pushed;
+		if (context != nullptr) {
+			pushed = context->queue.Push(jobIndex);
+		} else {
+			externalMutex_.Lock();
+			pushed = contexts_[numContexts_ - 1].queue.Push(jobIndex);
+			externalMutex_.Unlock();
+		}
+
+		if (!pushed) {
+			ExecuteJob(jobIndex);
+			return;
+		}
+
+		if (sleepingCount_.load() > 0) {
+			sleepMutex_.Lock();
+			sleepCV_.Signal();
+			sleepMutex_.Unlock();
+		}
+	}
+
+	std::int32_t ThreadPool::FindJob(Context* context)
+	{
+		std::int32_t jobIndex;
+		if (context != nullptr) {
+			jobIndex = context->queue.Pop();
+		} else {
+			context = &contexts_[numContexts_ - 1];
+			externalMutex_.Lock();
+			jobIndex = context->queue.Pop();
+			externalMutex_.Unlock();
+		}
+		if (jobIndex >= 0) {
+			return jobIndex;
+		}
+
+		// The shared context is used by multiple threads, so it always starts from the first one
+		bool isExternal = (context->index == numContexts_ - 1);
+		std::int32_t firstVictim = (isExternal ? 0 : context->nextVictim);
+		if (!isExternal) {
+			context->nextVictim = (firstVictim + 1) % numContexts_;
+		}
+
+		for (std::int32_t i = 0; i < numContexts_; i++) {
+			std::int32_t victim = (firstVictim + i) % numContexts_;
+			if (victim != context->index) {
+				jobIndex = contexts_[victim].queue.Steal();
+				if (jobIndex >= 0) {
+					return jobIndex;
+				}
+			}
+		}
+		return -1;
+	}
+
+	void ThreadPool::ExecuteJob(std::int32_t jobIndex)
+	{
+		Job& job = jobs_[jobIndex];
+		JobCounter* counter = job.Counter;
+		job.Invoke(job, true);
+		job.InUse.store(0, Atomic32::MemoryModel::RELEASE);
+
+		if (counter == nullptr) {
+			return;
+		}
+
+		// The counter can be destroyed by a waiting thread as soon as it's unlocked, so it can't be touched afterwards
+		SmallVector<std::int32_t, 4> continuations;
+		counter->Lock();
+		if (counter->count_.fetchSub(1) == 1) {
+			continuations = std::move(counter->continuations_);
+			counter->continuations_.clear();
+		}
+		counter->Unlock();
+
+		for (std::int32_t continuation : continuations) {
+			Submit(continuation);
+		}
+	}
+
+	bool ThreadPool::ExecuteCommand()
+	{
+		if (pendingCommands_.load() == 0) {
+			return false;
+		}
+
+		commandMutex_.Lock();
+		if (commandsHead_ >= commands_.size()) {
+			commandMutex_.Unlock();
+			return false;
+		}
+		std::unique_ptr<IThreadCommand> command = std::move(commands_[commandsHead_]);
+		commandsHead_++;
+		if (commandsHead_ == commands_.size()) {
+			commands_.clear();
+			commandsHead_ = 0;
+		} else if (commandsHead_ >= 64 && commandsHead_ * 2 >= commands_.size()) {
+			commands_.erase(commands_.begin(), commands_.begin() + commandsHead_);
+			commandsHead_ = 0;
+		}
+		pendingCommands_.fetchSub(1);
+		commandMutex_.Unlock();
+
+		command->Execute();
+		return true;
+	}
+
+	bool ThreadPool::HasQueuedJobs()
+	{
+		if (pendingCommands_.load() > 0) {
+			return true;
+		}
+		for (std::int32_t i = 0; i < numContexts_; i++) {
+			if (!contexts_[i].queue.IsEmpty()) {
+				return true;
+			}
+		}
+		return false;
 	}
 
 	void ThreadPool::WorkerFunction(void* arg)
 	{
-		ThreadStruct* threadStruct = static_cast<ThreadStruct*>(arg);
+		Context* context = static_cast<Context*>(arg);
+		ThreadPool* pool = context->pool;
+		currentContext = context;
 
 		LOGD("Worker thread %llu is starting", Thread::GetCurrentId());
 
+		std::int32_t idleCount = 0;
 		while (true) {
-			threadStruct->queueMutex->Lock();
-			while (threadStruct->queue->empty() && !threadStruct->shouldQuit) {
-				threadStruct->queueCV->Wait(*(threadStruct->queueMutex));
+			std::int32_t jobIndex = pool->FindJob(context);
+			if (jobIndex >= 0) {
+				pool->ExecuteJob(jobIndex);
+				idleCount = 0;
+				continue;
 			}
 
-			if (threadStruct->shouldQuit) {
-				threadStruct->queueMutex->Unlock();
+			if (pool->shouldQuit_.load() != 0) {
 				break;
 			}
 
-			std::unique_ptr<IThreadCommand> threadCommand = std::move(threadStruct->queue->front());
-			threadStruct->queue->pop_front();
-			threadStruct->queueMutex->Unlock();
+			// Commands have lower priority than jobs, so they are executed only when no job is queued
+			if (pool->ExecuteCommand()) {
+				idleCount = 0;
+				continue;
+			}
 
-			LOGD("Worker thread %llu is executing its command", Thread::GetCurrentId());
-			threadCommand->Execute();
+			if (++idleCount < 64) {
+				Thread::YieldExecution();
+				continue;
+			}
+			idleCount = 0;
+
+			// Counter is incremented before checking the queues, so a concurrent Submit() either sees it or its job is found here
+			pool->sleepMutex_.Lock();
+			pool->sleepingCount_.fetchAdd(1);
+			while (!pool->HasQueuedJobs() && pool->shouldQuit_.load() == 0) {
+				pool->sleepCV_.Wait(pool->sleepMutex_);
+			}
+			pool->sleepingCount_.fetchSub(1);
+			pool->sleepMutex_.Unlock();
 		}
 
 		LOGD("Worker thread %llu is exiting", Thread::GetCurrentId());
 	}
-
 }
 
 #endif
\ No newline at end of file
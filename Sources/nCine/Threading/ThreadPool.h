@@ -4,7 +4,9 @@
 #include "ThreadSync.h"
 #include "Thread.h"
 
-#include <list>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include <Containers/SmallVector.h>
 
@@ -12,36 +14,200 @@ using namespace Death::Containers;
 
 namespace nCine
 {
-	/// Thread pool class
+	class ThreadPool;
+
+	/// Counter of unfinished jobs, it can be waited for or used as a dependency of other jobs
+	class JobCounter
+	{
+		friend class ThreadPool;
+
+	public:
+		JobCounter() {}
+
+		/// Returns `true` if all jobs associated with the counter are finished
+		bool IsDone() {
+			return (count_.load(Atomic32::MemoryModel::ACQUIRE) == 0 && lock_.load(Atomic32::MemoryModel::ACQUIRE) == 0);
+		}
+
+	private:
+		Atomic32 count_;
+		Atomic32 lock_;
+		SmallVector<std::int32_t, 4> continuations_;
+
+		void Lock();
+		void Unlock();
+
+		/// Deleted copy constructor
+		JobCounter(const JobCounter&) = delete;
+		/// Deleted assignment operator
+		JobCounter& operator=(const JobCounter&) = delete;
+	};
+
+	/// Thread pool class with per-thread work-stealing queues
+	/*! Jobs are preallocated per submitting thread and small functions are stored inline, so submitting
+	 *  a job doesn't allocate. The thread that created the pool has its own queue, other threads share a locked one.
+	 *  Commands are long-running background work, so they have a separate low-priority queue that is never drained by `Wait()`. */
 	class ThreadPool : public IThreadPool
 	{
 	public:
+		/// Maximum size of a function stored inline in a job, larger ones are allocated on the heap
+		static constexpr std::size_t InlineJobSize = 40;
+		/// Maximum number of unfinished jobs submitted from one thread, additional jobs are executed immediately
+		static constexpr std::int32_t JobsPerThread = 1024;
+
 		/// Creates a thread pool with as many threads as available processors
 		ThreadPool();
 		/// Creates a thread pool with a specified number of threads
 		explicit ThreadPool(std::size_t numThreads);
 		~ThreadPool() override;
 
-		/// Enqueues a command request for a worker thread
+		/// Enqueues a command request for a worker thread, it's executed only when no other job is queued
 		void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) override;
+		/// Returns number of worker threads
+		std::size_t GetThreadCount() const override {
+			return numThreads_;
+		}
+		void ParallelFor(std::int32_t count, std::int32_t grainSize, Death::FunctionRef<void(std::int32_t, std::int32_t)> function) override;
+
+		/// Submits a function to be executed by a worker thread, the optional counter is incremented until it finishes
+		template<class F>
+		void Run(F&& function, JobCounter* counter = nullptr)
+		{
+			std::int32_t jobIndex = AllocateJob(std::forward<F>(function), counter);
+			if (jobIndex < 0) {
+				function();
+				return;
+			}
+			Submit(jobIndex);
+		}
+
+		/// Submits a function to be executed by a worker thread once all jobs associated with the dependency are finished
+		template<class F>
+		void RunAfter(JobCounter& dependency, F&& function, JobCounter* counter = nullptr)
+		{
+			std::int32_t jobIndex = AllocateJob(std::forward<F>(function), counter);
+			if (jobIndex < 0) {
+				Wait(dependency);
+				function();
+				return;
+			}
+			if (!AddContinuation(dependency, jobIndex)) {
+				Submit(jobIndex);
+			}
+		}
+
+		/// Waits until all jobs associated with the counter are finished, the calling thread executes other jobs (but not commands) meanwhile
+		void Wait(JobCounter& counter);
 
 	private:
-		struct ThreadStruct
+		static constexpr std::int32_t QueueCapacity = 2048;
+
+		static_assert((JobsPerThread & (JobsPerThread - 1)) == 0 && (QueueCapacity & (QueueCapacity - 1)) == 0, "Sizes must be power of two");
+
+		struct alignas(64) Job
+		{
+			/// Executes the stored function if requested and destroys it
+			void (*Invoke)(Job& job, bool execute);
+			JobCounter* Counter;
+			Atomic32 InUse;
+			alignas(void*) unsigned char Storage[InlineJobSize];
+		};
+
+		/// Chase-Lev work-stealing queue of job indices, only the owner can push and pop, others can steal
+		struct WorkQueue
+		{
+			Atomic64 top;
+			Atomic64 bottom;
+			std::unique_ptr<Atomic32[]> items;
+
+			WorkQueue();
+
+			bool Push(std::int32_t jobIndex);
+			std::int32_t Pop();
+			std::int32_t Steal();
+			bool IsEmpty();
+		};
+
+		struct Context
 		{
-			std::list<std::unique_ptr<IThreadCommand>>* queue;
-			Mutex* queueMutex;
-			CondVariable* queueCV;
-			bool shouldQuit;
+			ThreadPool* pool;
+			std::int32_t index;
+			std::int32_t nextJob;
+			std::int32_t nextVictim;
+			WorkQueue queue;
 		};
 
-		std::list<std::unique_ptr<IThreadCommand>> queue_;
 		SmallVector<Thread, 0> threads_;
-		Mutex queueMutex_;
-		CondVariable queueCV_;
-		Mutex quitMutex_;
+		std::unique_ptr<Context[]> contexts_;
+		std::unique_ptr<Job[]> jobs_;
 		std::size_t numThreads_;
+		std::int32_t numContexts_;
+		/// Protects the queue and jobs of the context shared by threads not owned by the pool
+		Mutex externalMutex_;
+		Mutex commandMutex_;
+		/// Commands are consumed from `commandsHead_`, already consumed slots are reclaimed in bulk
+		SmallVector<std::unique_ptr<IThreadCommand>, 0> commands_;
+		std::size_t commandsHead_;
+		Atomic32 pendingCommands_;
+		Mutex sleepMutex_;
+		CondVariable sleepCV_;
+		Atomic32 sleepingCount_;
+		Atomic32 shouldQuit_;
+
+		template<class F>
+		static void InvokeInline(Job& job, bool execute)
+		{
+			F* function = std::launder(reinterpret_cast<F*>(job.Storage));
+			if (execute) {
+				(*function)();
+			}
+			function->~F();
+		}
+
+		template<class F>
+		static void InvokeHeap(Job& job, bool execute)
+		{
+			F* function = *reinterpret_cast<F**>(job.Storage);
+			if (execute) {
+				(*function)();
+			}
+			delete function;
+		}
+
+		template<class F>
+		std::int32_t AllocateJob(F&& function, JobCounter* counter)
+		{
+			using Function = typename std::decay<F>::type;
+
+			std::int32_t jobIndex = AcquireJob();
+			if (jobIndex < 0) {
+				return -1;
+			}
+
+			Job& job = jobs_[jobIndex];
+			if constexpr (sizeof(Function) <= InlineJobSize && alignof(Function) <= alignof(void*)) {
+				new(job.Storage) Function(std::forward<F>(function));
+				job.Invoke = &InvokeInline<Function>;
+			} else {
+				*reinterpret_cast<Function**>(job.Storage) = new Function(std::forward<F>(function));
+				job.Invoke = &InvokeHeap<Function>;
+			}
+			job.Counter = counter;
+			if (counter != nullptr) {
+				counter->count_.fetchAdd(1);
+			}
+			return jobIndex;
+		}
+
+		Context* GetCurrentContext();
+		std::int32_t AcquireJob();
+		bool AddContinuation(JobCounter& dependency, std::int32_t jobIndex);
+		void Submit(std::int32_t jobIndex);
+		std::int32_t FindJob(Context* context);
+		void ExecuteJob(std::int32_t jobIndex);
+		bool ExecuteCommand();
+		bool HasQueuedJobs();
 
-		ThreadStruct threadStruct_;
 		static void WorkerFunction(void* arg);
 
 		/// Deleted copy constructor
@@ -0,0 +1,24 @@
+# Find LZ4 library
+#
+#  LZ4_INCLUDE_DIR - where to find lz4.h and lz4hc.h
+#  LZ4_LIBRARY     - library when using LZ4
+#  LZ4_FOUND       - true if LZ4 is found
+#
+# The imported target LZ4::LZ4 is defined if LZ4 is found
+
+find_path(LZ4_INCLUDE_DIR NAMES lz4.h lz4hc.h
+  PATHS ${NCINE_LIBS}/Linux/${CMAKE_SYSTEM_PROCESSOR}/)
+find_library(LZ4_LIBRARY NAMES lz4 liblz4
+  PATHS ${NCINE_LIBS}/Linux/${CMAKE_SYSTEM_PROCESSOR}/)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 REQUIRED_VARS LZ4_LIBRARY LZ4_INCLUDE_DIR)
+
+mark_as_advanced(LZ4_LIBRARY LZ4_INCLUDE_DIR)
+
+if(LZ4_FOUND AND NOT TARGET LZ4::LZ4)
+  add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+  set_target_properties(LZ4::LZ4 PROPERTIES
+    IMPORTED_LOCATION "${LZ4_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIR}")
+endif()
@@ -0,0 +1,24 @@
+# Find Zstandard library
+#
+#  ZSTD_INCLUDE_DIR - where to find zstd.h
+#  ZSTD_LIBRARY     - library when using Zstandard
+#  ZSTD_FOUND       - true if Zstandard is found
+#
+# The imported target Zstd::Zstd is defined if Zstandard is found
+
+find_path(ZSTD_INCLUDE_DIR NAMES zstd.h
+  PATHS ${NCINE_LIBS}/Linux/${CMAKE_SYSTEM_PROCESSOR}/)
+find_library(ZSTD_LIBRARY NAMES zstd libzstd
+  PATHS ${NCINE_LIBS}/Linux/${CMAKE_SYSTEM_PROCESSOR}/)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+mark_as_advanced(ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+if(ZSTD_FOUND AND NOT TARGET Zstd::Zstd)
+  add_library(Zstd::Zstd UNKNOWN IMPORTED)
+  set_target_properties(Zstd::Zstd PROPERTIES
+    IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}")
+endif()
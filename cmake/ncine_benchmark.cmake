@@ -0,0 +1,54 @@
+# Render benchmark is built from the same sources as the game, but it uses null graphics device instead of window, input and audio backends.
+# OpenGL calls are recorded instead of executed, so CPU cost of the whole rendering pipeline can be measured also on machines without GPU.
+set(NCINE_BENCHMARK_APP "${NCINE_APP}_benchmark")
+message(STATUS "Building also render benchmark: ${NCINE_BENCHMARK_APP}")
+
+add_executable(${NCINE_BENCHMARK_APP})
+
+set(BENCHMARK_SOURCES ${SOURCES} ${GENERATED_SOURCES})
+list(FILTER BENCHMARK_SOURCES EXCLUDE REGEX "/nCine/(Audio|Backends)/")
+list(FILTER BENCHMARK_SOURCES EXCLUDE REGEX "/nCine/Graphics/ImGui|/nCine/Input/ImGui")
+if(IMGUI_SOURCE_DIR)
+	list(FILTER BENCHMARK_SOURCES EXCLUDE REGEX "^${IMGUI_SOURCE_DIR}/")
+endif()
+if(NOT ${NCINE_SOURCE_DIR}/nCine/Input/JoyMapping.cpp IN_LIST BENCHMARK_SOURCES)
+	list(APPEND BENCHMARK_SOURCES ${NCINE_SOURCE_DIR}/nCine/Input/JoyMapping.cpp)
+endif()
+list(APPEND BENCHMARK_SOURCES
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullGfxDevice.cpp
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullGLFunctions.cpp
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullInputManager.cpp
+)
+
+set(BENCHMARK_HEADERS ${HEADERS})
+list(FILTER BENCHMARK_HEADERS EXCLUDE REGEX "/nCine/(Audio|Backends)/|/nCine/Graphics/ImGui|/nCine/Input/ImGui")
+if(IMGUI_SOURCE_DIR)
+	list(FILTER BENCHMARK_HEADERS EXCLUDE REGEX "^${IMGUI_SOURCE_DIR}/|^${IMGUI_INCLUDE_ONLY_DIR}/")
+endif()
+list(APPEND BENCHMARK_HEADERS
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullGfxDevice.h
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullGLFunctions.h
+	${NCINE_SOURCE_DIR}/nCine/Backends/NullInputManager.h
+)
+
+target_sources(${NCINE_BENCHMARK_APP} PRIVATE ${BENCHMARK_SOURCES} ${BENCHMARK_HEADERS})
+
+# Compiler options, include directories and common definitions are shared with the game
+foreach(PROPERTY_NAME COMPILE_OPTIONS COMPILE_FEATURES INCLUDE_DIRECTORIES LINK_OPTIONS CXX_STANDARD CXX_STANDARD_REQUIRED CXX_EXTENSIONS
+		INTERPROCEDURAL_OPTIMIZATION MSVC_RUNTIME_LIBRARY)
+	get_target_property(PROPERTY_VALUE ${NCINE_APP} ${PROPERTY_NAME})
+	if(NOT PROPERTY_VALUE STREQUAL "PROPERTY_VALUE-NOTFOUND")
+		set_target_properties(${NCINE_BENCHMARK_APP} PROPERTIES ${PROPERTY_NAME} "${PROPERTY_VALUE}")
+	endif()
+endforeach()
+
+# Render statistics and timings are available only with profiling enabled
+get_target_property(BENCHMARK_DEFINITIONS ${NCINE_APP} COMPILE_DEFINITIONS)
+list(FILTER BENCHMARK_DEFINITIONS EXCLUDE REGEX "^WITH_(AUDIO|VORBIS|VORBIS_DYNAMIC|OPENMPT|OPENMPT_DYNAMIC|GLFW|SDL|QT5|QT5GAMEPAD|IMGUI|GLEW|OPENGLES|ANGLE|TRACY_OPENGL)$")
+list(REMOVE_ITEM BENCHMARK_DEFINITIONS "NCINE_PROFILING")
+target_compile_definitions(${NCINE_BENCHMARK_APP} PRIVATE ${BENCHMARK_DEFINITIONS} "WITH_NULL_GFX" "RENDER_BENCHMARK" "NCINE_PROFILING")
+
+get_target_property(BENCHMARK_LIBRARIES ${NCINE_APP} LINK_LIBRARIES)
+list(FILTER BENCHMARK_LIBRARIES EXCLUDE REGEX "^(OpenGL|GLEW|EGL|OpenGLES2|GLFW|SDL2|Qt5|OpenAL|Vorbis|libopenmpt)::")
+list(FILTER BENCHMARK_LIBRARIES EXCLUDE REGEX "^(imm32|dwmapi|idbfs\\.js)$")
+target_link_libraries(${NCINE_BENCHMARK_APP} PRIVATE ${BENCHMARK_LIBRARIES})
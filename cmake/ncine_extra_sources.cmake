@@ -490,6 +490,16 @@ if(ZLIB_FOUND)
 	target_link_libraries(${NCINE_APP} PRIVATE ZLIB::ZLIB)
 endif()
 
+if(NCINE_WITH_LZ4 AND LZ4_FOUND)
+	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_LZ4")
+	target_link_libraries(${NCINE_APP} PRIVATE LZ4::LZ4)
+endif()
+
+if(NCINE_WITH_ZSTD AND ZSTD_FOUND)
+	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_ZSTD")
+	target_link_libraries(${NCINE_APP} PRIVATE Zstd::Zstd)
+endif()
+
 if(NCINE_BUILD_ANDROID)
 	list(APPEND HEADERS
 		${NCINE_SOURCE_DIR}/nCine/Backends/Android/AndroidApplication.h
@@ -222,6 +222,12 @@ elseif(NOT ANDROID AND NOT NCINE_BUILD_ANDROID) # GCC and LLVM
 	if(NCINE_WITH_WEBP)
 		find_package(WebP)
 	endif()
+	if(NCINE_WITH_LZ4)
+		find_package(LZ4)
+	endif()
+	if(NCINE_WITH_ZSTD)
+		find_package(Zstd)
+	endif()
 	if(NCINE_WITH_AUDIO)
 		find_package(OpenAL)
 
@@ -194,11 +194,17 @@ include(CPack)
 
 if(UNIX AND NOT APPLE)
 	install(TARGETS ${NCINE_APP} RUNTIME DESTINATION "bin")
+	if(DEDICATED_SERVER)
+		install(TARGETS ${NCINE_SERVER_APP} RUNTIME DESTINATION "bin")
+	endif()
 	if(NOT NCINE_BUILD_FLATPAK)
 		install(FILES "${NCINE_ROOT}/README.md" DESTINATION ${README_INSTALL_DESTINATION})
 	endif()
 else()
 	install(TARGETS ${NCINE_APP} RUNTIME DESTINATION ".")
+	if(DEDICATED_SERVER)
+		install(TARGETS ${NCINE_SERVER_APP} RUNTIME DESTINATION ".")
+	endif()
 endif()
 #if((MSVC OR APPLE) AND EXISTS "${CMAKE_SOURCE_DIR}/LICENSE")
 #	install(FILES LICENSE DESTINATION . RENAME LICENSE.txt)
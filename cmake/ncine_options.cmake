@@ -60,6 +60,8 @@ else()
 endif()
 
 option(NCINE_WITH_WEBP "Enable WebP image file support" OFF)
+option(NCINE_WITH_LZ4 "Enable LZ4 compression support in .pak files" ON)
+option(NCINE_WITH_ZSTD "Enable Zstandard compression support in .pak files" ON)
 option(NCINE_WITH_AUDIO "Enable OpenAL support and thus sound" ON)
 cmake_dependent_option(NCINE_WITH_VORBIS "Enable Ogg Vorbis audio file support" ON "NCINE_WITH_AUDIO" OFF)
 cmake_dependent_option(NCINE_WITH_OPENMPT "Enable module (libopenmpt) audio file support" ON "NCINE_WITH_AUDIO" OFF)
@@ -158,3 +160,7 @@ option(DISABLE_RESCALE_SHADERS "Disable all rescaling options" OFF)
 
 # Multiplayer is not supported on Emscripten yet and requires multithreading
 cmake_dependent_option(WITH_MULTIPLAYER "Enable multiplayer support" OFF "NCINE_WITH_THREADS;NOT EMSCRIPTEN" OFF)
+# Dedicated server runs only the simulation, so it's built as a separate target without rendering, audio and input backends
+cmake_dependent_option(DEDICATED_SERVER "Build also headless dedicated server" OFF "WITH_MULTIPLAYER;NOT EMSCRIPTEN;NOT ANDROID" OFF)
+# Render benchmark replays a level with scripted camera path using null graphics device, so it's built as a separate target without window, audio and input backends
+cmake_dependent_option(NCINE_BUILD_BENCHMARK "Build also headless render benchmark" OFF "NOT EMSCRIPTEN;NOT ANDROID" OFF)
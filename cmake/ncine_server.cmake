@@ -0,0 +1,43 @@
+# Dedicated server is built from the same sources as the game, but without window, input and audio backends and without ImGui.
+# Renderer classes are still compiled, because actors and UI own render commands, but no OpenGL library is linked.
+set(NCINE_SERVER_APP "${NCINE_APP}_server")
+message(STATUS "Building also dedicated server: ${NCINE_SERVER_APP}")
+
+add_executable(${NCINE_SERVER_APP})
+
+set(SERVER_SOURCES ${SOURCES} ${GENERATED_SOURCES})
+list(FILTER SERVER_SOURCES EXCLUDE REGEX "/nCine/(Audio|Backends)/")
+list(FILTER SERVER_SOURCES EXCLUDE REGEX "/nCine/Graphics/ImGui|/nCine/Input/ImGui")
+if(IMGUI_SOURCE_DIR)
+	list(FILTER SERVER_SOURCES EXCLUDE REGEX "^${IMGUI_SOURCE_DIR}/")
+endif()
+if(NOT ${NCINE_SOURCE_DIR}/nCine/Input/JoyMapping.cpp IN_LIST SERVER_SOURCES)
+	list(APPEND SERVER_SOURCES ${NCINE_SOURCE_DIR}/nCine/Input/JoyMapping.cpp)
+endif()
+list(APPEND SERVER_SOURCES ${NCINE_SOURCE_DIR}/nCine/Backends/NullGLFunctions.cpp)
+
+set(SERVER_HEADERS ${HEADERS})
+list(FILTER SERVER_HEADERS EXCLUDE REGEX "/nCine/(Audio|Backends)/|/nCine/Graphics/ImGui|/nCine/Input/ImGui")
+if(IMGUI_SOURCE_DIR)
+	list(FILTER SERVER_HEADERS EXCLUDE REGEX "^${IMGUI_SOURCE_DIR}/|^${IMGUI_INCLUDE_ONLY_DIR}/")
+endif()
+
+target_sources(${NCINE_SERVER_APP} PRIVATE ${SERVER_SOURCES} ${SERVER_HEADERS})
+
+# Compiler options, include directories and common definitions are shared with the game
+foreach(PROPERTY_NAME COMPILE_OPTIONS COMPILE_FEATURES INCLUDE_DIRECTORIES LINK_OPTIONS CXX_STANDARD CXX_STANDARD_REQUIRED CXX_EXTENSIONS
+		INTERPROCEDURAL_OPTIMIZATION MSVC_RUNTIME_LIBRARY)
+	get_target_property(PROPERTY_VALUE ${NCINE_APP} ${PROPERTY_NAME})
+	if(NOT PROPERTY_VALUE STREQUAL "PROPERTY_VALUE-NOTFOUND")
+		set_target_properties(${NCINE_SERVER_APP} PROPERTIES ${PROPERTY_NAME} "${PROPERTY_VALUE}")
+	endif()
+endforeach()
+
+get_target_property(SERVER_DEFINITIONS ${NCINE_APP} COMPILE_DEFINITIONS)
+list(FILTER SERVER_DEFINITIONS EXCLUDE REGEX "^WITH_(AUDIO|VORBIS|VORBIS_DYNAMIC|OPENMPT|OPENMPT_DYNAMIC|GLFW|SDL|QT5|QT5GAMEPAD|IMGUI|GLEW|OPENGLES|ANGLE|TRACY_OPENGL)$")
+target_compile_definitions(${NCINE_SERVER_APP} PRIVATE ${SERVER_DEFINITIONS} "DEDICATED_SERVER")
+
+get_target_property(SERVER_LIBRARIES ${NCINE_APP} LINK_LIBRARIES)
+list(FILTER SERVER_LIBRARIES EXCLUDE REGEX "^(OpenGL|GLEW|EGL|OpenGLES2|GLFW|SDL2|Qt5|OpenAL|Vorbis|libopenmpt)::")
+list(FILTER SERVER_LIBRARIES EXCLUDE REGEX "^(imm32|dwmapi|idbfs\\.js)$")
+target_link_libraries(${NCINE_SERVER_APP} PRIVATE ${SERVER_LIBRARIES})
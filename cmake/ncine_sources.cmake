@@ -8,6 +8,7 @@ set(SOURCES
 	${NCINE_SOURCE_DIR}/Shared/Containers/StringUtils.cpp
 	${NCINE_SOURCE_DIR}/Shared/Containers/StringView.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/AndroidAssetStream.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/BufferedStream.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/DeflateStream.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/FileStream.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/FileSystem.cpp
@@ -216,9 +217,11 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/Thunderbolt.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/ToasterShot.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/TNT.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/CollisionMask.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/CacheManifest.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Block.cpp
@@ -240,6 +243,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptLoader.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Tiles/DebrisKernels.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileSet.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Canvas.cpp